@@ -0,0 +1,221 @@
+//=========================================================================================================|
+// ApiBench.c
+//	Checks and times the C interface (XnestApi.h) the way a harness would use it. It is written in C on
+//	purpose, so the header is compiled as C and nothing but the interface is reachable.
+//
+//	It makes k environments on the rom and checks three things:
+//	- Xnest_Get_Ram gives the same pointer before and after stepping.
+//	- Save, run, load and run again ends on the same ram as the first run.
+//	- Xnest_Step_Batch leaves every environment where Xnest_Step on each would.
+//	Then it times k environments stepped a frame at a time, once one call each and once a batch call,
+//	and times bare calls (no frames) to show what a call itself costs.
+//
+//	The ram hash it prints after --frames frames with no input is the one Headless prints for the same
+//	run, as a check that the interface runs the same machine.
+//
+//	Usage:
+//		ApiBench rom.nes [--envs k] [--frames n]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU gcc 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "XnestApi.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FNV_OFFSET			0xCBF29CE484222325ull
+#define FNV_PRIME			0x100000001B3ull
+
+#define MAX_ENVS			256
+#define BARE_CALLS			1000000
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * FNV-1a over the environment's ram.
+ */
+static uint64_t Hash(const XNEST_ENV* env)
+{
+	uint32_t size;
+	const uint8_t* ram = Xnest_Get_Ram(env, &size);
+	uint64_t h = FNV_OFFSET;
+	for (uint32_t i = 0; i < size; i++)
+		h = (h ^ ram[i]) * FNV_PRIME;
+	return h;
+} // end Hash
+
+
+//=========================================================================================================|
+/**
+ * Processor seconds since some fixed point; all this runs on one thread.
+ */
+static double Seconds(void)
+{
+	return (double)clock() / CLOCKS_PER_SEC;
+} // end Seconds
+
+
+//=========================================================================================================|
+/**
+ * Prints how a check went and passes bok back.
+ */
+static int Check(int bok, const char* what)
+{
+	printf("%-44s %s\n", what, bok ? "ok" : "FAILED");
+	return bok;
+} // end Check
+
+
+//=========================================================================================================|
+int main(int argc, char** argv)
+{
+	const char* rom = NULL;
+	uint32_t count = 16;
+	uint32_t frames = 600;
+	int busage = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--envs") && i + 1 < argc)
+			count = (uint32_t)strtoul(argv[++i], NULL, 0);
+		else if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+			frames = (uint32_t)strtoul(argv[++i], NULL, 0);
+		else if (argv[i][0] != '-' && !rom)
+			rom = argv[i];
+		else
+			busage = 1;
+	} // end for
+
+	if (busage || !rom || !count || count > MAX_ENVS || !frames)
+	{
+		fprintf(stderr, "usage: %s rom.nes [--envs 1-%d] [--frames n]\n", argv[0], MAX_ENVS);
+		return 1;
+	} // end if
+
+	if (Xnest_Version() != XNEST_API_VERSION)
+	{
+		fprintf(stderr, "library is version %d, built against %d\n", Xnest_Version(), XNEST_API_VERSION);
+		return 1;
+	} // end if
+
+	XNEST_ENV* envs[MAX_ENVS];
+	for (uint32_t i = 0; i < count; i++)
+	{
+		envs[i] = Xnest_Create(rom);
+		if (!envs[i])
+		{
+			fprintf(stderr, "%s: %s\n", rom, Xnest_Error());
+			return 1;
+		} // end if
+	} // end for
+
+	int bok = 1;
+
+	// the ram view stays put
+	const uint8_t* view = Xnest_Get_Ram(envs[0], NULL);
+	Xnest_Step(envs[0], frames, NULL, 0);
+	uint64_t ram_hash = Hash(envs[0]);
+	bok &= Check(Xnest_Get_Ram(envs[0], NULL) == view, "ram view stable across steps");
+	printf("ram hash after %u frames: %016llx\n", frames, (unsigned long long)ram_hash);
+
+	// save, run, load, run
+	uint32_t state_size = Xnest_State_Size();
+	void* state = malloc(state_size);
+	uint8_t* input = malloc((size_t)count * frames * XNEST_PADS);
+	if (!state || !input)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	} // end if
+
+	for (size_t i = 0; i < (size_t)count * frames * XNEST_PADS; i++)
+		input[i] = (uint8_t)(rand() & 0xFF);
+
+	Xnest_Reset(envs[0]);
+	Xnest_Step(envs[0], frames / 2, NULL, 0);
+	bok &= Check(Xnest_Save(envs[0], state, state_size) == XNEST_OK, "save");
+	Xnest_Step(envs[0], frames, input, 0);
+	uint64_t first = Hash(envs[0]);
+	bok &= Check(Xnest_Load(envs[0], state, state_size) == XNEST_OK, "load");
+	Xnest_Step(envs[0], frames, input, 0);
+	bok &= Check(Hash(envs[0]) == first, "save, run, load, run ends the same");
+	bok &= Check(Xnest_Load(envs[0], state, state_size - 1) == XNEST_ERROR, "short state refused");
+
+	// the batch against each on its own
+	uint64_t single[MAX_ENVS];
+	for (uint32_t i = 0; i < count; i++)
+	{
+		Xnest_Reset(envs[i]);
+		Xnest_Step(envs[i], frames, input + (size_t)i * frames * XNEST_PADS, 0);
+		single[i] = Hash(envs[i]);
+		Xnest_Reset(envs[i]);
+	} // end for
+
+	Xnest_Step_Batch(envs, count, frames, input, 0);
+	int bsame = 1;
+	for (uint32_t i = 0; i < count; i++)
+		bsame &= Hash(envs[i]) == single[i];
+	bok &= Check(bsame, "batch matches one call per environment");
+
+	// timing: k environments a frame at a time
+	for (uint32_t i = 0; i < count; i++)
+		Xnest_Reset(envs[i]);
+	double start = Seconds();
+	for (uint32_t f = 0; f < frames; f++)
+		for (uint32_t i = 0; i < count; i++)
+			Xnest_Step(envs[i], 1, NULL, 0);
+	double each = Seconds() - start;
+
+	for (uint32_t i = 0; i < count; i++)
+		Xnest_Reset(envs[i]);
+	start = Seconds();
+	for (uint32_t f = 0; f < frames; f++)
+		Xnest_Step_Batch(envs, count, 1, NULL, 0);
+	double batched = Seconds() - start;
+
+	start = Seconds();
+	for (uint32_t c = 0; c < BARE_CALLS; c++)
+		Xnest_Step(envs[c % count], 0, NULL, 0);
+	double bare = Seconds() - start;
+
+	double total = (double)count * frames;
+	printf("%u envs x %u frames, a frame per call:\n", count, frames);
+	printf("  Xnest_Step per env   %10.0f frames/s\n", total / each);
+	printf("  Xnest_Step_Batch     %10.0f frames/s\n", total / batched);
+	printf("  bare call            %10.1f ns\n", bare * 1e9 / BARE_CALLS);
+
+	for (uint32_t i = 0; i < count; i++)
+		Xnest_Destroy(envs[i]);
+	free(state);
+	free(input);
+	return bok ? 0 : 1;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
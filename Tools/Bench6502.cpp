@@ -0,0 +1,444 @@
+//=========================================================================================================|
+// Bench6502.cpp
+//	Microbenchmarks for the 6502 core, so interpreter changes can be judged by numbers rather than feel.
+//
+//	Every one of the 256 lookup entries gets timed on its own: a block of the same instruction repeated,
+//	closed off with a JMP back to the top, run on the plain 64K bus. Operands are picked so that each
+//	instruction lands somewhere harmless and control flow lands back on itself: branches jump -2 (onto
+//	themselves when taken), JMP/JSR/BRK target the block, and RTS/RTI get a stack page that returns them to
+//	where they stand. The JMP closing each block is one instruction in BENCH_BLOCK, i.e. noise.
+//
+//	After that come a few hand assembled instruction mixes (loops, copies, calls, a game-ish blend), and if
+//	given the binary, Klaus Dormann's 6502 functional test run end to end. That one traps (jumps to itself)
+//	on success and on failure alike; the trap address says which.
+//
+//	All results are printed as ns per instruction, emulated MHz and cycles per instruction; --json writes the
+//	same thing out for comparing runs.
+//
+//	Usage:
+//		Bench6502 [--steps n] [--runs n] [--no-opcodes] [--dormann file.bin [--success addr]]
+//		          [--json out.json] [--label text]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define BENCH_CODE			0x0400		// where every timed block starts
+#define BENCH_DATA			0x0300		// absolute operands point here
+#define BENCH_BLOCK			200			// copies of the instruction per block
+
+#define DORMANN_START		0x0400
+#define DORMANN_SUCCESS		0x3469		// the trap the stock build ends on when everything passed
+#define DORMANN_MAX_STEPS	500000000ull
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+struct RESULT
+{
+	std::string name;
+	u64 steps;			// instructions run
+	u64 ticks;			// cpu cycles they took
+	double secs;		// wall time
+
+	double Ns() const { return secs * 1e9 / steps; }
+	double Mhz() const { return ticks / secs / 1e6; }
+	double Cpi() const { return (double)ticks / steps; }
+};
+
+
+struct MIX
+{
+	const char* name;
+	std::vector<u8> code;		// assembled at BENCH_CODE
+};
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+// small programs at $0400; each loops forever
+static const MIX MIXES[] =
+{
+	// LDX #0 / loop: LDA $0300,X / CLC / ADC #1 / STA $0300,X / INX / BNE loop / JMP $0400
+	{ "inc_array", { 0xA2, 0x00, 0xBD, 0x00, 0x03, 0x18, 0x69, 0x01, 0x9D, 0x00, 0x03,
+		0xE8, 0xD0, 0xF4, 0x4C, 0x00, 0x04 } },
+
+	// LDY #0 / loop: LDA ($10),Y / STA ($12),Y / INY / BNE loop / JMP $0400
+	{ "memcpy", { 0xA0, 0x00, 0xB1, 0x10, 0x91, 0x12, 0xC8, 0xD0, 0xF9, 0x4C, 0x00, 0x04 } },
+
+	// JSR sub / JMP $0400 / sub: LDA #1 / PHA / PLA / RTS
+	{ "calls", { 0x20, 0x06, 0x04, 0x4C, 0x00, 0x04, 0xA9, 0x01, 0x48, 0x68, 0x60 } },
+
+	// a game-ish blend: poll a flag, some arithmetic, table lookups, compares and a short loop
+	// LDA $20 / AND #$0F / TAX / LDA $0300,X / CLC / ADC $21 / STA $21 / LDA $22 / CMP #$80 / BCC +2 /
+	// LDA #0 / STA $22 / INC $22 / LDY #4 / loop: LDA ($10),Y / EOR #$FF / STA $0380,Y / DEY / BPL loop /
+	// ASL $23 / ROL $24 / BIT $25 / JMP $0400
+	{ "game_mix", { 0xA5, 0x20, 0x29, 0x0F, 0xAA, 0xBD, 0x00, 0x03, 0x18, 0x65, 0x21, 0x85, 0x21,
+		0xA5, 0x22, 0xC9, 0x80, 0x90, 0x02, 0xA9, 0x00, 0x85, 0x22, 0xE6, 0x22, 0xA0, 0x04,
+		0xB1, 0x10, 0x49, 0xFF, 0x99, 0x80, 0x03, 0x88, 0x10, 0xF6, 0x06, 0x23, 0x26, 0x24,
+		0x24, 0x25, 0x4C, 0x00, 0x04 } }
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Puts the cpu at pc with known registers, between instructions.
+ */
+static void Start_At(Bus& bus, u16 pc)
+{
+	CPU_STATE s = {};
+	s.sp = 0xFD;
+	s.status = U | I;
+	s.pc = pc;
+	bus.cpu6502.Load_State(s);
+} // end Start_At
+
+
+//=========================================================================================================|
+/**
+ * Steps the cpu steps times, runs times over, keeps the fastest run. Everything is reset in between so
+ *	each run sees the same memory and registers.
+ */
+static RESULT Time_Code(Bus& bus, const std::vector<u8>& image, u16 pc, u64 steps, int runs,
+	const std::string& name)
+{
+	RESULT best = { name, steps, 0, 1e30 };
+	for (int r = 0; r < runs; r++)
+	{
+		memcpy(bus.ram, image.data(), RAM_SIZE);
+		Start_At(bus, pc);
+
+		u64 ticks = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (u64 i = 0; i < steps; i++)
+			ticks += bus.cpu6502.Step();
+		double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		if (secs < best.secs)
+		{
+			best.secs = secs;
+			best.ticks = ticks;
+		} // end if
+	} // end for
+
+	return best;
+} // end Time_Code
+
+
+//=========================================================================================================|
+/**
+ * The memory every benchmark starts from: zero page pointers all $0303, a stack page of $02's (RTS comes
+ *	back to $0203, RTI to $0202), a data page with a JMP ($0300) pointer to the code, vectors to the code.
+ */
+static std::vector<u8> Base_Image()
+{
+	std::vector<u8> image(RAM_SIZE, 0);
+	memset(&image[0x0000], 0x03, 0x100);
+	memset(&image[0x0100], 0x02, 0x100);
+	for (int i = 0; i < 0x100; i++)
+		image[BENCH_DATA + i] = (u8)i;
+
+	image[BENCH_DATA + 0] = BENCH_CODE & 0xFF;
+	image[BENCH_DATA + 1] = BENCH_CODE >> 8;
+	image[0x10] = 0x00; image[0x11] = 0x03;		// memcpy source / mix table
+	image[0x12] = 0x00; image[0x13] = 0x05;		// memcpy destination
+
+	for (u16 v = 0xFFFA; v != 0; v += 2)
+	{
+		image[v] = BENCH_CODE & 0xFF;
+		image[v + 1] = BENCH_CODE >> 8;
+	} // end for
+
+	return image;
+} // end Base_Image
+
+
+//=========================================================================================================|
+/**
+ * Builds the block for one opcode and says where to start running it.
+ */
+static u16 Build_Opcode(std::vector<u8>& image, u8 op, const OPCODE_INFO& info)
+{
+	// the ones that come back to themselves need no block
+	switch (op)
+	{
+	case 0x4C:	// JMP $0400
+	case 0x20:	// JSR $0400
+		image[BENCH_CODE] = op;
+		image[BENCH_CODE + 1] = BENCH_CODE & 0xFF;
+		image[BENCH_CODE + 2] = BENCH_CODE >> 8;
+		return BENCH_CODE;
+
+	case 0x6C:	// JMP ($0300)
+		image[BENCH_CODE] = op;
+		image[BENCH_CODE + 1] = BENCH_DATA & 0xFF;
+		image[BENCH_CODE + 2] = BENCH_DATA >> 8;
+		return BENCH_CODE;
+
+	case 0x00:	// BRK; vectored back to $0400
+		image[BENCH_CODE] = op;
+		return BENCH_CODE;
+
+	case 0x40:	// RTI; pops $0202 every time
+		image[0x0202] = op;
+		return 0x0202;
+
+	case 0x60:	// RTS; pops $0202 and adds one
+		image[0x0203] = op;
+		return 0x0203;
+	} // end switch
+
+	u8 operand = 0x03;
+	if (info.mode == AM_REL)
+		operand = 0xFE;		// onto itself when taken, on to the next when not
+	else if (info.mode == AM_ABS || info.mode == AM_ABX || info.mode == AM_ABY || info.mode == AM_IND)
+		operand = BENCH_DATA & 0xFF;
+
+	u16 addr = BENCH_CODE;
+	for (int i = 0; i < BENCH_BLOCK; i++)
+	{
+		image[addr++] = op;
+		if (info.bytes > 1) image[addr++] = operand;
+		if (info.bytes > 2) image[addr++] = BENCH_DATA >> 8;
+	} // end for
+
+	image[addr++] = 0x4C;
+	image[addr++] = BENCH_CODE & 0xFF;
+	image[addr++] = BENCH_CODE >> 8;
+	return BENCH_CODE;
+} // end Build_Opcode
+
+
+//=========================================================================================================|
+/**
+ * Runs Klaus Dormann's functional test till it traps. Returns false when the binary can't be had.
+ */
+static bool Run_Dormann(Bus& bus, const char* path, RESULT& result, u16& trap)
+{
+	FILE* fp = fopen(path, "rb");
+	if (!fp)
+		return false;
+
+	memset(bus.ram, 0, RAM_SIZE);
+	size_t n = fread(bus.ram, 1, RAM_SIZE, fp);
+	fclose(fp);
+	if (n != RAM_SIZE)
+	{
+		fprintf(stderr, "%s: expected a 64K image, got %zu bytes\n", path, n);
+		return false;
+	} // end if
+
+	Start_At(bus, DORMANN_START);
+
+	CPU_STATE s;
+	u16 last_pc = DORMANN_START;
+	u64 steps = 0, ticks = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	while (steps < DORMANN_MAX_STEPS)
+	{
+		ticks += bus.cpu6502.Step();
+		++steps;
+
+		bus.cpu6502.Save_State(s);
+		if (s.pc == last_pc)
+			break;		// trapped
+		last_pc = s.pc;
+	} // end while
+	double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	result = { "dormann", steps, ticks, secs };
+	trap = last_pc;
+	return true;
+} // end Run_Dormann
+
+
+//=========================================================================================================|
+/**
+ * One result as a JSON object; names are plain mnemonics so nothing needs escaping.
+ */
+static void Json_Result(FILE* fp, const RESULT& r, const char* extra)
+{
+	fprintf(fp, "{ \"name\": \"%s\", %s\"instructions\": %llu, \"cycles\": %llu, \"seconds\": %.6f, "
+		"\"ns_per_instr\": %.3f, \"emulated_mhz\": %.3f, \"cycles_per_instr\": %.3f }",
+		r.name.c_str(), extra, (unsigned long long)r.steps, (unsigned long long)r.ticks, r.secs,
+		r.Ns(), r.Mhz(), r.Cpi());
+} // end Json_Result
+
+
+//=========================================================================================================|
+// program entry point
+int main(int argc, char** argv)
+{
+	u64 steps = 200000;
+	int runs = 3;
+	bool bopcodes = true;
+	const char* dormann = nullptr;
+	const char* json = nullptr;
+	std::string label = "xnest";
+	u16 success = DORMANN_SUCCESS;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--steps") && i + 1 < argc)
+			steps = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--runs") && i + 1 < argc)
+			runs = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--no-opcodes"))
+			bopcodes = false;
+		else if (!strcmp(argv[i], "--dormann") && i + 1 < argc)
+			dormann = argv[++i];
+		else if (!strcmp(argv[i], "--success") && i + 1 < argc)
+			success = (u16)strtoul(argv[++i], nullptr, 16);
+		else if (!strcmp(argv[i], "--json") && i + 1 < argc)
+			json = argv[++i];
+		else if (!strcmp(argv[i], "--label") && i + 1 < argc)
+			label = argv[++i];
+		else
+		{
+			fprintf(stderr, "usage: %s [--steps n] [--runs n] [--no-opcodes] [--dormann file.bin "
+				"[--success hexaddr]] [--json out.json] [--label text]\n", argv[0]);
+			return 2;
+		} // end else
+	} // end for
+
+	if (steps == 0 || runs < 1)
+	{
+		fprintf(stderr, "--steps and --runs need to be at least 1\n");
+		return 2;
+	} // end if
+
+	// the bus is big; keep it off the stack
+	std::unique_ptr<Bus> bus(new Bus);
+	const std::vector<u8> base = Base_Image();
+
+	std::vector<RESULT> opcodes;
+	std::vector<u8> modes;
+	if (bopcodes)
+	{
+		printf("%-4s %-4s %-3s %10s %10s %8s\n", "op", "name", "am", "ns/instr", "MHz", "cyc/ins");
+		for (int op = 0; op < 256; op++)
+		{
+			OPCODE_INFO info;
+			bus->cpu6502.Get_Opcode_Info((u8)op, info);
+
+			std::vector<u8> image = base;
+			u16 pc = Build_Opcode(image, (u8)op, info);
+
+			RESULT r = Time_Code(*bus, image, pc, steps, runs, info.name);
+			opcodes.push_back(r);
+			modes.push_back(info.mode);
+			printf("$%02X  %-4s %-3s %10.2f %10.2f %8.2f\n", op, info.name, CPU6502::Mode_Name(info.mode),
+				r.Ns(), r.Mhz(), r.Cpi());
+		} // end for
+		printf("\n");
+	} // end if
+
+	std::vector<RESULT> mixes;
+	printf("%-10s %10s %10s %8s\n", "mix", "ns/instr", "MHz", "cyc/ins");
+	for (const MIX& m : MIXES)
+	{
+		std::vector<u8> image = base;
+		memcpy(&image[BENCH_CODE], m.code.data(), m.code.size());
+
+		RESULT r = Time_Code(*bus, image, BENCH_CODE, steps * 4, runs, m.name);
+		mixes.push_back(r);
+		printf("%-10s %10.2f %10.2f %8.2f\n", m.name, r.Ns(), r.Mhz(), r.Cpi());
+	} // end for
+
+	RESULT dr = {};
+	u16 trap = 0;
+	bool bdormann = false;
+	if (dormann)
+	{
+		bdormann = Run_Dormann(*bus, dormann, dr, trap);
+		if (bdormann)
+			printf("\ndormann: trapped at $%04X (%s) after %llu instructions, %llu cycles in %.3f s; "
+				"%.2f ns/instr, %.2f MHz\n", trap, trap == success ? "passed" : "FAILED",
+				(unsigned long long)dr.steps, (unsigned long long)dr.ticks, dr.secs, dr.Ns(), dr.Mhz());
+		else
+			fprintf(stderr, "dormann: can't load %s\n", dormann);
+	} // end if
+
+	if (json)
+	{
+		FILE* fp = fopen(json, "w");
+		if (!fp)
+		{
+			fprintf(stderr, "can't write %s\n", json);
+			return 1;
+		} // end if
+
+		fprintf(fp, "{\n  \"label\": \"%s\",\n  \"steps\": %llu,\n  \"runs\": %d,\n  \"opcodes\": [\n",
+			label.c_str(), (unsigned long long)steps, runs);
+		for (size_t i = 0; i < opcodes.size(); i++)
+		{
+			char extra[64];
+			snprintf(extra, sizeof(extra), "\"opcode\": %zu, \"mode\": \"%s\", ", i, CPU6502::Mode_Name(modes[i]));
+			fprintf(fp, "    ");
+			Json_Result(fp, opcodes[i], extra);
+			fprintf(fp, i + 1 < opcodes.size() ? ",\n" : "\n");
+		} // end for
+
+		fprintf(fp, "  ],\n  \"mixes\": [\n");
+		for (size_t i = 0; i < mixes.size(); i++)
+		{
+			fprintf(fp, "    ");
+			Json_Result(fp, mixes[i], "");
+			fprintf(fp, i + 1 < mixes.size() ? ",\n" : "\n");
+		} // end for
+		fprintf(fp, "  ]");
+
+		if (bdormann)
+		{
+			char extra[96];
+			snprintf(extra, sizeof(extra), "\"trap\": %u, \"success\": %u, \"passed\": %s, ",
+				trap, success, trap == success ? "true" : "false");
+			fprintf(fp, ",\n  \"dormann\": ");
+			Json_Result(fp, dr, extra);
+		} // end if
+		fprintf(fp, "\n}\n");
+		fclose(fp);
+	} // end if
+
+	return bdormann && trap != success ? 1 : 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
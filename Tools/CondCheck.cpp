@@ -0,0 +1,126 @@
+//=========================================================================================================|
+// CondCheck.cpp
+//	Checks the breakpoint condition parser (Condition.h) against a table of expressions and what they
+//	should come to, and a few that shouldn't compile at all. The machine they run against has known
+//	registers and memory, so every answer is fixed.
+//
+//	The table leans on the places the tokenizer can go wrong: operators that are the first half of
+//	longer ones ("&" and "&&", "<" and "<<" and "<="), and operators followed by a unary one ("A--1" is
+//	A minus -1). Prints each failure and exits with 1 if there was any.
+//
+//	Usage:
+//		CondCheck
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdio>
+#include <memory>
+
+#include "Bus.h"
+#include "Condition.h"
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+struct COND_CASE
+{
+	const char* expr;
+	bool bcompiles;
+	s64 value;				// when it does
+};
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+// against A = 5, X = 3, Y = $80, [$10] = 7
+static const COND_CASE CASES[] =
+{
+	{ "A--1", true, 6 },
+	{ "X--1", true, 4 },
+	{ "A - -1", true, 6 },
+	{ "A---1", true, 4 },
+	{ "A+-1", true, 4 },
+	{ "A*-2", true, -10 },
+	{ "[$10]--[$10]", true, 14 },
+	{ "~0 & $FF", true, 255 },
+	{ "3&1", true, 1 },
+	{ "3&&0", true, 0 },
+	{ "1|2", true, 3 },
+	{ "0||2", true, 1 },
+	{ "1<<3", true, 8 },
+	{ "Y>>7", true, 1 },
+	{ "1<2", true, 1 },
+	{ "2<=2", true, 1 },
+	{ "2>=3", true, 0 },
+	{ "A==5 && X!=5", true, 1 },
+	{ "!0", true, 1 },
+	{ "10 % 3", true, 1 },
+	{ "1 = 2", false, 0 },
+	{ "A &", false, 0 },
+	{ "(1", false, 0 },
+	{ "A -", false, 0 }
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+// program entry point
+int main()
+{
+	std::unique_ptr<Bus> bus(new Bus);
+	CPU_STATE s;
+	bus->cpu6502.Save_State(s);
+	s.a = 5;
+	s.x = 3;
+	s.y = 0x80;
+	bus->cpu6502.Load_State(s);
+	bus->ram[0x10] = 7;
+
+	int failures = 0;
+	for (const COND_CASE& c : CASES)
+	{
+		Condition cond;
+		bool bcompiled = cond.Compile(c.expr);
+		if (bcompiled != c.bcompiles)
+		{
+			printf("\"%s\": %s\n", c.expr, bcompiled ? "compiled, shouldn't have" : cond.Error().c_str());
+			failures++;
+			continue;
+		} // end if
+
+		s64 value = bcompiled ? cond.Evaluate(*bus, 0) : 0;
+		if (bcompiled && value != c.value)
+		{
+			printf("\"%s\": %lld, should be %lld\n", c.expr, (long long)value, (long long)c.value);
+			failures++;
+		} // end if
+	} // end for
+
+	printf("%zu expressions, %d failed\n", sizeof(CASES) / sizeof(CASES[0]), failures);
+	return failures ? 1 : 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,144 @@
+//=========================================================================================================|
+// Disasm.cpp
+//	Lists a game's code the way the debugger sees it: the cartridge is put on a bus and reset, then the
+//	given range of the cpu's address space (all of the rom by default) is disassembled linearly, one line
+//	per instruction:
+//
+//		C000  78        SEI
+//		C001  D8        CLD
+//		C002  A2 FF     LDX #$FF
+//
+//	Linear means data gets decoded as if it were code; there's no flow analysis. --bench skips the listing
+//	and times Disassemble_Range over all 64K instead, best of a few runs.
+//
+//	Usage:
+//		Disasm rom.nes [--raw hexaddr] [--from hexaddr] [--to hexaddr] [--bench]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "Bus.h"
+#include "Cartridge.h"
+#include "Disassembler.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define DISASM_BENCH_RUNS	20
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+// program entry point
+int main(int argc, char** argv)
+{
+	const char* rom = nullptr;
+	long raw_addr = -1;
+	long from = -1, to = 0xFFFF;
+	bool bbench = false;
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--raw") && i + 1 < argc)
+			raw_addr = strtol(argv[++i], nullptr, 16);
+		else if (!strcmp(argv[i], "--from") && i + 1 < argc)
+			from = strtol(argv[++i], nullptr, 16);
+		else if (!strcmp(argv[i], "--to") && i + 1 < argc)
+			to = strtol(argv[++i], nullptr, 16);
+		else if (!strcmp(argv[i], "--bench"))
+			bbench = true;
+		else if (argv[i][0] != '-' && !rom)
+			rom = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	if (!rom || busage)
+	{
+		fprintf(stderr, "usage: %s rom.nes [--raw hexaddr] [--from hexaddr] [--to hexaddr] [--bench]\n", argv[0]);
+		return 2;
+	} // end if
+
+	Cartridge cart;
+	bool bloaded = raw_addr >= 0 ? cart.Load_Raw(rom, (u16)raw_addr) : cart.Load(rom);
+	if (!bloaded)
+	{
+		fprintf(stderr, "%s\n", cart.Error().c_str());
+		return 1;
+	} // end if
+
+	// the bus is big; keep it off the stack
+	std::unique_ptr<Bus> bus(new Bus);
+	cart.Insert(*bus);
+	bus->Reset();
+
+	Disassembler dis(*bus);
+	std::vector<DISASM_LINE> lines(0x10000);
+
+	if (bbench)
+	{
+		double best = 1e9;
+		size_t n = 0;
+		for (int run = 0; run < DISASM_BENCH_RUNS; run++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			n = dis.Disassemble_Range(0x0000, 0xFFFF, lines.data(), lines.size());
+			double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (secs < best)
+				best = secs;
+		} // end for
+
+		printf("64K: %zu instructions in %.3f ms (%.1f ns each), best of %d\n", n, best * 1e3, best * 1e9 / n,
+			DISASM_BENCH_RUNS);
+		return 0;
+	} // end if
+
+	if (from < 0)
+		from = bus->rom_start;
+	if (from > to || to > 0xFFFF)
+	{
+		fprintf(stderr, "bad range $%04lX-$%04lX\n", from, to);
+		return 2;
+	} // end if
+
+	size_t n = dis.Disassemble_Range((u16)from, (u16)to, lines.data(), lines.size());
+	for (size_t i = 0; i < n; i++)
+	{
+		char bytes[16], ins[DISASM_TEXT];
+		Disassembler::Format_Bytes(lines[i], bytes);
+		Disassembler::Format(lines[i], ins);
+		printf("%04X  %-8s  %s\n", lines[i].addr, bytes, ins);
+	} // end for
+
+	return 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
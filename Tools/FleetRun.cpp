@@ -0,0 +1,252 @@
+//=========================================================================================================|
+// FleetRun.cpp
+//	Runs a list of replay jobs across every core (Fleet.h) and prints each one's hashes, so a whole
+//	regression suite is one command and one diff. The job file has one job per line: a rom, an input
+//	script (or - for none) and a frame count. Blank lines and lines starting with # are skipped. Each
+//	rom and script is loaded once, however many jobs use it.
+//
+//	The result lines are "rom script frames ram_hash audio_hash" in job order, whichever worker ran what,
+//	so they diff cleanly between commits. The summary after them goes to stderr: jobs and frames per
+//	second, and how many jobs were stolen.
+//
+//	--repeat k runs the list k times over in one batch; for timing. --scale runs the batch on 1, 2, 4 ...
+//	workers up to --threads (default one per hardware thread) and prints the speedup at each.
+//
+//	Usage:
+//		FleetRun jobs.txt [--threads n] [--repeat k] [--scale] [--quiet]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Fleet.h"
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// a job as the file gave it
+struct JOB_LINE
+{
+	std::string rom;
+	std::string script;
+	u64 frames;
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Reads the job file into lines; false with a message on stderr when it can't.
+ */
+static bool Load_Jobs(const char* path, std::vector<JOB_LINE>& lines)
+{
+	FILE* fp = fopen(path, "r");
+	if (!fp)
+	{
+		fprintf(stderr, "can't open %s\n", path);
+		return false;
+	} // end if
+
+	char buf[1024];
+	int line = 0;
+	while (fgets(buf, sizeof(buf), fp))
+	{
+		line++;
+		char rom[512], script[512];
+		unsigned long long frames;
+		char* p = buf + strspn(buf, " \t");
+		if (*p == '#' || *p == '\n' || *p == '\r' || !*p)
+			continue;
+
+		if (sscanf(p, "%511s %511s %llu", rom, script, &frames) != 3)
+		{
+			fprintf(stderr, "%s: line %d: expected <rom> <script|-> <frames>\n", path, line);
+			fclose(fp);
+			return false;
+		} // end if
+
+		lines.push_back({ rom, script, frames });
+	} // end while
+
+	fclose(fp);
+	return true;
+} // end Load_Jobs
+
+
+//=========================================================================================================|
+/**
+ * The batch on a fleet of workers; seconds it took.
+ */
+static double Run_Batch(u32 workers, const std::vector<FLEET_JOB>& jobs, std::vector<FLEET_RESULT>& results,
+	u64& steals)
+{
+	Fleet fleet(workers);
+	auto start = std::chrono::steady_clock::now();
+	fleet.Run(jobs.data(), results.data(), (u32)jobs.size());
+	steals = fleet.Steals();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+} // end Run_Batch
+
+
+//=========================================================================================================|
+int main(int argc, char** argv)
+{
+	const char* job_file = nullptr;
+	u32 threads = 0;
+	u32 repeat = 1;
+	bool bscale = false;
+	bool bquiet = false;
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+			threads = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--repeat") && i + 1 < argc)
+			repeat = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--scale"))
+			bscale = true;
+		else if (!strcmp(argv[i], "--quiet"))
+			bquiet = true;
+		else if (argv[i][0] != '-' && !job_file)
+			job_file = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	if (!job_file || busage || !repeat)
+	{
+		fprintf(stderr, "usage: %s jobs.txt [--threads n] [--repeat k] [--scale] [--quiet]\n", argv[0]);
+		return 2;
+	} // end if
+
+	std::vector<JOB_LINE> lines;
+	if (!Load_Jobs(job_file, lines))
+		return 1;
+
+	// each rom and script once; map nodes don't move, so the pointers hold
+	std::map<std::string, Cartridge> carts;
+	std::map<std::string, InputScript> scripts;
+	std::vector<FLEET_JOB> jobs;
+	for (u32 r = 0; r < repeat; r++)
+	{
+		for (const JOB_LINE& l : lines)
+		{
+			auto c = carts.find(l.rom);
+			if (c == carts.end())
+			{
+				c = carts.emplace(l.rom, Cartridge()).first;
+				if (!c->second.Load(l.rom.c_str()))
+				{
+					fprintf(stderr, "%s\n", c->second.Error().c_str());
+					return 1;
+				} // end if
+			} // end if
+
+			const InputScript* pinput = nullptr;
+			if (l.script != "-")
+			{
+				auto s = scripts.find(l.script);
+				if (s == scripts.end())
+				{
+					s = scripts.emplace(l.script, InputScript()).first;
+					if (!s->second.Load(l.script.c_str()))
+					{
+						fprintf(stderr, "%s\n", s->second.Error().c_str());
+						return 1;
+					} // end if
+				} // end if
+				pinput = &s->second;
+			} // end if
+
+			jobs.push_back({ &c->second, pinput, l.frames });
+		} // end for
+	} // end for
+
+	if (jobs.empty())
+	{
+		fprintf(stderr, "%s: no jobs\n", job_file);
+		return 1;
+	} // end if
+
+	std::vector<FLEET_RESULT> results(jobs.size());
+	u32 most = threads ? threads : std::thread::hardware_concurrency();
+	if (!most)
+		most = 1;
+
+	std::vector<u32> counts;
+	if (bscale)
+		for (u32 n = 1; n < most; n *= 2)
+			counts.push_back(n);
+	counts.push_back(most);
+
+	double one = 0;			// the time on one worker, when --scale ran it
+	for (u32 n : counts)
+	{
+		u64 steals;
+		double secs = Run_Batch(n, jobs, results, steals);
+		if (n == 1)
+			one = secs;
+
+		u64 frames = 0;
+		for (const FLEET_RESULT& r : results)
+			frames += r.frames;
+		fprintf(stderr, "%3u workers %8.3f s  %9.1f jobs/s  %11.0f frames/s  %llu stolen", n, secs,
+			jobs.size() / secs, frames / secs, (unsigned long long)steals);
+		if (bscale)
+			fprintf(stderr, "  %.2fx", one / secs);
+		fprintf(stderr, "\n");
+	} // end for
+
+	fprintf(stderr, "%zu jobs; %zu bytes of machine per worker\n", jobs.size(), sizeof(Bus));
+	if (bquiet)
+		return 0;
+
+	for (size_t i = 0; i < lines.size(); i++)
+	{
+		const JOB_LINE& l = lines[i];
+		const FLEET_RESULT& r = results[i];
+		printf("%s %s %llu %016llx %016llx\n", l.rom.c_str(), l.script.c_str(), (unsigned long long)r.frames,
+			(unsigned long long)r.ram_hash, (unsigned long long)r.audio_hash);
+
+		// repeats of a job have to come out the same as the first, whichever worker ran them
+		for (size_t k = i + lines.size(); k < results.size(); k += lines.size())
+			if (results[k].ram_hash != r.ram_hash || results[k].audio_hash != r.audio_hash)
+			{
+				fprintf(stderr, "job %zu repeat %zu came out different\n", i + 1, k / lines.size());
+				return 1;
+			} // end if
+	} // end for
+
+	return 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,209 @@
+//=========================================================================================================|
+// ForkBench.cpp
+//	Measures the two ways of starting every test case from one warm machine: Bus::Load_State in this
+//	process, or a child forked off a ForkServer. It reports where each one wins.
+//
+//	The rom boots and runs --start frames. That is the warm machine for both ways. Then, for each case
+//	length in --lengths, --cases cases of random pad 1 input are run both ways. Each case ends in a hash
+//	of the 64K, and the two ways have to agree on every one. If they don't, the exit status is 1.
+//
+//	For each length it prints microseconds a case both ways and the page faults a child took. A 0 frame
+//	case is the bare cost of the reset: a Load_State against a fork, exit and reap. Past the length
+//	where the fork server's per case cost levels with in-process, its extra cores (--parallel) are what
+//	decide.
+//
+//	Usage:
+//		ForkBench rom.nes [--start frames] [--cases n] [--lengths a,b,...] [--parallel n] [--seed n]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Cartridge.h"
+#include "ForkServer.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FNV_OFFSET			0xCBF29CE484222325ull
+#define FNV_PRIME			0x100000001B3ull
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * FNV-1a of the 64K, as ForkServer's children work it out.
+ */
+static u64 Hash(const Bus& bus)
+{
+	u64 h = FNV_OFFSET;
+	for (u32 i = 0; i < RAM_SIZE; i++)
+		h = (h ^ bus.ram[i]) * FNV_PRIME;
+	return h;
+} // end Hash
+
+
+//=========================================================================================================|
+/**
+ * Seconds since t.
+ */
+static double Since(std::chrono::steady_clock::time_point t)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count();
+} // end Since
+
+
+//=========================================================================================================|
+int main(int argc, char** argv)
+{
+	const char* rom = nullptr;
+	u64 start = 60;
+	u32 cases = 200;
+	u32 parallel = 0;
+	u64 seed = 1;
+	std::vector<u32> lengths = { 0, 1, 10, 60 };
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--start") && i + 1 < argc)
+			start = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--cases") && i + 1 < argc)
+			cases = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--parallel") && i + 1 < argc)
+			parallel = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+			seed = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--lengths") && i + 1 < argc)
+		{
+			lengths.clear();
+			for (char* p = argv[++i]; *p; p += *p == ',')
+				lengths.push_back((u32)strtoul(p, &p, 0));
+		} // end else if
+		else if (argv[i][0] != '-' && !rom)
+			rom = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	if (!rom || busage || !cases || lengths.empty())
+	{
+		fprintf(stderr, "usage: %s rom.nes [--start frames] [--cases n] [--lengths a,b,...] [--parallel n] "
+			"[--seed n]\n", argv[0]);
+		return 2;
+	} // end if
+
+	Cartridge cart;
+	if (!cart.Load(rom))
+	{
+		fprintf(stderr, "%s\n", cart.Error().c_str());
+		return 1;
+	} // end if
+
+	std::unique_ptr<Bus> bus(new Bus);
+	bus->apu.Set_Output(false);
+	memset(bus->ram, 0, RAM_SIZE);
+	cart.Insert(*bus);
+	bus->Reset();
+	for (u64 f = 0; f < start; f++)
+		bus->Run_Frame();
+
+	std::unique_ptr<MACHINE_STATE> warm(new MACHINE_STATE);
+	bus->Save_State(*warm);
+
+	ForkServer server;
+	if (!server.Start(*bus, parallel))
+	{
+		fprintf(stderr, "%s\n", server.Error().c_str());
+		return 1;
+	} // end if
+
+	printf("%u cases a length, %llu frames in, parallel %s\n", cases, (unsigned long long)start,
+		parallel ? std::to_string(parallel).c_str() : "one per core");
+	printf("%8s %14s %14s %10s %12s\n", "frames", "in-process us", "fork us", "ratio", "faults/case");
+
+	u32 mismatches = 0;
+	u64 rng = seed ? seed : 1;
+	for (u32 frames : lengths)
+	{
+		std::vector<u8> input((size_t)cases * frames);
+		for (u8& b : input)
+		{
+			rng ^= rng >> 12;
+			rng ^= rng << 25;
+			rng ^= rng >> 27;
+			b = (u8)((rng * 0x2545F4914F6CDD1Dull) >> 56);
+		} // end for
+
+		// in-process: back to the warm state, run, hash
+		std::vector<u64> local(cases);
+		auto t = std::chrono::steady_clock::now();
+		for (u32 c = 0; c < cases; c++)
+		{
+			bus->Load_State(*warm);
+			for (u32 f = 0; f < frames; f++)
+			{
+				bus->controller[0] = input[(size_t)c * frames + f];
+				bus->controller[1] = 0;
+				bus->Run_Frame();
+			} // end for
+			local[c] = Hash(*bus);
+		} // end for
+		double in_process = Since(t);
+
+		// forked: one batch
+		std::vector<FORK_RESULT> results(cases);
+		u64 faults = server.Stats().page_faults;
+		t = std::chrono::steady_clock::now();
+		if (!server.Run_Batch(input.data(), frames, cases, results.data()))
+		{
+			fprintf(stderr, "%s\n", server.Error().c_str());
+			return 1;
+		} // end if
+		double forked = Since(t);
+		faults = server.Stats().page_faults - faults;
+
+		for (u32 c = 0; c < cases; c++)
+			if (!results[c].bok || results[c].ram_hash != local[c])
+				mismatches++;
+
+		printf("%8u %14.2f %14.2f %9.1fx %12.1f\n", frames, in_process * 1e6 / cases, forked * 1e6 / cases,
+			forked / in_process, (double)faults / cases);
+	} // end for
+
+	server.Stop();
+	const FORK_STATS& s = server.Stats();
+	printf("%llu cases forked, %llu failed; %u disagree with in-process\n", (unsigned long long)s.cases,
+		(unsigned long long)s.failed, mismatches);
+
+	return mismatches ? 1 : 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
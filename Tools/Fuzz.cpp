@@ -0,0 +1,308 @@
+//=========================================================================================================|
+// Fuzz.cpp
+//	Fuzzes a rom through pad 1 (Fuzzer.h) and reports new coverage and crashes and hangs as they come up.
+//
+//	The rom boots and runs --start frames, off --input if given. That machine is the pristine snapshot
+//	every exec starts from, so the boot is paid once, not per exec. Each exec then plays --frames frames
+//	of mutated input. --seed-input adds an input script's pad 1 as a first corpus entry.
+//
+//	Each new crash or hang is written to --out as an input script, the start frames and all. Headless
+//	replays it from power on. At the end every finding is run again from the snapshot and has to end the
+//	same way. If one doesn't, the exit status is 1.
+//
+//	Before fuzzing it times a reset from the snapshot against putting a machine back together from
+//	scratch (wipe, insert, reset, --start frames). The difference is what the snapshot buys per exec.
+//
+//	Usage:
+//		Fuzz rom.nes [--frames n] [--start frames] [--input script.txt] [--seed-input script.txt]
+//			[--execs n] [--seconds s] [--seed n] [--out dir] [--quiet]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Cartridge.h"
+#include "Fuzzer.h"
+#include "InputScript.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define RESET_TIMINGS		200			// resets of each kind timed before fuzzing
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+static const struct
+{
+	const char* name;
+	u8 bit;
+} BUTTON_NAMES[] =
+{
+	{ "A", BUTTON_A }, { "B", BUTTON_B }, { "SELECT", BUTTON_SELECT }, { "START", BUTTON_START },
+	{ "UP", BUTTON_UP }, { "DOWN", BUTTON_DOWN }, { "LEFT", BUTTON_LEFT }, { "RIGHT", BUTTON_RIGHT }
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Prints what the fuzzer finds and writes the findings out.
+ */
+class Reporter : public FuzzListener
+{
+public:
+
+	Reporter(const InputScript& start_input, u64 start, const char* out, bool bquiet)
+		:start_input(start_input), start(start), out(out), bquiet(bquiet) {}
+
+	void Coverage(const FUZZ_STATS& s, u32 new_edges, u32 new_buckets) override
+	{
+		if (!bquiet)
+			printf("exec %-8llu +%u edges, +%u counts; %llu edges\n", (unsigned long long)s.execs, new_edges,
+				new_buckets, (unsigned long long)s.edges);
+	}
+
+	void Finding(const FUZZ_FINDING& f) override
+	{
+		printf("exec %-8llu %s at $%04X, frame %u\n", (unsigned long long)f.exec,
+			f.kind == FUZZ_CRASH ? "CRASH" : "HANG", f.pc, f.frame);
+		if (out)
+			Write(f);
+	}
+
+private:
+
+	const InputScript& start_input;
+	u64 start;
+	const char* out;
+	bool bquiet;
+
+	void Write(const FUZZ_FINDING& f);
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * A button set as a script would have it; "" for none.
+ */
+static std::string Button_Names(u8 buttons)
+{
+	std::string s;
+	for (const auto& b : BUTTON_NAMES)
+		if (buttons & b.bit)
+			s += (s.empty() ? "" : " ") + std::string(b.name);
+	return s;
+} // end Button_Names
+
+
+//=========================================================================================================|
+/**
+ * The finding as an input script in out: what got the machine to the snapshot, then the exec's input.
+ */
+void Reporter::Write(const FUZZ_FINDING& f)
+{
+	char path[1024];
+	snprintf(path, sizeof(path), "%s/%s-%04X.txt", out, f.kind == FUZZ_CRASH ? "crash" : "hang", f.pc);
+	FILE* fp = fopen(path, "w");
+	if (!fp)
+	{
+		fprintf(stderr, "can't write %s\n", path);
+		return;
+	} // end if
+
+	fprintf(fp, "# %s at $%04X on frame %llu\n", f.kind == FUZZ_CRASH ? "crash" : "hang", f.pc,
+		(unsigned long long)(start + f.frame));
+	for (u64 frame = 0; frame < start; frame++)
+		for (u8 pad = 0; pad < 2; pad++)
+			if (!frame || start_input.Buttons(frame, pad) != start_input.Buttons(frame - 1, pad))
+				fprintf(fp, "%llu %u %s\n", (unsigned long long)frame, pad + 1,
+					Button_Names(start_input.Buttons(frame, pad)).c_str());
+
+	fprintf(fp, "%llu 2\n", (unsigned long long)start);
+	for (u32 i = 0; i < (u32)f.input.size(); i++)
+		if (!i || f.input[i] != f.input[i - 1])
+			fprintf(fp, "%llu 1 %s\n", (unsigned long long)(start + i), Button_Names(f.input[i]).c_str());
+	fclose(fp);
+} // end Write
+
+
+//=========================================================================================================|
+/**
+ * Boots the machine and runs it to the start frame.
+ */
+static void Boot(Bus& bus, const Cartridge& cart, const InputScript& input, u64 start)
+{
+	memset(bus.ram, 0, RAM_SIZE);
+	cart.Insert(bus);
+	bus.Reset();
+	for (u64 f = 0; f < start; f++)
+	{
+		bus.controller[0] = input.Buttons(f, 0);
+		bus.controller[1] = input.Buttons(f, 1);
+		bus.Run_Frame();
+	} // end for
+} // end Boot
+
+
+//=========================================================================================================|
+int main(int argc, char** argv)
+{
+	const char* rom = nullptr;
+	const char* script = nullptr;
+	const char* seed_script = nullptr;
+	const char* out = nullptr;
+	u32 frames = 120;
+	u64 start = 0;
+	u64 execs = 0;
+	double seconds = 0;
+	u64 seed = 1;
+	bool bquiet = false;
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+			frames = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--start") && i + 1 < argc)
+			start = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--input") && i + 1 < argc)
+			script = argv[++i];
+		else if (!strcmp(argv[i], "--seed-input") && i + 1 < argc)
+			seed_script = argv[++i];
+		else if (!strcmp(argv[i], "--execs") && i + 1 < argc)
+			execs = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--seconds") && i + 1 < argc)
+			seconds = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+			seed = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--out") && i + 1 < argc)
+			out = argv[++i];
+		else if (!strcmp(argv[i], "--quiet"))
+			bquiet = true;
+		else if (argv[i][0] != '-' && !rom)
+			rom = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	if (!rom || busage || !frames)
+	{
+		fprintf(stderr, "usage: %s rom.nes [--frames n] [--start frames] [--input script.txt] "
+			"[--seed-input script.txt] [--execs n] [--seconds s] [--seed n] [--out dir] [--quiet]\n", argv[0]);
+		return 2;
+	} // end if
+	if (!execs && !seconds)
+		seconds = 10;
+
+	Cartridge cart;
+	if (!cart.Load(rom))
+	{
+		fprintf(stderr, "%s\n", cart.Error().c_str());
+		return 1;
+	} // end if
+
+	InputScript input, seed_input;
+	if (script && !input.Load(script))
+	{
+		fprintf(stderr, "%s\n", input.Error().c_str());
+		return 1;
+	} // end if
+	if (seed_script && !seed_input.Load(seed_script))
+	{
+		fprintf(stderr, "%s\n", seed_input.Error().c_str());
+		return 1;
+	} // end if
+
+	std::unique_ptr<Bus> bus(new Bus);
+	bus->apu.Set_Output(false);
+	Boot(*bus, cart, input, start);
+	std::unique_ptr<MACHINE_STATE> pristine(new MACHINE_STATE);
+	bus->Save_State(*pristine);
+
+	// what the snapshot saves per exec
+	auto t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < RESET_TIMINGS; i++)
+		bus->Load_State(*pristine);
+	auto t1 = std::chrono::steady_clock::now();
+	for (int i = 0; i < RESET_TIMINGS; i++)
+		Boot(*bus, cart, input, start);
+	auto t2 = std::chrono::steady_clock::now();
+	printf("reset from the snapshot %10.2f us, from scratch %10.2f us (%llu frames)\n",
+		std::chrono::duration<double>(t1 - t0).count() * 1e6 / RESET_TIMINGS,
+		std::chrono::duration<double>(t2 - t1).count() * 1e6 / RESET_TIMINGS, (unsigned long long)start);
+	bus->Load_State(*pristine);
+
+	Fuzzer fuzzer(*bus, frames, seed);
+	Reporter reporter(input, start, out, bquiet);
+	fuzzer.Set_Listener(&reporter);
+
+	if (seed_script)
+	{
+		std::vector<u8> first(frames);
+		for (u32 f = 0; f < frames; f++)
+			first[f] = seed_input.Buttons(f, 0);
+		fuzzer.Add_Seed(first);
+	} // end if
+
+	fuzzer.Run(execs, seconds);
+
+	// the findings again; a fuzzer that can't reproduce what it found is no use
+	u32 reproduced = 0;
+	for (const FUZZ_FINDING& f : fuzzer.Findings())
+	{
+		bool bnew;
+		reproduced += fuzzer.Exec(f.input.data(), bnew) == f.kind;
+	} // end for
+
+	const FUZZ_STATS& s = fuzzer.Stats();
+	double busy = s.reset_seconds + s.frame_seconds + s.map_seconds;
+	u32 crashes = 0, hangs = 0;
+	for (const FUZZ_FINDING& f : fuzzer.Findings())
+		(f.kind == FUZZ_CRASH ? crashes : hangs)++;
+
+	printf("%llu execs in %.2f s: %.1f execs/s, %.0f frames/s\n", (unsigned long long)s.execs, s.seconds,
+		s.execs / s.seconds, s.frames / s.seconds);
+	printf("  %llu edges, %zu in the corpus, %llu coverage events\n", (unsigned long long)s.edges,
+		fuzzer.Corpus_Size(), (unsigned long long)s.coverage_events);
+	printf("  %u crashes and %u hangs (%llu and %llu execs), %u of %zu reproduce\n", crashes, hangs,
+		(unsigned long long)s.crashes, (unsigned long long)s.hangs, reproduced, fuzzer.Findings().size());
+	printf("  reset %5.1f%%  frames %5.1f%%  coverage map %5.1f%%\n", 100 * s.reset_seconds / busy,
+		100 * s.frame_seconds / busy, 100 * s.map_seconds / busy);
+
+	return reproduced == fuzzer.Findings().size() ? 0 : 1;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
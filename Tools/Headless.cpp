@@ -0,0 +1,655 @@
+//=========================================================================================================|
+// Headless.cpp
+//	Runs a game with nothing attached; no window, no sound card, no keyboard. The ROM goes on the bus, the
+//	cpu gets reset and N frames are run as fast as the host can go, with the pads driven by an input
+//	script (see InputScript.h). At the end it prints frames per second, emulated MHz, peak RSS and hashes
+//	of the final state, so two runs (or two builds) can be compared on both speed and behaviour.
+//
+//	This is the project's throughput number, and the thing to point perf or a PGO training run at.
+//
+//	There is no PPU yet, hence no framebuffer to hash; the state hash covers the 64K of memory and the
+//	audio hash every sample the APU produced along the way.
+//
+//	Built as bin/Headless-stats (i.e. with XNEST_CPU_STATS on), --stats also dumps the cpu's execution
+//	counters for the run; CSV, or JSON when the file name ends in .json.
+//
+//	--profile prefix runs the guest profiler (Profiler.h) along, writing prefix.folded (collapsed stacks
+//	for a flame graph) and prefix.hist (sampled pc's), and printing the subroutines that cost the most.
+//
+//	The stats build also takes --heatmap file, writing a memory heat snapshot (MemHeat.h) every
+//	--heat-every frames (default 60) and at the end; Tools/HeatmapPng renders them.
+//
+//	--metrics name publishes live numbers (speed, frame times, host cpu) in shared memory as it runs
+//	(Metrics.h); Tools/MetricsView watches them.
+//
+//	--latency [hexaddr-hexaddr] follows every input change through to the game reading it and the first
+//	frame that came out different (LatencyTracer.h), hashing the given memory as the frame's output, and
+//	prints p50/p99 in frames and ms. Any change to that memory counts as the answer, so it also prints how
+//	many frames changed at all, and warns when the range changes by itself most frames.
+//
+//	--run-ahead n shows every frame from n (1-4) frames ahead (RunAhead.h); the latency numbers are then
+//	what a player would see, and the save/load cost of each frame is printed. It doesn't go with the
+//	debugging options, which would see the speculative frames as well.
+//
+//	Built as bin/Headless-recomp (i.e. with XNEST_RECOMPILED on and a rom recompiled in; see Makefile), it
+//	runs that rom's code through the recompiled blocks (Recompiled.h) and prints how much of the run they
+//	covered; any other rom runs interpreted, with a warning. The hashes should come out the same as the
+//	plain build's.
+//
+//	--wav file / --null-audio send the audio down the path a front end's would take: into an AudioRing,
+//	out of it on a sink's callback thread (AudioSink.h), to a .wav file or nowhere. The sink drains as fast
+//	as it can and the emulator waits for room, so nothing is lost and the audio hash stays the same. With
+//	--realtime the frames are paced at the NTSC rate and the sink runs like a sound card. The ring's rate
+//	control then steers the apu's resampling ratio, within +/-0.5%, to keep the ring half full. The fill
+//	level, underruns, dropped samples and the ratio's range are printed at the end.
+//
+//	--trace file records every instruction into a binary trace (Tracer.h); Tools/TraceConv makes text of it.
+//
+//	--break hexaddr[:n] stops the run the n'th time (default the first) the cpu gets to hexaddr, and
+//	--watch / --watch-read hexaddr[-hexaddr] when something writes / reads there (Breakpoints.h); all of them
+//	can be given more than once, and --if expr after any of them adds a condition to it (Condition.h), e.g.
+//	--break C0A4 --if "A == $40 && [$00FF] > 3". What stopped it is printed and the exit status is 3, so
+//	scripts can tell "got there" from "ran out of frames".
+//
+//	Usage:
+//		Headless rom.nes [--frames n] [--input script.txt] [--raw hexaddr [--pc hexaddr]] [--stats file]
+//		         [--profile prefix [--profile-period cycles]] [--trace file]
+//		         [--heatmap file [--heat-every frames]] [--break hexaddr[:n]] [--watch hexaddr[-hexaddr]]
+//		         [--watch-read hexaddr[-hexaddr]] [--if expr] [--metrics name]
+//		         [--latency [hexaddr-hexaddr]] [--run-ahead n] [--wav file | --null-audio [--realtime]]
+//		         [--quiet]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "AudioSink.h"
+#include "Bus.h"
+#include "Cartridge.h"
+#include "CpuCounters.h"
+#include "InputScript.h"
+#include "InputSource.h"
+#include "LatencyTracer.h"
+#include "Metrics.h"
+#include "Profiler.h"
+#include "RunAhead.h"
+#include "Tracer.h"
+#if XNEST_RECOMPILED
+#include "Recompiled.h"
+#endif
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FNV_OFFSET		0xCBF29CE484222325ull
+#define FNV_PRIME		0x100000001B3ull
+
+#define AUDIO_CHUNK		1024
+#define AUDIO_RATE		44100		// what the apu resamples to for the sinks
+
+// 1 in bin/Headless-recomp, which has a RECOMPILED_MODULE linked in
+#ifndef XNEST_RECOMPILED
+#define XNEST_RECOMPILED	0
+#endif
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+/**
+ * What's shown, as far as a headless run has anything shown: the latency tracer's frame.
+ */
+class LatencyPresenter : public FramePresenter
+{
+public:
+
+	LatencyPresenter(LatencyTracer* platency) : platency{ platency } {}
+	void Present(const Bus&) override { if (platency) platency->Frame_End(); }
+
+private:
+
+	LatencyTracer* platency;
+};
+
+
+
+#if XNEST_RECOMPILED
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+extern const RECOMP_MODULE RECOMPILED_MODULE;		// out of obj/recomp, made by Tools/Recompile
+#endif
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * FNV-1a over len bytes, continuing from h.
+ */
+static u64 Hash(u64 h, const void* data, size_t len)
+{
+	const u8* p = (const u8*)data;
+	for (size_t i = 0; i < len; i++)
+		h = (h ^ p[i]) * FNV_PRIME;
+	return h;
+} // end Hash
+
+
+//=========================================================================================================|
+/**
+ * Parses "addr[-addr]" (hex).
+ */
+static void Parse_Range(const char* arg, u16& lo, u16& hi)
+{
+	char* end;
+	lo = (u16)strtoul(arg, &end, 16);
+	hi = *end == '-' ? (u16)strtoul(end + 1, nullptr, 16) : lo;
+} // end Parse_Range
+
+
+//=========================================================================================================|
+/**
+ * Parses "addr[-addr]" (hex) into a watchpoint of kind.
+ */
+static BREAKPOINT Parse_Watch(u8 kind, const char* arg)
+{
+	u16 lo, hi;
+	Parse_Range(arg, lo, hi);
+	return { kind, lo, hi, BREAK_ALWAYS, BREAK_EQ, 0, 0, false };
+} // end Parse_Watch
+
+
+//=========================================================================================================|
+/**
+ * The most memory this process has had resident, in kilobytes.
+ */
+static u64 Peak_Rss_Kb()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+		return pmc.PeakWorkingSetSize / 1024;
+	return 0;
+#else
+	struct rusage ru;
+	getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+	return ru.ru_maxrss / 1024;		// bytes there
+#else
+	return ru.ru_maxrss;
+#endif
+#endif
+} // end Peak_Rss_Kb
+
+
+//=========================================================================================================|
+// program entry point
+int main(int argc, char** argv)
+{
+	const char* rom = nullptr;
+	const char* script = nullptr;
+	const char* stats = nullptr;
+	const char* profile = nullptr;
+	u32 profile_period = 100;
+	const char* trace = nullptr;
+	const char* heatmap = nullptr;
+	u64 heat_every = 60;
+	const char* metrics_name = nullptr;
+	const char* latency_range = nullptr;
+	bool blatency = false;
+	int run_ahead = 0;
+	u64 frames = 600;
+	long raw_addr = -1;
+	long start_pc = -1;
+	std::vector<BREAKPOINT> breaks;
+	std::vector<std::string> conditions;		// one per breaks entry
+	const char* wav = nullptr;
+	bool bnull_audio = false;
+	bool brealtime = false;
+	bool bquiet = false;
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+			frames = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--input") && i + 1 < argc)
+			script = argv[++i];
+		else if (!strcmp(argv[i], "--raw") && i + 1 < argc)
+			raw_addr = strtol(argv[++i], nullptr, 16) & 0xFFFF;
+		else if (!strcmp(argv[i], "--pc") && i + 1 < argc)
+			start_pc = strtol(argv[++i], nullptr, 16) & 0xFFFF;
+		else if (!strcmp(argv[i], "--stats") && i + 1 < argc)
+			stats = argv[++i];
+		else if (!strcmp(argv[i], "--profile") && i + 1 < argc)
+			profile = argv[++i];
+		else if (!strcmp(argv[i], "--profile-period") && i + 1 < argc)
+			profile_period = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--trace") && i + 1 < argc)
+			trace = argv[++i];
+		else if (!strcmp(argv[i], "--heatmap") && i + 1 < argc)
+			heatmap = argv[++i];
+		else if (!strcmp(argv[i], "--heat-every") && i + 1 < argc)
+			heat_every = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--break") && i + 1 < argc)
+		{
+			char* end;
+			u16 pc = (u16)strtoul(argv[++i], &end, 16);
+			u64 n = *end == ':' ? strtoull(end + 1, nullptr, 0) : 1;
+			breaks.push_back({ BREAK_EXEC, pc, pc, BREAK_ALWAYS, BREAK_EQ, 0, n ? n - 1 : 0, false });
+			conditions.push_back("");
+		} // end else if
+		else if ((!strcmp(argv[i], "--watch") || !strcmp(argv[i], "--watch-read")) && i + 1 < argc)
+		{
+			u8 kind = !strcmp(argv[i], "--watch") ? BREAK_WRITE : BREAK_READ;
+			breaks.push_back(Parse_Watch(kind, argv[++i]));
+			conditions.push_back("");
+		} // end else if
+		else if (!strcmp(argv[i], "--if") && i + 1 < argc && !breaks.empty())
+			conditions.back() = argv[++i];
+		else if (!strcmp(argv[i], "--metrics") && i + 1 < argc)
+			metrics_name = argv[++i];
+		else if (!strcmp(argv[i], "--latency"))
+		{
+			blatency = true;
+			if (i + 1 < argc && argv[i + 1][0] != '-' && strchr(argv[i + 1], '-'))
+				latency_range = argv[++i];
+		} // end else if
+		else if (!strcmp(argv[i], "--run-ahead") && i + 1 < argc)
+		{
+			run_ahead = atoi(argv[++i]);
+			busage = busage || run_ahead < 1 || run_ahead > RUNAHEAD_MAX;
+		} // end else if
+		else if (!strcmp(argv[i], "--wav") && i + 1 < argc)
+			wav = argv[++i];
+		else if (!strcmp(argv[i], "--null-audio"))
+			bnull_audio = true;
+		else if (!strcmp(argv[i], "--realtime"))
+			brealtime = true;
+		else if (!strcmp(argv[i], "--quiet"))
+			bquiet = true;
+		else if (argv[i][0] != '-' && !rom)
+			rom = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	busage = busage || (wav && bnull_audio) || (brealtime && !wav && !bnull_audio);
+	if (!rom || busage)
+	{
+		fprintf(stderr, "usage: %s rom.nes [--frames n] [--input script.txt] [--raw hexaddr [--pc hexaddr]] "
+			"[--stats file] [--profile prefix [--profile-period cycles]] [--trace file] "
+			"[--heatmap file [--heat-every frames]] [--break hexaddr[:n]] [--watch hexaddr[-hexaddr]] "
+			"[--watch-read hexaddr[-hexaddr]] [--if expr] [--metrics name] [--latency [hexaddr-hexaddr]] "
+			"[--run-ahead n] [--wav file | --null-audio [--realtime]] [--quiet]\n", argv[0]);
+		return 2;
+	} // end if
+	if (run_ahead && (trace || profile || !breaks.empty()))
+	{
+		fprintf(stderr, "--run-ahead doesn't go with --trace, --profile, --break or --watch\n");
+		return 2;
+	} // end if
+
+	Cartridge cart;
+	bool bloaded = raw_addr >= 0 ? cart.Load_Raw(rom, (u16)raw_addr) : cart.Load(rom);
+	if (!bloaded)
+	{
+		fprintf(stderr, "%s\n", cart.Error().c_str());
+		return 1;
+	} // end if
+
+	InputScript input;
+	if (stats && !CpuCounters<XNEST_CPU_STATS != 0>::ENABLED)
+	{
+		fprintf(stderr, "--stats needs a build with XNEST_CPU_STATS=1 (bin/Headless-stats)\n");
+		return 2;
+	} // end if
+
+	if (heatmap && !MemHeat<XNEST_HEATMAP>::LEVEL)
+	{
+		fprintf(stderr, "--heatmap needs a build with XNEST_HEATMAP=1 or 2 (bin/Headless-stats)\n");
+		return 2;
+	} // end if
+
+	if (script && !input.Load(script))
+	{
+		fprintf(stderr, "%s\n", input.Error().c_str());
+		return 1;
+	} // end if
+
+	// the bus is big; keep it off the stack
+	std::unique_ptr<Bus> bus(new Bus);
+	cart.Insert(*bus);
+	bus->Reset();
+
+	std::unique_ptr<Profiler> profiler;
+	if (profile)
+	{
+		profiler.reset(new Profiler(profile_period));
+		profiler->Attach(bus->cpu6502);
+	} // end if
+
+	if (start_pc >= 0)
+	{
+		CPU_STATE s;
+		bus->cpu6502.Save_State(s);
+		s.pc = (u16)start_pc;
+		bus->cpu6502.Load_State(s);
+	} // end if
+
+#if XNEST_RECOMPILED
+	Recompiled recompiled(RECOMPILED_MODULE);
+	if (!recompiled.Attach(*bus))
+		fprintf(stderr, "%s; running interpreted\n", recompiled.Error().c_str());
+#endif
+
+	for (size_t i = 0; i < breaks.size(); i++)
+	{
+		int id = bus->breakpoints.Add(breaks[i]);
+		if (!bus->breakpoints.Set_Condition(id, conditions[i].c_str()))
+		{
+			fprintf(stderr, "%s\n", bus->breakpoints.Error().c_str());
+			return 2;
+		} // end if
+	} // end for
+
+	std::unique_ptr<Tracer> tracer;
+	if (trace)
+	{
+		tracer.reset(new Tracer);
+		if (!tracer->Open(trace))
+		{
+			fprintf(stderr, "can't write %s\n", trace);
+			return 1;
+		} // end if
+		tracer->Attach(*bus);
+	} // end if
+
+	// the audio path a front end has: the ring, the sink's callback thread on the other end of it
+	AudioRing ring;
+	std::unique_ptr<AudioSink> sink;
+	if (wav)
+	{
+		WavSink* pwav = new WavSink(ring, AUDIO_RATE, brealtime);
+		sink.reset(pwav);
+		if (!pwav->Open(wav))
+		{
+			fprintf(stderr, "can't write %s\n", wav);
+			return 1;
+		} // end if
+	} // end if
+	else if (bnull_audio)
+		sink.reset(new NullSink(ring, AUDIO_RATE, brealtime));
+	if (sink)
+		bus->apu.Set_Sample_Rate(AUDIO_RATE);
+
+	Metrics metrics;
+	if (metrics_name && !metrics.Open(metrics_name))
+	{
+		fprintf(stderr, "%s\n", metrics.Error().c_str());
+		return 1;
+	} // end if
+	if (sink)
+		metrics.Set_Audio(&ring);
+
+	std::unique_ptr<LatencyTracer> latency;
+	if (blatency)
+	{
+		u16 lo = 0x0200, hi = 0x02FF;
+		if (latency_range)
+			Parse_Range(latency_range, lo, hi);
+		latency.reset(new LatencyTracer(lo, hi));
+		latency->Attach(*bus);
+	} // end if
+
+	if (!bquiet)
+		printf("%s: %zuK prg, %zuK chr, mapper %u; %llu frames, %zu input changes\n", rom,
+			cart.Prg_Size() / 1024, cart.Chr_Size() / 1024, cart.Mapper(), (unsigned long long)frames,
+			input.Events());
+
+	FILE* heat_fp = nullptr;
+	if (heatmap)
+	{
+		heat_fp = fopen(heatmap, "wb");
+		if (!heat_fp || !Write_Heat_Header(heat_fp, MemHeat<XNEST_HEATMAP>::LEVEL))
+		{
+			fprintf(stderr, "can't write %s\n", heatmap);
+			return 1;
+		} // end if
+		bus->heat.Clear();
+	} // end if
+	u64 heat_from = 0;
+	bool bheat_ok = true;
+
+	s16 audio[AUDIO_CHUNK];
+	u64 audio_hash = FNV_OFFSET;
+	u64 audio_samples = 0;
+
+	ScriptedInput source(input);
+	LatencyPresenter presenter(latency.get());
+	RunAhead ahead(*bus, run_ahead);
+	ahead.Set_Presenter(&presenter);
+	bool bstopped = false;
+	auto start = std::chrono::steady_clock::now();
+
+	// in real time the sink starts once the ring is primed; free running, straight away
+	const auto frame_time = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<double>(1.0 / NTSC_FRAME_RATE));
+	auto frame_due = start;
+	double ratio_lo = 1.0, ratio_hi = 1.0;
+	if (sink && !brealtime)
+		sink->Start();
+	for (u64 f = 0; f < frames && !bstopped; f++)
+	{
+		INPUT_FRAME in;
+		source.Sample(f, in);
+		for (u8 port = 0; port < 2; port++)
+			if (latency && in.pads[port] != bus->controller[port])
+				latency->Input(port, in.pads[port]);
+		bstopped = !ahead.Run_Frame(in);
+
+		// drain the frame's audio, or the blip buffer fills up
+		int n;
+		while ((n = bus->apu.Read_Samples(audio, AUDIO_CHUNK)) > 0)
+		{
+			audio_hash = Hash(audio_hash, audio, n * sizeof(s16));
+			audio_samples += n;
+
+			// free running, wait for the sink rather than drop anything
+			while (sink && !brealtime && ring.Capacity() - ring.Fill() < (u32)n)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			if (sink)
+				ring.Push(audio, n);
+		} // end while
+
+		if (sink && brealtime)
+		{
+			if (ring.Fill() >= ring.Capacity() / 2)
+				sink->Start();		// a no-op once it's going
+
+			double ratio = ring.Rate_Adjust();
+			bus->apu.Set_Rate_Adjust(ratio);
+			ratio_lo = ratio < ratio_lo ? ratio : ratio_lo;
+			ratio_hi = ratio > ratio_hi ? ratio : ratio_hi;
+
+			frame_due += frame_time;
+			std::this_thread::sleep_until(frame_due);
+		} // end if
+
+		metrics.Frame(*bus);
+
+		// each snapshot covers the frames since the last one
+		if (heat_fp && (f + 1 - heat_from == heat_every || f + 1 == frames || bstopped))
+		{
+			bheat_ok = Write_Heat_Snapshot(heat_fp, *bus->heat.Get(), f + 1, f + 1 - heat_from) && bheat_ok;
+			bus->heat.Clear();
+			heat_from = f + 1;
+		} // end if
+	} // end for
+
+	if (heat_fp && (fclose(heat_fp) != 0 || !bheat_ok))
+	{
+		fprintf(stderr, "writing %s failed\n", heatmap);
+		return 1;
+	} // end if
+	if (tracer && !tracer->Close())
+	{
+		fprintf(stderr, "writing %s failed\n", trace);
+		return 1;
+	} // end if
+	double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	u64 ram_hash = Hash(FNV_OFFSET, bus->ram, RAM_SIZE);
+
+	static const char* BREAK_NAMES[BREAK_KINDS] = { "exec", "read", "write" };
+	for (const BREAK_HIT& h : bus->breakpoints.Hits())
+	{
+		const CPU6502& cpu = bus->cpu6502;
+		printf("stopped     #%d %s $%04X", h.id, BREAK_NAMES[h.kind], h.addr);
+		if (h.kind != BREAK_EXEC)
+			printf(" = $%02X by $%04X", h.data, h.pc);
+		printf(" (hit %llu) at cycle %llu, frame %llu; PC:%04X A:%02X X:%02X Y:%02X P:%02X SP:%02X\n",
+			(unsigned long long)bus->breakpoints.Hit_Count(h.id), (unsigned long long)h.cycle,
+			(unsigned long long)bus->frame_count, cpu.Pc(), cpu.A(), cpu.X(), cpu.Y(), cpu.Status(), cpu.Sp());
+	} // end for
+
+	frames = bus->frame_count;
+	printf("frames      %llu\n", (unsigned long long)frames);
+	printf("seconds     %.3f\n", secs);
+	printf("fps         %.1f\n", frames / secs);
+	printf("emulated    %.2f MHz (%.1fx realtime)\n", bus->system_clock / secs / 1e6,
+		bus->system_clock / secs / APU_CLOCK_RATE);
+	printf("peak rss    %.1f MB\n", Peak_Rss_Kb() / 1024.0);
+	printf("ram hash    %016llx\n", (unsigned long long)ram_hash);
+	printf("audio hash  %016llx (%llu samples)\n", (unsigned long long)audio_hash,
+		(unsigned long long)audio_samples);
+	printf("framebuffer n/a (no ppu)\n");
+
+	if (sink)
+	{
+		// free running, this drains the ring first
+		u32 fill = ring.Fill();
+		sink->Stop();
+		AUDIO_RING_STATS as;
+		ring.Get_Stats(as);
+		printf("audio out   %s, %s; %llu samples out, %llu dropped\n", wav ? wav : "null",
+			brealtime ? "real time" : "free running", (unsigned long long)as.pulled,
+			(unsigned long long)as.overrun_samples);
+		printf("  ring      %u of %u queued at the end, %llu underruns (%llu samples padded); "
+			"rate %.4f to %.4f\n", fill, as.capacity, (unsigned long long)as.underruns,
+			(unsigned long long)as.underrun_samples, ratio_lo, ratio_hi);
+	} // end if
+
+	if (tracer)
+		printf("trace       %llu instructions, %llu stalls on the writer\n",
+			(unsigned long long)tracer->Records(), (unsigned long long)tracer->Stalls());
+
+	if (latency)
+	{
+		LATENCY_STATS ls;
+		latency->Get_Stats(ls);
+		printf("latency     %llu changes, %llu read, %llu answered, %llu dropped\n",
+			(unsigned long long)ls.changes, (unsigned long long)ls.read, (unsigned long long)ls.answered,
+			(unsigned long long)ls.dropped);
+		printf("  to read   p50 %.0f  p99 %.0f frames\n", ls.read_frames.p50, ls.read_frames.p99);
+		printf("  to output p50 %.0f  p99 %.0f frames; %.1f / %.1f ms emulated, %.3f / %.3f ms host\n",
+			ls.frames.p50, ls.frames.p99, ls.emulated_ms.p50, ls.emulated_ms.p99, ls.host_ms.p50, ls.host_ms.p99);
+		printf("  output    changed on %llu of %llu frames\n", (unsigned long long)ls.changed,
+			(unsigned long long)ls.shown);
+		if (ls.changed * 2 > ls.shown)
+			printf("  note      the range changes on its own most frames, so any input reads as answered by the "
+				"next one; pick a range only the input moves\n");
+	} // end if
+
+	if (run_ahead)
+	{
+		double n = ahead.Host_Frames() ? (double)ahead.Host_Frames() : 1;
+		printf("run-ahead   %d frames; %llu shown, %llu speculative (%.1f shown per second)\n", run_ahead,
+			(unsigned long long)ahead.Host_Frames(), (unsigned long long)ahead.Speculative_Frames(),
+			ahead.Host_Frames() / secs);
+		printf("  state     %.2f us save, %.2f us load, %zu bytes\n", ahead.Save_Seconds() * 1e6 / n,
+			ahead.Load_Seconds() * 1e6 / n, sizeof(MACHINE_STATE));
+	} // end if
+
+#if XNEST_RECOMPILED
+	{
+		const RECOMP_STATS& rs = recompiled.Stats();
+		u64 cycles = rs.compiled_cycles + rs.interpreted_cycles;
+		printf("recompiled  %u blocks, %u instructions; %.1f%% of cycles in %llu block calls, %llu misses\n",
+			RECOMPILED_MODULE.count, RECOMPILED_MODULE.instructions, cycles ? 100.0 * rs.compiled_cycles / cycles : 0.0,
+			(unsigned long long)rs.blocks, (unsigned long long)rs.misses);
+	}
+#endif
+
+	if (stats && !Write_Counters(bus->cpu6502, stats))
+		return 1;
+
+	if (profiler)
+	{
+		profiler->Detach();
+
+		std::string folded = std::string(profile) + ".folded";
+		std::string hist = std::string(profile) + ".hist";
+		if (!profiler->Write_Collapsed(folded.c_str()) || !profiler->Write_Histogram(hist.c_str()))
+		{
+			fprintf(stderr, "can't write %s/%s\n", folded.c_str(), hist.c_str());
+			return 1;
+		} // end if
+
+		std::vector<PROFILE_FUNCTION> funcs;
+		profiler->Get_Functions(funcs);
+
+		printf("\n%-12s %10s %14s %7s %14s %7s\n", "subroutine", "calls", "exclusive", "%", "inclusive", "%");
+		double total = (double)profiler->Total_Cycles();
+		for (size_t i = 0; i < funcs.size() && i < 15; i++)
+		{
+			char name[32];
+			Profiler::Name(funcs[i].entry, funcs[i].kind, name, sizeof(name));
+			printf("%-12s %10llu %14llu %6.2f%% %14llu %6.2f%%\n", name, (unsigned long long)funcs[i].calls,
+				(unsigned long long)funcs[i].exclusive, 100 * funcs[i].exclusive / total,
+				(unsigned long long)funcs[i].inclusive, 100 * funcs[i].inclusive / total);
+		} // end for
+		printf("%llu samples; wrote %s and %s\n", (unsigned long long)profiler->Samples(), folded.c_str(),
+			hist.c_str());
+	} // end if
+
+	return bstopped ? 3 : 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,293 @@
+//=========================================================================================================|
+// HeatmapPng.cpp
+//	Renders a memory heat file (see MemHeat.h) as a PNG: four panels side by side for reads, writes,
+//	executes and writes-to-code. Each panel is the 64K laid out as 256 rows of 256 bytes, page $00 at the
+//	top; per page files get one 16x16 block per page, row by row. Counts go through a log scale per panel,
+//	black for never touched up to white for the hottest.
+//
+//	By default every snapshot in the file is summed; --snapshot n picks one out.
+//
+//	The PNG is written with stored (uncompressed) deflate blocks, so there's nothing to link against; a
+//	heatmap is ~800K before any optimiser gets to it.
+//
+//	Usage:
+//		HeatmapPng in.heat out.png [--snapshot n]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "MemHeat.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define PANEL_SIZE		256			// pixels a side
+#define PANEL_GAP		8
+#define IMAGE_WIDTH		(HEAT_KINDS * PANEL_SIZE + (HEAT_KINDS - 1) * PANEL_GAP)
+#define IMAGE_HEIGHT	PANEL_SIZE
+#define STORED_MAX		65535		// most a stored deflate block holds
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+static const char* KIND_NAMES[HEAT_KINDS] = { "read", "write", "exec", "smc" };
+
+// colour ramp stops; black, purple, red, orange, yellow, white
+static const float RAMP[6][3] =
+{
+	{ 0, 0, 0 }, { 80, 20, 120 }, { 200, 30, 40 }, { 250, 130, 20 }, { 250, 230, 60 }, { 255, 255, 255 }
+};
+
+static u32 crc_table[256];
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * The usual PNG/zlib crc32 table.
+ */
+static void Init_Crc()
+{
+	for (u32 n = 0; n < 256; n++)
+	{
+		u32 c = n;
+		for (int k = 0; k < 8; k++)
+			c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+		crc_table[n] = c;
+	} // end for
+} // end Init_Crc
+
+
+//=========================================================================================================|
+/**
+ * Continues a crc32 over len bytes.
+ */
+static u32 Crc(u32 crc, const u8* p, size_t len)
+{
+	crc = ~crc;
+	for (size_t i = 0; i < len; i++)
+		crc = crc_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+} // end Crc
+
+
+//=========================================================================================================|
+/**
+ * Big endian u32 into a byte vector.
+ */
+static void Put32(std::vector<u8>& v, u32 x)
+{
+	v.push_back(x >> 24); v.push_back(x >> 16); v.push_back(x >> 8); v.push_back(x);
+} // end Put32
+
+
+//=========================================================================================================|
+/**
+ * Writes one PNG chunk: length, type, data, crc over type and data.
+ */
+static bool Write_Chunk(FILE* fp, const char* type, const std::vector<u8>& data)
+{
+	std::vector<u8> buf;
+	Put32(buf, (u32)data.size());
+	buf.insert(buf.end(), type, type + 4);
+	buf.insert(buf.end(), data.begin(), data.end());
+	Put32(buf, Crc(0, buf.data() + 4, buf.size() - 4));
+	return fwrite(buf.data(), 1, buf.size(), fp) == buf.size();
+} // end Write_Chunk
+
+
+//=========================================================================================================|
+/**
+ * Saves width x height of RGB as a PNG; a zlib stream of stored blocks, one filter byte (none) per row.
+ */
+static bool Write_Png(const char* path, const std::vector<u8>& rgb, int width, int height)
+{
+	FILE* fp = fopen(path, "wb");
+	if (!fp)
+		return false;
+
+	static const u8 SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	bool bok = fwrite(SIGNATURE, 1, 8, fp) == 8;
+
+	std::vector<u8> ihdr;
+	Put32(ihdr, width);
+	Put32(ihdr, height);
+	ihdr.push_back(8);		// bits per channel
+	ihdr.push_back(2);		// RGB
+	ihdr.push_back(0); ihdr.push_back(0); ihdr.push_back(0);
+	bok = bok && Write_Chunk(fp, "IHDR", ihdr);
+
+	std::vector<u8> raw;
+	for (int y = 0; y < height; y++)
+	{
+		raw.push_back(0);
+		raw.insert(raw.end(), rgb.begin() + (size_t)y * width * 3, rgb.begin() + (size_t)(y + 1) * width * 3);
+	} // end for
+
+	std::vector<u8> z = { 0x78, 0x01 };
+	u32 s1 = 1, s2 = 0;
+	for (size_t pos = 0; pos < raw.size(); )
+	{
+		size_t n = raw.size() - pos;
+		if (n > STORED_MAX) n = STORED_MAX;
+
+		z.push_back(pos + n == raw.size() ? 1 : 0);		// last block?
+		z.push_back(n & 0xFF); z.push_back(n >> 8);
+		z.push_back(~n & 0xFF); z.push_back((~n >> 8) & 0xFF);
+		z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + n);
+
+		for (size_t i = pos; i < pos + n; i++)
+		{
+			s1 = (s1 + raw[i]) % 65521;
+			s2 = (s2 + s1) % 65521;
+		} // end for
+		pos += n;
+	} // end for
+	Put32(z, (s2 << 16) | s1);
+
+	bok = bok && Write_Chunk(fp, "IDAT", z);
+	bok = bok && Write_Chunk(fp, "IEND", std::vector<u8>());
+	return fclose(fp) == 0 && bok;
+} // end Write_Png
+
+
+//=========================================================================================================|
+/**
+ * t in [0, 1] along the ramp.
+ */
+static void Ramp(double t, u8* out)
+{
+	double f = t * 5;
+	int i = (int)f;
+	if (i >= 5) { i = 4; f = 5; }
+	double w = f - i;
+	for (int c = 0; c < 3; c++)
+		out[c] = (u8)(RAMP[i][c] + (RAMP[i + 1][c] - RAMP[i][c]) * w + 0.5);
+} // end Ramp
+
+
+//=========================================================================================================|
+// program entry point
+int main(int argc, char** argv)
+{
+	const char* in_path = nullptr;
+	const char* out_path = nullptr;
+	long pick = -1;
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--snapshot") && i + 1 < argc)
+			pick = atol(argv[++i]);
+		else if (argv[i][0] != '-' && !in_path)
+			in_path = argv[i];
+		else if (argv[i][0] != '-' && !out_path)
+			out_path = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	if (!in_path || !out_path || busage)
+	{
+		fprintf(stderr, "usage: %s in.heat out.png [--snapshot n]\n", argv[0]);
+		return 2;
+	} // end if
+
+	FILE* fp = fopen(in_path, "rb");
+	HEAT_HEADER h;
+	if (!fp || fread(&h, sizeof(h), 1, fp) != 1 || memcmp(h.magic, HEAT_MAGIC, sizeof(h.magic)) ||
+		(h.rows != HEAT_PAGES && h.rows != HEAT_BYTES))
+	{
+		fprintf(stderr, "%s is not a heat file\n", in_path);
+		if (fp) fclose(fp);
+		return 1;
+	} // end if
+
+	// sum (or pick) the snapshots
+	std::vector<u64> counts((size_t)HEAT_KINDS * h.rows, 0), snap(counts.size());
+	HEAT_SNAPSHOT s;
+	long index = 0, used = 0;
+	u64 frames = 0;
+	while (fread(&s, sizeof(s), 1, fp) == 1 && fread(snap.data(), sizeof(u64), snap.size(), fp) == snap.size())
+	{
+		if (pick < 0 || pick == index)
+		{
+			for (size_t i = 0; i < counts.size(); i++)
+				counts[i] += snap[i];
+			frames += s.frames;
+			used++;
+		} // end if
+		index++;
+	} // end while
+	fclose(fp);
+
+	if (!used)
+	{
+		fprintf(stderr, "%s: no such snapshot (the file has %ld)\n", in_path, index);
+		return 1;
+	} // end if
+
+	Init_Crc();
+	std::vector<u8> rgb((size_t)IMAGE_WIDTH * IMAGE_HEIGHT * 3, 32);		// gaps in dark grey
+
+	for (int k = 0; k < HEAT_KINDS; k++)
+	{
+		const u64* c = &counts[(size_t)k * h.rows];
+		u64 max = 0;
+		for (u32 i = 0; i < h.rows; i++)
+			if (c[i] > max) max = c[i];
+		double scale = max ? 1.0 / log1p((double)max) : 0;
+
+		for (int y = 0; y < PANEL_SIZE; y++)
+		{
+			for (int x = 0; x < PANEL_SIZE; x++)
+			{
+				u32 row = h.rows == HEAT_BYTES ? (u32)(y * 256 + x) : (u32)((y / 16) * 16 + x / 16);
+				u8* px = &rgb[((size_t)y * IMAGE_WIDTH + k * (PANEL_SIZE + PANEL_GAP) + x) * 3];
+				Ramp(log1p((double)c[row]) * scale, px);
+			} // end for x
+		} // end for y
+
+		printf("%-5s max %llu per %s\n", KIND_NAMES[k], (unsigned long long)max,
+			h.rows == HEAT_BYTES ? "byte" : "page");
+	} // end for
+
+	if (!Write_Png(out_path, rgb, IMAGE_WIDTH, IMAGE_HEIGHT))
+	{
+		fprintf(stderr, "can't write %s\n", out_path);
+		return 1;
+	} // end if
+
+	printf("%ld of %ld snapshots, %llu frames -> %s\n", used, index, (unsigned long long)frames, out_path);
+	return 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,318 @@
+//=========================================================================================================|
+// InputSearch.cpp
+//	Brute-forces controller input (Search.h). It boots the rom and runs --start frames, off --input if
+//	given, to get the starting machine. From there it searches --depth steps of --step frames each, over
+//	the --actions, for the highest --score. The score is a breakpoint condition (Condition.h) evaluated as
+//	a number, so "[$0086]" is the byte at $0086 and "[$0086] + [$0087] * 256" a 16-bit one.
+//
+//	--beam w keeps the best w per level (default 64); --bfs keeps every one. --no-dedupe keeps children
+//	that came out identical to one before them.
+//
+//	The best sequence found is replayed from the start on a fresh machine, and its score has to come out
+//	the same; if not, the exit status is 1. --out writes the start script plus that sequence as an input
+//	script, which Headless will play.
+//
+//	What it cost goes to stderr: nodes and frames a second, and the average clone, frame and save, as
+//	well as their share of the workers' time. That is where a search like this spends it.
+//
+//	Usage:
+//		InputSearch rom.nes [--start frames] [--input script.txt] [--score expr] [--actions list]
+//			[--depth n] [--step frames] [--beam w | --bfs] [--no-dedupe] [--threads n] [--out script.txt]
+//
+//	The actions are a comma separated list of button sets, each buttons joined by +, e.g. the default
+//	"none,RIGHT,RIGHT+A,RIGHT+B,LEFT,A".
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Condition.h"
+#include "InputScript.h"
+#include "Search.h"
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+static const struct
+{
+	const char* name;
+	u8 bit;
+} BUTTON_NAMES[] =
+{
+	{ "A", BUTTON_A }, { "B", BUTTON_B }, { "SELECT", BUTTON_SELECT }, { "START", BUTTON_START },
+	{ "UP", BUTTON_UP }, { "DOWN", BUTTON_DOWN }, { "LEFT", BUTTON_LEFT }, { "RIGHT", BUTTON_RIGHT }
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * The --score expression as a SearchScore. Evaluate only reads, so the workers can share it.
+ */
+class ConditionScore : public SearchScore
+{
+public:
+
+	ConditionScore(const Condition& cond) : cond(cond) {}
+	s64 Score(const Bus& bus) override { return cond.Evaluate(bus, 0); }
+
+private:
+
+	const Condition& cond;
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * "none,RIGHT+A,..." into button sets; false with a message on stderr on a name it doesn't know.
+ */
+static bool Parse_Actions(const char* text, std::vector<u8>& actions)
+{
+	std::string list(text);
+	size_t at = 0;
+	while (at <= list.size())
+	{
+		size_t comma = list.find(',', at);
+		std::string action = list.substr(at, comma == std::string::npos ? std::string::npos : comma - at);
+		at = comma == std::string::npos ? list.size() + 1 : comma + 1;
+
+		u8 buttons = 0;
+		size_t from = 0;
+		while (from <= action.size())
+		{
+			size_t plus = action.find('+', from);
+			std::string name = action.substr(from, plus == std::string::npos ? std::string::npos : plus - from);
+			from = plus == std::string::npos ? action.size() + 1 : plus + 1;
+
+			for (char& c : name)
+				c = (char)toupper((unsigned char)c);
+			if (name == "NONE" || name.empty())
+				continue;
+
+			u8 bit = 0;
+			for (const auto& b : BUTTON_NAMES)
+				if (name == b.name)
+					bit = b.bit;
+			if (!bit)
+			{
+				fprintf(stderr, "unknown button %s\n", name.c_str());
+				return false;
+			} // end if
+			buttons |= bit;
+		} // end while
+
+		actions.push_back(buttons);
+	} // end while
+
+	return true;
+} // end Parse_Actions
+
+
+//=========================================================================================================|
+/**
+ * A button set as a script would have it; "" for none.
+ */
+static std::string Button_Names(u8 buttons)
+{
+	std::string s;
+	for (const auto& b : BUTTON_NAMES)
+		if (buttons & b.bit)
+			s += (s.empty() ? "" : " ") + std::string(b.name);
+	return s;
+} // end Button_Names
+
+
+//=========================================================================================================|
+int main(int argc, char** argv)
+{
+	const char* rom = nullptr;
+	const char* script = nullptr;
+	const char* score_text = "[$0086]";
+	const char* action_text = "none,RIGHT,RIGHT+A,RIGHT+B,LEFT,A";
+	const char* out = nullptr;
+	u64 start = 0;
+	u32 threads = 0;
+	SEARCH_CONFIG config = { 8, 8, 64, true };
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--start") && i + 1 < argc)
+			start = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--input") && i + 1 < argc)
+			script = argv[++i];
+		else if (!strcmp(argv[i], "--score") && i + 1 < argc)
+			score_text = argv[++i];
+		else if (!strcmp(argv[i], "--actions") && i + 1 < argc)
+			action_text = argv[++i];
+		else if (!strcmp(argv[i], "--depth") && i + 1 < argc)
+			config.depth = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--step") && i + 1 < argc)
+			config.frames_per_step = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--beam") && i + 1 < argc)
+			config.beam = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--bfs"))
+			config.beam = 0;
+		else if (!strcmp(argv[i], "--no-dedupe"))
+			config.bdedupe = false;
+		else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+			threads = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--out") && i + 1 < argc)
+			out = argv[++i];
+		else if (argv[i][0] != '-' && !rom)
+			rom = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	if (!rom || busage)
+	{
+		fprintf(stderr, "usage: %s rom.nes [--start frames] [--input script.txt] [--score expr] "
+			"[--actions list] [--depth n] [--step frames] [--beam w | --bfs] [--no-dedupe] [--threads n] "
+			"[--out script.txt]\n", argv[0]);
+		return 2;
+	} // end if
+
+	Cartridge cart;
+	if (!cart.Load(rom))
+	{
+		fprintf(stderr, "%s\n", cart.Error().c_str());
+		return 1;
+	} // end if
+
+	InputScript input;
+	if (script && !input.Load(script))
+	{
+		fprintf(stderr, "%s\n", input.Error().c_str());
+		return 1;
+	} // end if
+
+	Condition score;
+	if (!score.Compile(score_text))
+	{
+		fprintf(stderr, "--score: %s\n", score.Error().c_str());
+		return 1;
+	} // end if
+
+	std::vector<u8> actions;
+	if (!Parse_Actions(action_text, actions))
+		return 1;
+
+	// the starting machine
+	std::unique_ptr<Bus> bus(new Bus);
+	cart.Insert(*bus);
+	bus->Reset();
+	bus->apu.Set_Output(false);
+	for (u64 f = 0; f < start; f++)
+	{
+		bus->controller[0] = input.Buttons(f, 0);
+		bus->controller[1] = input.Buttons(f, 1);
+		bus->Run_Frame();
+	} // end for
+
+	std::unique_ptr<MACHINE_STATE> root(new MACHINE_STATE);
+	bus->Save_State(*root);
+	s64 root_score = score.Evaluate(*bus, 0);
+
+	Search search(cart, threads);
+	ConditionScore scorer(score);
+	SEARCH_RESULT result;
+	if (!search.Run(*root, actions, config, scorer, result))
+	{
+		fprintf(stderr, "%s\n", search.Error().c_str());
+		return 1;
+	} // end if
+
+	printf("score %lld at the start, %lld after the best sequence\n", (long long)root_score,
+		(long long)result.score);
+	for (u32 d = 0; d < config.depth; d++)
+		printf("  step %-3u frame %-8llu %s\n", d, (unsigned long long)(start + (u64)d * config.frames_per_step),
+			result.inputs[d] ? Button_Names(result.inputs[d]).c_str() : "(none)");
+
+	// the sequence again, the plain way
+	bus->Load_State(*root);
+	for (u32 d = 0; d < config.depth; d++)
+		for (u32 f = 0; f < config.frames_per_step; f++)
+		{
+			bus->controller[0] = result.inputs[d];
+			bus->controller[1] = 0;
+			bus->Run_Frame();
+		} // end for
+	s64 replayed = score.Evaluate(*bus, 0);
+	printf("replayed from the start: %lld %s\n", (long long)replayed, replayed == result.score ? "ok" : "MISMATCH");
+
+	if (out)
+	{
+		FILE* fp = fopen(out, "w");
+		if (!fp)
+		{
+			fprintf(stderr, "can't write %s\n", out);
+			return 1;
+		} // end if
+
+		fprintf(fp, "# InputSearch %s --score \"%s\"; %lld -> %lld\n", rom, score_text, (long long)root_score,
+			(long long)result.score);
+		for (u64 f = 0; f < start; f++)
+			for (u8 pad = 0; pad < 2; pad++)
+				if (!f || input.Buttons(f, pad) != input.Buttons(f - 1, pad))
+					fprintf(fp, "%llu %u %s\n", (unsigned long long)f, pad + 1,
+						Button_Names(input.Buttons(f, pad)).c_str());
+		fprintf(fp, "%llu 2\n", (unsigned long long)start);
+		for (u32 d = 0; d < config.depth; d++)
+			fprintf(fp, "%llu 1 %s\n", (unsigned long long)(start + (u64)d * config.frames_per_step),
+				Button_Names(result.inputs[d]).c_str());
+		fclose(fp);
+	} // end if
+
+	const SEARCH_STATS& s = search.Stats();
+	double busy = s.clone_seconds + s.frame_seconds + s.score_seconds + s.save_seconds;
+	fprintf(stderr, "%u workers, %llu nodes (%llu duplicates dropped), %llu frames in %.3f s\n",
+		search.Workers(), (unsigned long long)s.nodes, (unsigned long long)s.duplicates,
+		(unsigned long long)s.frames, s.seconds);
+	fprintf(stderr, "  %.0f nodes/s, %.0f frames/s\n", s.nodes / s.seconds, s.frames / s.seconds);
+	fprintf(stderr, "  clone %8.2f us each  %5.1f%%\n", s.clone_seconds * 1e6 / s.clones,
+		100 * s.clone_seconds / busy);
+	fprintf(stderr, "  frame %8.2f us each  %5.1f%%\n", s.frame_seconds * 1e6 / s.frames,
+		100 * s.frame_seconds / busy);
+	fprintf(stderr, "  score %8.2f us each  %5.1f%%\n", s.score_seconds * 1e6 / s.nodes,
+		100 * s.score_seconds / busy);
+	if (s.saves)
+		fprintf(stderr, "  save  %8.2f us each  %5.1f%%\n", s.save_seconds * 1e6 / s.saves,
+			100 * s.save_seconds / busy);
+	fprintf(stderr, "  snapshot pool %llu states, %.1f MB\n", (unsigned long long)s.pool_states,
+		s.pool_states * sizeof(MACHINE_STATE) / 1048576.0);
+
+	return replayed == result.score ? 0 : 1;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
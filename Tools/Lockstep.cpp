@@ -0,0 +1,465 @@
+//=========================================================================================================|
+// Lockstep.cpp
+//	Checks the lockstep engine (Lockstep6502.h) against the scalar core, and times the two.
+//
+//	Every lane gets its own reference machine: a Bus whose cpu is stepped an instruction at a time
+//	alongside the engine. After every step each lane's registers and cycle count have to match its
+//	reference's. Every --check steps, and at the end, so does its memory. The lanes' apu and pad accesses
+//	go to a second machine per lane through a LockstepIo, so those run the same as the reference's.
+//
+//	The workloads are the instruction mixes from Bench6502, a run of random instructions, a random 64K
+//	image, and the rom if one is given. The lanes start from the same code with different data (zero
+//	page, the $0300 table, the stack page and registers, seeded per lane), so their control flow comes
+//	apart and back together the way it does over a batch of starting points. The random run has no
+//	jumps and only branches to the next instruction, so the lanes stay together and every opcode goes
+//	through the vector path on random data. The random image is the hard case: it runs whatever the
+//	bytes say, and the lanes scatter.
+//
+//	--bench times the same workloads: Run on the engine against the scalar core stepped once per lane per
+//	instruction, and the engine again with the vector path off. It prints lane-instructions per second
+//	and how much the engine gained.
+//
+//	Usage:
+//		Lockstep [--lanes n] [--steps n] [--check n] [--seed n] [--rom file.nes] [--bench]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Cartridge.h"
+#include "Lockstep6502.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define MIX_CODE			0x0400		// where the mixes are assembled
+#define MIX_DATA			0x0300
+
+#define OPCODES_CODE		0x8000		// the random instruction run, write protected
+#define OPCODES_COUNT		4000
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+struct WORKLOAD
+{
+	std::string name;
+	std::vector<u8> image;		// 64K; unused for the rom
+	u16 pc;
+	u32 rom_start;				// writes from here up are dropped
+	const Cartridge* pcart;		// the rom, or null
+};
+
+
+/**
+ * A lane's apu and pads: one machine per lane, nothing but its I/O used.
+ */
+class LaneDevices : public LockstepIo
+{
+public:
+
+	LaneDevices(u32 lanes)
+	{
+		for (u32 i = 0; i < lanes; i++)
+			machines.emplace_back(new Bus);
+	} // end Constructor
+
+	u8 Read(u32 lane, u16 addr) override { return machines[lane]->Read(addr); }
+	void Write(u32 lane, u16 addr, u8 data) override { machines[lane]->Write(addr, data); }
+
+	std::vector<std::unique_ptr<Bus>> machines;
+};
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+// Bench6502's mixes; each loops forever
+static const struct { const char* name; std::vector<u8> code; } MIXES[] =
+{
+	// LDX #0 / loop: LDA $0300,X / CLC / ADC #1 / STA $0300,X / INX / BNE loop / JMP $0400
+	{ "inc_array", { 0xA2, 0x00, 0xBD, 0x00, 0x03, 0x18, 0x69, 0x01, 0x9D, 0x00, 0x03,
+		0xE8, 0xD0, 0xF4, 0x4C, 0x00, 0x04 } },
+
+	// LDY #0 / loop: LDA ($10),Y / STA ($12),Y / INY / BNE loop / JMP $0400
+	{ "memcpy", { 0xA0, 0x00, 0xB1, 0x10, 0x91, 0x12, 0xC8, 0xD0, 0xF9, 0x4C, 0x00, 0x04 } },
+
+	// JSR sub / JMP $0400 / sub: LDA #1 / PHA / PLA / RTS
+	{ "calls", { 0x20, 0x06, 0x04, 0x4C, 0x00, 0x04, 0xA9, 0x01, 0x48, 0x68, 0x60 } },
+
+	// see Bench6502
+	{ "game_mix", { 0xA5, 0x20, 0x29, 0x0F, 0xAA, 0xBD, 0x00, 0x03, 0x18, 0x65, 0x21, 0x85, 0x21,
+		0xA5, 0x22, 0xC9, 0x80, 0x90, 0x02, 0xA9, 0x00, 0x85, 0x22, 0xE6, 0x22, 0xA0, 0x04,
+		0xB1, 0x10, 0x49, 0xFF, 0x99, 0x80, 0x03, 0x88, 0x10, 0xF6, 0x06, 0x23, 0x26, 0x24,
+		0x24, 0x25, 0x4C, 0x00, 0x04 } }
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * xorshift64; the lanes' data only has to differ, not be any good.
+ */
+static u64 Next(u64& r)
+{
+	r ^= r << 13;
+	r ^= r >> 7;
+	r ^= r << 17;
+	return r;
+} // end Next
+
+
+//=========================================================================================================|
+/**
+ * Bench6502's base image with a mix at MIX_CODE.
+ */
+static std::vector<u8> Mix_Image(const std::vector<u8>& code)
+{
+	std::vector<u8> image(RAM_SIZE, 0);
+	memset(&image[0x0000], 0x03, 0x100);
+	memset(&image[0x0100], 0x02, 0x100);
+	for (int i = 0; i < 0x100; i++)
+		image[MIX_DATA + i] = (u8)i;
+
+	image[0x10] = 0x00; image[0x11] = 0x03;
+	image[0x12] = 0x00; image[0x13] = 0x05;
+	for (u32 v = 0xFFFA; v < RAM_SIZE; v += 2)
+	{
+		image[v] = MIX_CODE & 0xFF;
+		image[v + 1] = MIX_CODE >> 8;
+	} // end for
+
+	memcpy(&image[MIX_CODE], code.data(), code.size());
+	return image;
+} // end Mix_Image
+
+
+//=========================================================================================================|
+/**
+ * A random run of straight-line instructions at OPCODES_CODE, closed off with a JMP back to the top.
+ *	Branches go to the next instruction either way, so only their cycle counts tell taken from not.
+ */
+static std::vector<u8> Opcodes_Image(u64 r)
+{
+	std::vector<u8> image(RAM_SIZE, 0);
+	for (u8& b : image)
+		b = (u8)Next(r);
+
+	CPU6502 cpu;
+	u32 at = OPCODES_CODE;
+	for (int i = 0; i < OPCODES_COUNT; i++)
+	{
+		OPCODE_INFO info;
+		u8 op;
+		for (;;)
+		{
+			op = (u8)Next(r);
+			cpu.Get_Opcode_Info(op, info);
+			if (strcmp(info.name, "BRK") && strcmp(info.name, "JMP") && strcmp(info.name, "JSR") &&
+				strcmp(info.name, "RTS") && strcmp(info.name, "RTI"))
+				break;
+		} // end for
+
+		image[at++] = op;
+		for (u32 b = 1; b < info.bytes; b++)
+			image[at++] = info.mode == AM_REL ? 0 : (u8)Next(r);
+	} // end for
+
+	image[at++] = 0x4C;
+	image[at++] = OPCODES_CODE & 0xFF;
+	image[at++] = OPCODES_CODE >> 8;
+	return image;
+} // end Opcodes_Image
+
+
+//=========================================================================================================|
+/**
+ * Puts workload w on a machine as lane number lane sees it: same code, its own data and registers.
+ */
+static void Start_Lane(Bus& bus, const WORKLOAD& w, u32 lane, u64 seed)
+{
+	u64 r = (seed + lane + 1) * 0x9E3779B97F4A7C15ull;
+	Next(r);
+
+	CPU_STATE s = {};
+	if (w.pcart)
+	{
+		memset(bus.ram, 0, RAM_SIZE);
+		memset(bus.controller, 0, sizeof(bus.controller));
+		w.pcart->Insert(bus);
+		bus.Reset();
+		bus.cpu6502.Step();			// the reset's own cycles
+		bus.cpu6502.Save_State(s);
+	} // end if
+	else
+	{
+		memcpy(bus.ram, w.image.data(), RAM_SIZE);
+		bus.rom_start = w.rom_start;
+		s.pc = w.pc;
+	} // end else
+
+	// the lane's own data: a rom's whole ram, or a mix's zero page, $0300 table and stack
+	if (w.pcart || w.pc == OPCODES_CODE)
+		for (u32 i = 0; i < 0x0800; i++)
+			bus.ram[i] = (u8)Next(r);
+	else
+		for (u32 i = 0; i < 0x100; i++)
+		{
+			if (i < 0x10 || i > 0x13)		// the mixes' pointers stay put
+				bus.ram[i] = (u8)Next(r);
+			bus.ram[0x0100 + i] = (u8)Next(r);
+			bus.ram[MIX_DATA + i] = (u8)Next(r);
+		} // end for
+
+	s.a = (u8)Next(r);
+	s.x = (u8)Next(r);
+	s.y = (u8)Next(r);
+	s.sp = (u8)Next(r);
+	s.status = (u8)(Next(r) | U);
+	s.cycles = 0;
+	bus.cpu6502.Load_State(s);
+	bus.controller[0] = (u8)Next(r);
+	bus.controller[1] = (u8)Next(r);
+} // end Start_Lane
+
+
+//=========================================================================================================|
+/**
+ * Runs a workload on the engine and on one reference machine per lane, an instruction at a time, and
+ *	compares them. False, with what differed, at the first mismatch.
+ */
+static bool Check(const WORKLOAD& w, u32 lanes, u64 steps, u64 check_every, u64 seed, bool bvector)
+{
+	std::vector<std::unique_ptr<Bus>> refs;
+	LaneDevices devices(lanes);
+	std::unique_ptr<Lockstep6502> engine(new Lockstep6502(lanes));
+	engine->Set_Vector(bvector);
+	engine->Set_Io(&devices);
+
+	std::vector<u64> ticks(lanes, 0);
+	for (u32 l = 0; l < lanes; l++)
+	{
+		refs.emplace_back(new Bus);
+		Start_Lane(*refs[l], w, l, seed);
+		Start_Lane(*devices.machines[l], w, l, seed);
+		engine->Load_Lane(l, *refs[l]);
+	} // end for
+
+	u64 start_cycles[LOCKSTEP_LANES];
+	for (u32 l = 0; l < lanes; l++)
+		start_cycles[l] = engine->Cycles(l);
+
+	for (u64 step = 1; step <= steps; step++)
+	{
+		engine->Run(1);
+		for (u32 l = 0; l < lanes; l++)
+		{
+			Bus& ref = *refs[l];
+			CPU_STATE before, want, got;
+			ref.cpu6502.Save_State(before);
+			ticks[l] += ref.cpu6502.Step();
+			ref.cpu6502.Save_State(want);
+			engine->Get_State(l, got);
+
+			u64 cycles = engine->Cycles(l) - start_cycles[l];
+			if (want.a != got.a || want.x != got.x || want.y != got.y || want.sp != got.sp ||
+				want.status != got.status || want.pc != got.pc || ticks[l] != cycles)
+			{
+				printf("%s: lane %u differs after step %llu, at $%04X (op $%02X)\n", w.name.c_str(), l,
+					(unsigned long long)step, before.pc, ref.ram[before.pc]);
+				printf("  scalar   a=%02X x=%02X y=%02X sp=%02X p=%02X pc=%04X cycles=%llu\n", want.a, want.x,
+					want.y, want.sp, want.status, want.pc, (unsigned long long)ticks[l]);
+				printf("  lockstep a=%02X x=%02X y=%02X sp=%02X p=%02X pc=%04X cycles=%llu\n", got.a, got.x,
+					got.y, got.sp, got.status, got.pc, (unsigned long long)cycles);
+				return false;
+			} // end if
+		} // end for
+
+		if (step % check_every && step != steps)
+			continue;
+
+		for (u32 l = 0; l < lanes; l++)
+			for (u32 addr = 0; addr < refs[l]->rom_start; addr++)
+				if (engine->Peek(l, (u16)addr) != refs[l]->ram[addr])
+				{
+					printf("%s: lane %u memory differs at $%04X by step %llu: scalar %02X, lockstep %02X\n",
+						w.name.c_str(), l, addr, (unsigned long long)step, refs[l]->ram[addr],
+						engine->Peek(l, (u16)addr));
+					return false;
+				} // end if
+	} // end for
+
+	const LOCKSTEP_STATS& st = engine->Stats();
+	u64 total = st.vector_lanes + st.scalar_lanes;
+	printf("%-10s %-6s ok  %10llu lane-instructions, %5.1f%% vector, %4.1f lanes/group, %llu io\n",
+		w.name.c_str(), bvector ? "vector" : "scalar", (unsigned long long)total,
+		total ? 100.0 * st.vector_lanes / total : 0.0, st.groups ? (double)total / st.groups : 0.0,
+		(unsigned long long)st.io_accesses);
+	return true;
+} // end Check
+
+
+//=========================================================================================================|
+/**
+ * Times a workload: the scalar core once per lane, then the engine with and without its vector path.
+ */
+static void Bench(const WORKLOAD& w, u32 lanes, u64 steps, u64 seed)
+{
+	typedef std::chrono::steady_clock CLOCK;
+
+	// the scalar core, lane after lane
+	LaneDevices refs(lanes);
+	for (u32 l = 0; l < lanes; l++)
+		Start_Lane(*refs.machines[l], w, l, seed);
+
+	CLOCK::time_point t0 = CLOCK::now();
+	for (u32 l = 0; l < lanes; l++)
+	{
+		CPU6502& cpu = refs.machines[l]->cpu6502;
+		for (u64 i = 0; i < steps; i++)
+			cpu.Step();
+	} // end for
+	double scalar = std::chrono::duration<double>(CLOCK::now() - t0).count();
+
+	double engine_secs[2] = { 0, 0 };
+	double vector_share = 0;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		LaneDevices devices(lanes);
+		std::unique_ptr<Lockstep6502> engine(new Lockstep6502(lanes));
+		engine->Set_Vector(pass == 0);
+		engine->Set_Io(&devices);
+		for (u32 l = 0; l < lanes; l++)
+		{
+			Start_Lane(*devices.machines[l], w, l, seed);
+			engine->Load_Lane(l, *devices.machines[l]);
+		} // end for
+
+		t0 = CLOCK::now();
+		engine->Run(steps);
+		engine_secs[pass] = std::chrono::duration<double>(CLOCK::now() - t0).count();
+
+		const LOCKSTEP_STATS& st = engine->Stats();
+		if (pass == 0 && st.vector_lanes + st.scalar_lanes)
+			vector_share = 100.0 * st.vector_lanes / (st.vector_lanes + st.scalar_lanes);
+	} // end for
+
+	double n = (double)steps * lanes;
+	printf("%-10s %8.2f %8.2f %8.2f M lane-instr/s   %5.2fx vector, %5.2fx scalar lanes   %5.1f%% vector\n",
+		w.name.c_str(), n / scalar / 1e6, n / engine_secs[0] / 1e6, n / engine_secs[1] / 1e6,
+		scalar / engine_secs[0], scalar / engine_secs[1], vector_share);
+} // end Bench
+
+
+//=========================================================================================================|
+int main(int argc, char** argv)
+{
+	u32 lanes = LOCKSTEP_LANES;
+	u64 steps = 200000;
+	u64 check_every = 1000;
+	u64 seed = 1;
+	const char* rom = nullptr;
+	bool bbench = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--lanes") && i + 1 < argc)
+			lanes = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--steps") && i + 1 < argc)
+			steps = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--check") && i + 1 < argc)
+			check_every = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+			seed = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--rom") && i + 1 < argc)
+			rom = argv[++i];
+		else if (!strcmp(argv[i], "--bench"))
+			bbench = true;
+		else
+		{
+			fprintf(stderr, "usage: %s [--lanes n] [--steps n] [--check n] [--seed n] [--rom file.nes] "
+				"[--bench]\n", argv[0]);
+			return 2;
+		} // end else
+	} // end for
+
+	if (lanes < 1 || lanes > LOCKSTEP_LANES || !steps || !check_every)
+	{
+		fprintf(stderr, "--lanes goes from 1 to %d; --steps and --check need to be at least 1\n", LOCKSTEP_LANES);
+		return 2;
+	} // end if
+
+	std::vector<WORKLOAD> work;
+	for (const auto& m : MIXES)
+		work.push_back({ m.name, Mix_Image(m.code), MIX_CODE, RAM_SIZE, nullptr });
+	work.push_back({ "opcodes", Opcodes_Image(seed * 0x9E3779B97F4A7C15ull + 7), OPCODES_CODE, OPCODES_CODE,
+		nullptr });
+
+	// the random image: any bytes at all, vectors included
+	WORKLOAD random = { "random", std::vector<u8>(RAM_SIZE), 0, RAM_SIZE, nullptr };
+	u64 r = seed * 0x2545F4914F6CDD1Dull + 1;
+	for (u8& b : random.image)
+		b = (u8)Next(r);
+	random.pc = (u16)Next(r);
+	work.push_back(random);
+
+	Cartridge cart;
+	if (rom)
+	{
+		if (!cart.Load(rom))
+		{
+			fprintf(stderr, "%s\n", cart.Error().c_str());
+			return 1;
+		} // end if
+		work.push_back({ "rom", {}, 0, 0, &cart });
+	} // end if
+
+	Lockstep6502 probe(lanes);
+	printf("%u lanes, %s\n", lanes, probe.Vector() ? "AVX2" : "no AVX2: the scalar path only");
+
+	if (bbench)
+	{
+		printf("%-10s %8s %8s %8s\n", "workload", "scalar", "vector", "lanes");
+		for (const WORKLOAD& w : work)
+			Bench(w, lanes, steps, seed);
+		return 0;
+	} // end if
+
+	for (const WORKLOAD& w : work)
+		for (int pass = 0; pass < 2; pass++)
+			if (!Check(w, lanes, steps, check_every, seed, pass == 0))
+				return 1;
+	return 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
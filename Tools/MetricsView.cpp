@@ -0,0 +1,138 @@
+//=========================================================================================================|
+// MetricsView.cpp
+//	Watches the metrics a running emulator publishes in shared memory (Metrics.h) and prints a line every
+//	interval:
+//
+//		frame 4090  fps 4029.5  120.00 MHz  frame p50 0.51 ms p99 0.51 ms  audio 0/0  cpu 0.99 (1.0s user
+//		0.0s sys)  cache n/a
+//
+//	The frame time percentiles come out of the log2 histogram, so they are the upper edge of the bucket the
+//	percentile falls in; good to a factor of two, which is what a dashboard needs to spot a hitch.
+//
+//	Usage:
+//		MetricsView name [--interval ms] [--count n]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "Metrics.h"
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * The frame time below which fraction p of the frames so far came in, in ms; 0 with no frames yet.
+ */
+static double Percentile_Ms(const METRICS_DATA& d, double p)
+{
+	u64 total = 0;
+	for (int i = 0; i < METRICS_BUCKETS; i++)
+		total += d.frame_hist[i];
+	if (!total)
+		return 0;
+
+	u64 need = (u64)(p * total + 0.5);
+	u64 seen = 0;
+	for (int i = 0; i < METRICS_BUCKETS; i++)
+	{
+		seen += d.frame_hist[i];
+		if (seen >= need && seen)
+			return (2ull << i) / 1000.0;
+	} // end for
+
+	return (2ull << (METRICS_BUCKETS - 1)) / 1000.0;
+} // end Percentile_Ms
+
+
+//=========================================================================================================|
+// program entry point
+int main(int argc, char** argv)
+{
+	const char* name = nullptr;
+	long interval_ms = 1000;
+	long count = -1;
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--interval") && i + 1 < argc)
+			interval_ms = strtol(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--count") && i + 1 < argc)
+			count = strtol(argv[++i], nullptr, 0);
+		else if (argv[i][0] != '-' && !name)
+			name = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	if (!name || busage)
+	{
+		fprintf(stderr, "usage: %s name [--interval ms] [--count n]\n", argv[0]);
+		return 2;
+	} // end if
+
+	std::string error;
+	const METRICS_BLOCK* pblock = Metrics::Map(name, error);
+	if (!pblock)
+	{
+		fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	} // end if
+
+	printf("%s: written by pid %u\n", name, pblock->pid);
+	for (long n = 0; count < 0 || n < count; n++)
+	{
+		if (n)
+			std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+		METRICS_DATA d;
+		if (!Metrics::Read(*pblock, d))
+		{
+			printf("(writer too busy to get a clean copy)\n");
+			continue;
+		} // end if
+
+		char cache[32];
+		if (d.cache_lookups)
+			snprintf(cache, sizeof(cache), "%.1f%%", 100.0 * d.cache_hits / d.cache_lookups);
+		else
+			snprintf(cache, sizeof(cache), "n/a");
+
+		printf("frame %llu  fps %.1f  %.2f MHz  frame p50 %.2f ms p99 %.2f ms  audio %u/%u  cpu %.2f "
+			"(%.1fs user %.1fs sys)  cache %s\n", (unsigned long long)d.frame, d.fps, d.mhz,
+			Percentile_Ms(d, 0.50), Percentile_Ms(d, 0.99), d.audio_fill, d.audio_capacity, d.cpu_load,
+			d.cpu_user_seconds, d.cpu_system_seconds, cache);
+		fflush(stdout);
+	} // end for
+
+	Metrics::Unmap(pblock);
+	return 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
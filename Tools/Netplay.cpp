@@ -0,0 +1,241 @@
+//=========================================================================================================|
+// Netplay.cpp
+//	Two rollback sessions (Rollback.h) in one process, one per player, joined by a LoopbackLink with the
+//	given delay and jitter. Player 1 runs pad 0 and player 2 pad 1, both off the same input script. Each
+//	side only has the other's input once the link gets it there, and guesses until then.
+//
+//	Once both have run the frames asked for, and have the other's real input for all of them, the state
+//	each has for that frame is checked against a plain run with both pads straight from the script. Any
+//	difference is a desync and the exit status is 1. Also printed, per side: guesses, rollbacks, the
+//	deepest one and the slowest against one frame's time (16.6 ms). A delay of ROLLBACK_MAX frames or
+//	more makes for rollbacks of the full ROLLBACK_MAX.
+//
+//	--break puts an exec breakpoint on both sides, stopping only when --if's condition holds if one is given
+//	(Condition.h). Every stop, in a re-run frame or a shown one, is carried on from as a debugger would, and
+//	the states still have to match.
+//
+//	Usage:
+//		Netplay rom.nes [--frames n] [--input script.txt] [--delay frames] [--jitter frames] [--seed n]
+//			[--break hexaddr [--if expr]]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "Bus.h"
+#include "Cartridge.h"
+#include "InputScript.h"
+#include "Rollback.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FNV_OFFSET		0xCBF29CE484222325ull
+#define FNV_PRIME		0x100000001B3ull
+
+#define FRAME_MS		(1000 / 60.0988)
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * FNV-1a over len bytes, continuing from h.
+ */
+static u64 Hash(u64 h, const void* data, size_t len)
+{
+	const u8* p = (const u8*)data;
+	for (size_t i = 0; i < len; i++)
+		h = (h ^ p[i]) * FNV_PRIME;
+	return h;
+} // end Hash
+
+
+//=========================================================================================================|
+/**
+ * A hash of the parts of a state two machines in sync have to agree on: memory, clocks and registers.
+ */
+static u64 State_Hash(const MACHINE_STATE& s)
+{
+	const CPU_STATE& c = s.cpu;
+	u8 regs[7] = { c.a, c.x, c.y, c.sp, c.status, (u8)c.pc, (u8)(c.pc >> 8) };
+
+	u64 h = Hash(FNV_OFFSET, s.ram, s.ram_size);
+	h = Hash(h, &s.system_clock, sizeof(s.system_clock));
+	h = Hash(h, &s.frame_count, sizeof(s.frame_count));
+	return Hash(h, regs, sizeof(regs));
+} // end State_Hash
+
+
+//=========================================================================================================|
+/**
+ * One side's numbers.
+ */
+static void Print_Stats(int side, const Rollback& rb)
+{
+	const ROLLBACK_STATS& s = rb.Get_Stats();
+	printf("player %d    %llu frames, %llu stalls, %llu guessed, %llu rollbacks re-running %llu frames\n",
+		side + 1, (unsigned long long)s.frames, (unsigned long long)s.stalls, (unsigned long long)s.predicted,
+		(unsigned long long)s.rollbacks, (unsigned long long)s.resimulated);
+	printf("  worst     rollback of %u frames in %.3f ms; frame with it %.3f ms (%.0f%% of one), "
+		"%llu over\n", s.max_depth, s.max_seconds * 1000, s.max_frame_seconds * 1000,
+		100 * s.max_frame_seconds * 1000 / FRAME_MS, (unsigned long long)s.over_budget);
+} // end Print_Stats
+
+
+//=========================================================================================================|
+int main(int argc, char** argv)
+{
+	const char* rom = nullptr;
+	const char* script = nullptr;
+	u64 frames = 600;
+	u32 delay = 4, jitter = 2, seed = 1;
+	long brk = -1;
+	const char* condition = "";
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+			frames = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--input") && i + 1 < argc)
+			script = argv[++i];
+		else if (!strcmp(argv[i], "--delay") && i + 1 < argc)
+			delay = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--jitter") && i + 1 < argc)
+			jitter = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+			seed = (u32)strtoul(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--break") && i + 1 < argc)
+			brk = strtol(argv[++i], nullptr, 16) & 0xFFFF;
+		else if (!strcmp(argv[i], "--if") && i + 1 < argc)
+			condition = argv[++i];
+		else if (argv[i][0] != '-' && !rom)
+			rom = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	if (!rom || busage || !frames || (*condition && brk < 0))
+	{
+		fprintf(stderr, "usage: %s rom.nes [--frames n] [--input script.txt] [--delay frames] "
+			"[--jitter frames] [--seed n] [--break hexaddr [--if expr]]\n", argv[0]);
+		return 2;
+	} // end if
+
+	Cartridge cart;
+	if (!cart.Load(rom))
+	{
+		fprintf(stderr, "%s\n", cart.Error().c_str());
+		return 1;
+	} // end if
+
+	InputScript input;
+	if (script && !input.Load(script))
+	{
+		fprintf(stderr, "%s\n", input.Error().c_str());
+		return 1;
+	} // end if
+
+	// the buses are big; keep them off the stack
+	std::unique_ptr<Bus> bus[2];
+	for (int side = 0; side < 2; side++)
+	{
+		bus[side].reset(new Bus);
+		cart.Insert(*bus[side]);
+		bus[side]->Reset();
+		if (brk >= 0)
+		{
+			Breakpoints& bps = bus[side]->breakpoints;
+			if (!bps.Set_Condition(bps.Add_Exec((u16)brk), condition))
+			{
+				fprintf(stderr, "%s\n", bps.Error().c_str());
+				return 1;
+			} // end if
+		} // end if
+	} // end for
+
+	LoopbackLink link(delay, jitter, seed);
+	Rollback player1(*bus[0], link.End(0), 0);
+	Rollback player2(*bus[1], link.End(1), 1);
+	Rollback* sides[2] = { &player1, &player2 };
+
+	// each side stops once it has run past the last frame and has all of the other's input for it; it
+	// has sent all its own by then, so the other gets there too
+	bool bdone[2] = { false, false };
+	u64 stops[2] = { 0, 0 };
+	while (!bdone[0] || !bdone[1])
+	{
+		for (int side = 0; side < 2; side++)
+		{
+			Rollback& rb = *sides[side];
+			bdone[side] = rb.Frame() > frames && rb.Confirmed() >= frames;
+			if (bdone[side])
+				continue;
+
+			if (rb.Run_Frame(input.Buttons(rb.Frame(), (u8)side)) == ROLLBACK_STOPPED)
+				stops[side]++;
+		} // end for
+
+		link.Tick();
+	} // end while
+
+	// the same frames the plain way
+	std::unique_ptr<Bus> ref(new Bus);
+	cart.Insert(*ref);
+	ref->Reset();
+	for (u64 f = 0; f < frames; f++)
+	{
+		ref->controller[0] = input.Buttons(f, 0);
+		ref->controller[1] = input.Buttons(f, 1);
+		ref->Run_Frame();
+	} // end for
+
+	std::unique_ptr<MACHINE_STATE> ref_state(new MACHINE_STATE);
+	ref->Save_State(*ref_state);
+	u64 want = State_Hash(*ref_state);
+
+	printf("%s: %llu frames, delay %u + up to %u frames, seed %u\n", rom, (unsigned long long)frames, delay,
+		jitter, seed);
+	bool bsynced = true;
+	for (int side = 0; side < 2; side++)
+	{
+		Print_Stats(side, *sides[side]);
+		if (brk >= 0)
+			printf("  %llu breakpoint stops carried on from\n", (unsigned long long)stops[side]);
+
+		const MACHINE_STATE* s = sides[side]->State_At(frames);
+		u64 got = s ? State_Hash(*s) : 0;
+		printf("  frame %llu state %016llx, %s\n", (unsigned long long)frames, (unsigned long long)got,
+			got == want ? "matches" : "DESYNC");
+		bsynced = bsynced && got == want;
+	} // end for
+	printf("reference   %016llx\n", (unsigned long long)want);
+
+	return bsynced ? 0 : 1;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,756 @@
+//=========================================================================================================|
+// Recompile.cpp
+//	The static recompiler: turns a cartridge's code into C++ ahead of time, a function per basic block,
+//	for a build that runs it through Recompiled (Recompiled.h).
+//
+//	The walk starts at the reset, NMI and IRQ vectors, and at any --entry given. It decodes with the
+//	cpu's own opcode table and follows both ways out of every branch, JMP, JSR and the call's return
+//	point, and BRK to the IRQ vector. It goes no further than an RTS, RTI or JMP (ind), whose targets are
+//	only known at run time, or an unofficial opcode, or anything below the cartridge's rom. Those are left
+//	to the interpreter. A block starts at every place the walk was sent to and runs to the next such
+//	place or the end of the straight line.
+//
+//	The output goes to -o (default stdout) and defines --symbol (default RECOMPILED_MODULE). The module
+//	carries a hash of the rom, so it won't run against another one. The Makefile does all of it:
+//
+//		make bin/Headless-recomp RECOMP_ROM=game.nes
+//
+//	Code only reached through a jump table or a pushed address needs --entry for it to be compiled. The
+//	recompiled Headless counts the instructions the interpreter had to start ("misses"), which says when
+//	that matters.
+//
+//	Usage:
+//		Recompile rom.nes [-o file.cpp] [--symbol name] [--entry hexaddr]...
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Bus.h"
+#include "Cartridge.h"
+#include "Disassembler.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FNV_OFFSET			0xCBF29CE484222325ull
+#define FNV_PRIME			0x100000001B3ull
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// one instruction as the walk and the writer see it
+struct INSN
+{
+	u16 pc;
+	u8 op;
+	u8 lo, hi;					// the operand bytes there are
+	OPCODE_INFO info;
+	u32 next;					// pc after it; can be $10000 off the end
+};
+
+
+// where an instruction's operand is, and so how it gets read and written
+enum WHERE
+{
+	AT_ACC,						// implied: the accumulator
+	AT_IMM,						// a byte of the instruction
+	AT_CONST,					// an address known now
+	AT_ZP,						// an address known at run time that's sure to be in zero page
+	AT_ANY						// an address known at run time, ea
+};
+
+
+struct OPERAND
+{
+	u8 where;					// WHERE
+	u16 addr;					// AT_CONST's address, AT_IMM's byte
+	std::string zp;				// AT_ZP's address expression
+	std::string setup;			// what works out ea and the like
+	std::string cross;			// 1 when the indexing crossed a page; "" when it can't
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * printf onto the end of out.
+ */
+static void Put(std::string& out, const char* fmt, ...)
+{
+	va_list args, copy;
+	va_start(args, fmt);
+	va_copy(copy, args);
+	int len = vsnprintf(nullptr, 0, fmt, copy);
+	va_end(copy);
+
+	size_t at = out.size();
+	out.resize(at + len + 1);
+	vsnprintf(&out[at], len + 1, fmt, args);
+	out.resize(at + len);
+	va_end(args);
+} // end Put
+
+
+//=========================================================================================================|
+/**
+ * True for the instructions that take a cycle more when their indexing crosses a page; the ones whose
+ *	CPU6502 handler returns 1.
+ */
+static bool Pays_For_Cross(const char* name)
+{
+	static const char* NAMES[] = { "ADC", "AND", "CMP", "EOR", "LDA", "LDX", "LDY", "ORA", "SBC" };
+	for (const char* n : NAMES)
+		if (!strcmp(name, n))
+			return true;
+	return false;
+} // end Pays_For_Cross
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Walks a cartridge's code and writes it out as blocks.
+ */
+class Recompiler
+{
+public:
+
+	Recompiler(const Bus& bus);
+
+	void Add_Entry(u16 pc) { Mark(pc); }
+	void Walk();
+	void Write(std::string& out, const char* rom, const char* symbol);
+
+	u32 Blocks() const { return blocks; }
+	u32 Instructions() const { return instructions; }
+	u32 Left_Out() const { return left_out; }
+
+private:
+
+	const Bus& bus;
+	Disassembler dis;			// for the comment over each instruction
+	OPCODE_INFO info[256];
+	std::vector<u8> leader;		// per pc: a block starts here
+	std::vector<u8> walked;		// per pc: decoded by the walk
+	std::vector<u16> work;
+
+	u32 blocks;
+	u32 instructions;
+	u32 left_out;				// places the walk was sent to that can't be compiled
+
+	void Mark(u32 pc);
+	bool Compilable(u32 pc) const;
+	void Decode(u16 pc, INSN& in) const;
+	std::string Const_Read(u16 addr) const;
+	OPERAND Operand(const INSN& in) const;
+	std::string Read(const OPERAND& o) const;
+	std::string Write(const OPERAND& o, const char* value) const;
+	bool Instruction(std::string& out, const INSN& in, u16 start, bool& bloop);
+};
+
+
+//=========================================================================================================|
+/**
+ * Constructor; bus has the cartridge in.
+ */
+Recompiler::Recompiler(const Bus& bus)
+	:bus{ bus }, dis{ bus }, leader(RAM_SIZE), walked(RAM_SIZE), blocks{ 0 }, instructions{ 0 }, left_out{ 0 }
+{
+	for (int op = 0; op < 256; op++)
+		bus.cpu6502.Get_Opcode_Info((u8)op, info[op]);
+
+	Mark(bus.ram[0xFFFC] | bus.ram[0xFFFD] << 8);
+	Mark(bus.ram[0xFFFA] | bus.ram[0xFFFB] << 8);
+	Mark(bus.ram[0xFFFE] | bus.ram[0xFFFF] << 8);
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * A block starts at pc, if it's in the rom; the walk goes there.
+ */
+void Recompiler::Mark(u32 pc)
+{
+	if (pc < bus.rom_start || pc >= RAM_SIZE || leader[pc])
+		return;
+	leader[pc] = 1;
+	work.push_back((u16)pc);
+} // end Mark
+
+
+//=========================================================================================================|
+/**
+ * True when the instruction at pc is an official one lying wholly in the rom.
+ */
+bool Recompiler::Compilable(u32 pc) const
+{
+	if (pc < bus.rom_start || pc >= RAM_SIZE)
+		return false;
+	const OPCODE_INFO& oi = info[bus.ram[pc]];
+	return strcmp(oi.name, "???") && pc + oi.bytes <= RAM_SIZE;
+} // end Compilable
+
+
+//=========================================================================================================|
+/**
+ * The instruction at pc; Compilable has said yes to it.
+ */
+void Recompiler::Decode(u16 pc, INSN& in) const
+{
+	in.pc = pc;
+	in.op = bus.ram[pc];
+	in.info = info[in.op];
+	in.lo = in.info.bytes > 1 ? bus.ram[pc + 1] : 0;
+	in.hi = in.info.bytes > 2 ? bus.ram[pc + 2] : 0;
+	in.next = pc + in.info.bytes;
+} // end Decode
+
+
+//=========================================================================================================|
+/**
+ * Follows the code from every block start, finding more of them, till there are no new ones.
+ */
+void Recompiler::Walk()
+{
+	while (!work.empty())
+	{
+		u32 pc = work.back();
+		work.pop_back();
+
+		while (Compilable(pc))
+		{
+			// somebody else's straight line; meeting it in the middle makes a block start of it
+			if (walked[pc])
+			{
+				Mark(pc);
+				break;
+			} // end if
+			walked[pc] = 1;
+
+			INSN in;
+			Decode((u16)pc, in);
+			const char* name = in.info.name;
+
+			if (in.info.mode == AM_REL)
+			{
+				Mark((u16)(in.next + (int8_t)in.lo));
+				Mark(in.next);
+				break;
+			} // end if
+			if (!strcmp(name, "JMP") && in.info.mode == AM_ABS)
+			{
+				Mark(in.lo | in.hi << 8);
+				break;
+			} // end if
+			if (!strcmp(name, "JSR"))
+			{
+				Mark(in.lo | in.hi << 8);
+				Mark(in.next);
+				break;
+			} // end if
+			if (!strcmp(name, "JMP") || !strcmp(name, "RTS") || !strcmp(name, "RTI") || !strcmp(name, "BRK"))
+				break;
+
+			pc = in.next;
+		} // end while
+	} // end while
+
+	for (u32 pc = bus.rom_start; pc < RAM_SIZE; pc++)
+		left_out += leader[pc] && !Compilable(pc);
+} // end Walk
+
+
+//=========================================================================================================|
+/**
+ * A read of addr known now: a constant from the rom, the bus for a register, the array otherwise.
+ */
+std::string Recompiler::Const_Read(u16 addr) const
+{
+	char buf[64];
+	if (addr >= IO_READ_FIRST && addr <= IO_READ_LAST)
+		snprintf(buf, sizeof(buf), "bus.Read(0x%04X)", addr);
+	else if (addr >= bus.rom_start)
+		snprintf(buf, sizeof(buf), "0x%02X", bus.ram[addr]);
+	else
+		snprintf(buf, sizeof(buf), "bus.ram[0x%04X]", addr);
+	return buf;
+} // end Const_Read
+
+
+//=========================================================================================================|
+/**
+ * Where the instruction's operand is, per addressing mode, the way CPU6502's mode functions work it out.
+ */
+OPERAND Recompiler::Operand(const INSN& in) const
+{
+	OPERAND o;
+	o.where = AT_CONST;
+	o.addr = in.lo | in.hi << 8;
+	u8 t = in.lo;
+
+	switch (in.info.mode)
+	{
+	case AM_IMP:
+		o.where = AT_ACC;
+		break;
+
+	case AM_IMM:
+		o.where = AT_IMM;
+		o.addr = in.lo;
+		break;
+
+	case AM_ZP0:
+		o.addr = in.lo;
+		break;
+
+	case AM_ZPX:
+	case AM_ZPY:
+		o.where = AT_ZP;
+		Put(o.zp, "(u8)(0x%02X + s.%c)", in.lo, in.info.mode == AM_ZPX ? 'x' : 'y');
+		break;
+
+	case AM_ABX:
+	case AM_ABY:
+		o.where = AT_ANY;
+		Put(o.setup, "u16 ea = (u16)(0x%04X + s.%c);", o.addr, in.info.mode == AM_ABX ? 'x' : 'y');
+		Put(o.cross, "((ea >> 8) != 0x%02X)", in.hi);
+		break;
+
+	case AM_IZX:
+		o.where = AT_ANY;
+		Put(o.setup, "u16 ea = bus.ram[(u8)(0x%02X + s.x)] | bus.ram[(u8)(0x%02X + s.x)] << 8;", t,
+			(u8)(t + 1));
+		break;
+
+	case AM_IZY:
+		o.where = AT_ANY;
+		Put(o.setup, "u8 hi = bus.ram[0x%02X]; u16 ea = (u16)(((hi << 8) | bus.ram[0x%02X]) + s.y);",
+			(u8)(t + 1), t);
+		o.cross = "((ea >> 8) != hi)";
+		break;
+	} // end switch
+
+	return o;
+} // end Operand
+
+
+//=========================================================================================================|
+/**
+ * The expression reading the operand, i.e. Fetch.
+ */
+std::string Recompiler::Read(const OPERAND& o) const
+{
+	char buf[64];
+	switch (o.where)
+	{
+	case AT_ACC:
+		return "s.a";
+	case AT_IMM:
+		snprintf(buf, sizeof(buf), "0x%02X", o.addr);
+		return buf;
+	case AT_CONST:
+		return Const_Read(o.addr);
+	case AT_ZP:
+		return "bus.ram[" + o.zp + "]";
+	} // end switch
+
+	return "Recomp_Read(bus, ea)";
+} // end Read
+
+
+//=========================================================================================================|
+/**
+ * The statement writing value back where the operand came from.
+ */
+std::string Recompiler::Write(const OPERAND& o, const char* value) const
+{
+	std::string s;
+	switch (o.where)
+	{
+	case AT_ACC:
+		Put(s, "s.a = %s;", value);
+		break;
+
+	case AT_CONST:
+		if (o.addr >= 0x4000 && o.addr <= 0x4017)
+			Put(s, "bus.Write(0x%04X, %s);", o.addr, value);
+		else if (o.addr < bus.rom_start)
+			Put(s, "bus.ram[0x%04X] = %s;", o.addr, value);
+		else
+			Put(s, "(void)(%s);		// rom", value);
+		break;
+
+	case AT_ZP:
+		Put(s, "bus.ram[%s] = %s;", o.zp.c_str(), value);
+		break;
+
+	default:
+		Put(s, "Recomp_Write(bus, ea, %s);", value);
+		break;
+	} // end switch
+
+	return s;
+} // end Write
+
+
+//=========================================================================================================|
+/**
+ * Writes one instruction of the block starting at start; true when it ends the block. bloop is set when
+ *	it jumps back to start.
+ */
+bool Recompiler::Instruction(std::string& out, const INSN& in, u16 start, bool& bloop)
+{
+	const char* name = in.info.name;
+	OPERAND o = Operand(in);
+	std::string f = Read(o);
+	u16 next = (u16)in.next;
+	bool bend = false;
+
+	// the cycles, with the page crossing penalty where it applies
+	std::string cycles;
+	if (!o.cross.empty() && Pays_For_Cross(name))
+		Put(cycles, "(u8)(%u + %s)", in.info.cycles, o.cross.c_str());
+	else
+		Put(cycles, "%u", in.info.cycles);
+
+	DISASM_LINE line;
+	char text[DISASM_TEXT], bytes[DISASM_TEXT];
+	dis.Decode(in.pc, &bus.ram[in.pc], line);
+	Disassembler::Format(line, text);
+	Disassembler::Format_Bytes(line, bytes);
+	Put(out, "\t// $%04X  %-8s  %s\n\t{\n", in.pc, bytes, text);
+	if (!o.setup.empty())
+		Put(out, "\t\t%s\n", o.setup.c_str());
+
+	std::string tick;
+	Put(tick, "\t\tif (!Recomp_Tick(bus, s, %s, 0x%04X))\n\t\t\treturn false;\n", cycles.c_str(), next);
+
+	// where the block goes once the instruction is done, known now
+	auto Go = [&](u16 to)
+	{
+		if (to == start)
+		{
+			out += "\t\tgoto top;\n";
+			bloop = true;
+		} // end if
+		else
+			Put(out, "\t\ts.pc = 0x%04X;\n\t\treturn true;\n", to);
+	};
+
+	static const struct
+	{
+		const char* name;
+		const char* cond;
+	} BRANCHES[] =
+	{
+		{ "BPL", "!(s.status & N)" }, { "BMI", "s.status & N" }, { "BVC", "!(s.status & V)" },
+		{ "BVS", "s.status & V" }, { "BCC", "!(s.status & C)" }, { "BCS", "s.status & C" },
+		{ "BNE", "!(s.status & Z)" }, { "BEQ", "s.status & Z" }
+	};
+
+	if (in.info.mode == AM_REL)
+	{
+		const char* cond = "";
+		for (const auto& b : BRANCHES)
+			if (!strcmp(name, b.name))
+				cond = b.cond;
+
+		u16 to = (u16)(next + (int8_t)in.lo);
+		u8 taken = in.info.cycles + 1 + ((to & 0xFF00) != (next & 0xFF00));
+		Put(out, "\t\tif (%s)\n\t\t{\n", cond);
+		Put(out, "\t\t\tif (!Recomp_Tick(bus, s, %u, 0x%04X))\n\t\t\t\treturn false;\n", taken, to);
+		std::string go;
+		std::swap(out, go);
+		Go(to);
+		std::swap(out, go);
+		for (size_t at = 0; at < go.size(); at = go.find('\n', at) + 1)
+			out += "\t" + go.substr(at, go.find('\n', at) + 1 - at);
+		out += "\t\t}\n";
+		out += tick;
+		Go(next);
+		bend = true;
+	} // end if branch
+	else if (!strcmp(name, "JMP"))
+	{
+		if (in.info.mode == AM_ABS)
+		{
+			Put(out, "\t\tif (!Recomp_Tick(bus, s, %s, 0x%04X))\n\t\t\treturn false;\n", cycles.c_str(), o.addr);
+			Go(o.addr);
+		} // end if
+		else
+		{
+			// with the page wrap of the real thing
+			u16 ptr = o.addr;
+			u16 hi_at = in.lo == 0xFF ? ptr & 0xFF00 : (u16)(ptr + 1);
+			Put(out, "\t\tu16 to = (u16)(%s << 8 | %s);\n", Const_Read(hi_at).c_str(), Const_Read(ptr).c_str());
+			Put(out, "\t\tif (!Recomp_Tick(bus, s, %s, to))\n\t\t\treturn false;\n", cycles.c_str());
+			out += "\t\ts.pc = to;\n\t\treturn true;\n";
+		} // end else
+		bend = true;
+	} // end else if JMP
+	else if (!strcmp(name, "JSR"))
+	{
+		u16 back = (u16)(in.pc + 2);
+		Put(out, "\t\tbus.ram[0x100 + s.sp--] = 0x%02X;\n\t\tbus.ram[0x100 + s.sp--] = 0x%02X;\n", back >> 8,
+			back & 0xFF);
+		Put(out, "\t\tif (!Recomp_Tick(bus, s, %s, 0x%04X))\n\t\t\treturn false;\n", cycles.c_str(), o.addr);
+		Go(o.addr);
+		bend = true;
+	} // end else if JSR
+	else if (!strcmp(name, "RTS") || !strcmp(name, "RTI"))
+	{
+		if (!strcmp(name, "RTI"))
+			out += "\t\ts.status = bus.ram[0x100 + ++s.sp] & ~(B | U);\n";
+		out += "\t\tu16 to = bus.ram[0x100 + ++s.sp];\n\t\tto |= bus.ram[0x100 + ++s.sp] << 8;\n";
+		if (!strcmp(name, "RTS"))
+			out += "\t\tto++;\n";
+		Put(out, "\t\tif (!Recomp_Tick(bus, s, %s, to))\n\t\t\treturn false;\n", cycles.c_str());
+		out += "\t\ts.pc = to;\n\t\treturn true;\n";
+		bend = true;
+	} // end else if RTS/RTI
+	else if (!strcmp(name, "BRK"))
+	{
+		// past the padding byte, which the IMM mode already stepped over
+		u16 back = (u16)(in.pc + 3);
+		out += "\t\ts.status |= I;\n";
+		Put(out, "\t\tbus.ram[0x100 + s.sp--] = 0x%02X;\n\t\tbus.ram[0x100 + s.sp--] = 0x%02X;\n", back >> 8,
+			back & 0xFF);
+		out += "\t\tbus.ram[0x100 + s.sp--] = s.status | B;\n\t\ts.status &= ~B;\n";
+		Put(out, "\t\tu16 to = (u16)(%s | %s << 8);\n", Const_Read(0xFFFE).c_str(), Const_Read(0xFFFF).c_str());
+		Put(out, "\t\tif (!Recomp_Tick(bus, s, %s, to))\n\t\t\treturn false;\n", cycles.c_str());
+		out += "\t\ts.pc = to;\n\t\treturn true;\n";
+		bend = true;
+	} // end else if BRK
+	else
+	{
+		std::string body;
+		const char* n = name;
+		auto Is = [&](const char* m) { return !strcmp(n, m); };
+		const char* reg = Is("LDA") || Is("STA") || Is("CMP") ? "a" : Is("LDX") || Is("STX") || Is("CPX") ? "x" : "y";
+
+		if (Is("LDA") || Is("LDX") || Is("LDY"))
+			Put(body, "s.%s = %s;\nRecomp_Zn(s.status, s.%s);\n", reg, f.c_str(), reg);
+		else if (Is("STA") || Is("STX") || Is("STY"))
+			body = Write(o, (std::string("s.") + reg).c_str()) + "\n";
+		else if (Is("ADC") || Is("SBC"))
+		{
+			// subtraction is addition of the ones' complement; the carry out is bit 8 of the sum
+			Put(body, Is("ADC") ? "u8 f = %s;\n" : "u8 f = (u8)(%s ^ 0xFF);\n", f.c_str());
+			body += "u16 sum = s.a + f + (s.status & C);\nu8 t = (u8)sum;\n";
+			body += "s.status = (s.status & ~(C | V)) | (sum >> 8) | ((~(s.a ^ f) & (s.a ^ t) & 0x80) ? V : 0);\n";
+			body += "Recomp_Zn(s.status, t);\ns.a = t;\n";
+		} // end else if
+		else if (Is("AND") || Is("ORA") || Is("EOR"))
+			Put(body, "s.a %c= %s;\nRecomp_Zn(s.status, s.a);\n", Is("AND") ? '&' : Is("ORA") ? '|' : '^', f.c_str());
+		else if (Is("ASL") || Is("LSR") || Is("ROL") || Is("ROR"))
+		{
+			Put(body, "u8 f = %s;\n", f.c_str());
+			if (Is("ASL"))
+				body += "u8 t = (u8)(f << 1);\ns.status = (s.status & ~C) | (f >> 7);\n";
+			else if (Is("LSR"))
+				body += "u8 t = f >> 1;\ns.status = (s.status & ~C) | (f & C);\n";
+			else if (Is("ROL"))
+				body += "u8 t = (u8)((f << 1) | (s.status & C));\ns.status = (s.status & ~C) | (f >> 7);\n";
+			else
+				body += "u8 t = (u8)((s.status & C) << 7 | (f >> 1));\ns.status = (s.status & ~C) | (f & C);\n";
+			body += "Recomp_Zn(s.status, t);\n" + Write(o, "t") + "\n";
+		} // end else if
+		else if (Is("BIT"))
+		{
+			Put(body, "u8 f = %s;\n", f.c_str());
+			body += "s.status = (s.status & ~(Z | V | N)) | ((s.a & f) ? 0 : Z) | (f & (N | V));\n";
+		} // end else if
+		else if (Is("CMP") || Is("CPX") || Is("CPY"))
+		{
+			Put(body, "u8 f = %s;\n", f.c_str());
+			Put(body, "s.status = (s.status & ~(C | Z | N)) | (s.%s >= f ? C : 0) | (s.%s == f ? Z : 0) | "
+				"((u8)(s.%s - f) & N);\n", reg, reg, reg);
+		} // end else if
+		else if (Is("INC") || Is("DEC"))
+		{
+			Put(body, "u8 t = (u8)(%s %c 1);\n", f.c_str(), Is("INC") ? '+' : '-');
+			body += Write(o, "t") + "\nRecomp_Zn(s.status, t);\n";
+		} // end else if
+		else if (Is("INX") || Is("INY") || Is("DEX") || Is("DEY"))
+			Put(body, "%ss.%c;\nRecomp_Zn(s.status, s.%c);\n", n[0] == 'I' ? "++" : "--", n[2] | 0x20, n[2] | 0x20);
+		else if (Is("TAX") || Is("TAY") || Is("TXA") || Is("TYA") || Is("TSX"))
+		{
+			char to = n[2] | 0x20;
+			const char* from = n[1] == 'S' ? "sp" : n[1] == 'A' ? "a" : n[1] == 'X' ? "x" : "y";
+			Put(body, "s.%c = s.%s;\nRecomp_Zn(s.status, s.%c);\n", to, from, to);
+		} // end else if
+		else if (Is("TXS"))
+			body = "s.sp = s.x;\n";
+		else if (Is("PHA"))
+			body = "bus.ram[0x100 + s.sp--] = s.a;\n";
+		else if (Is("PHP"))
+			body = "bus.ram[0x100 + s.sp--] = s.status | B | U;\ns.status &= ~(B | U);\n";
+		else if (Is("PLA"))
+			body = "s.a = bus.ram[0x100 + ++s.sp];\nRecomp_Zn(s.status, s.a);\n";
+		else if (Is("PLP"))
+			body = "s.status = bus.ram[0x100 + ++s.sp] | U;\n";
+		else if (Is("CLC") || Is("CLD") || Is("CLI") || Is("CLV"))
+			Put(body, "s.status &= ~%c;\n", n[2]);
+		else if (Is("SEC") || Is("SED") || Is("SEI"))
+			Put(body, "s.status |= %c;\n", n[2]);
+		// NOP: nothing to do
+
+		for (size_t at = 0; at < body.size(); at = body.find('\n', at) + 1)
+			out += "\t\t" + body.substr(at, body.find('\n', at) + 1 - at);
+		out += tick;
+	} // end else
+
+	out += "\t}\n";
+	instructions++;
+	return bend;
+} // end Instruction
+
+
+//=========================================================================================================|
+/**
+ * The whole module as C++ into out; rom names it, symbol is what it's called.
+ */
+void Recompiler::Write(std::string& out, const char* rom, const char* symbol)
+{
+	u64 h = FNV_OFFSET;
+	for (u32 i = bus.rom_start; i < RAM_SIZE; i++)
+		h = (h ^ bus.ram[i]) * FNV_PRIME;
+
+	Put(out, "//=========================================================================================================|\n");
+	Put(out, "// Made by Tools/Recompile from %s; don't edit, make it again.\n", rom);
+	Put(out, "//=========================================================================================================|\n");
+	out += "#include \"Recompiled.h\"\n\n\n";
+
+	std::string entries;
+	for (u32 pc = bus.rom_start; pc < RAM_SIZE; pc++)
+	{
+		if (!leader[pc] || !Compilable(pc))
+			continue;
+
+		std::string body;
+		bool bloop = false;
+		for (u32 at = pc;;)
+		{
+			INSN in;
+			Decode((u16)at, in);
+			if (Instruction(body, in, (u16)pc, bloop))
+				break;
+
+			// on into the next block, or to where the interpreter takes over
+			at = in.next;
+			if (at >= RAM_SIZE || leader[at] || !Compilable(at))
+			{
+				Put(body, "\ts.pc = 0x%04X;\n\treturn true;\n", (u16)at);
+				break;
+			} // end if
+		} // end for
+
+		Put(out, "static bool Block_%04X(Bus& bus, CPU_STATE& s)\n{\n", pc);
+		if (bloop)
+			out += "top:\n";
+		out += body;
+		Put(out, "} // end Block_%04X\n\n\n", pc);
+		Put(entries, "\t{ 0x%04X, Block_%04X },\n", pc, pc);
+		blocks++;
+	} // end for
+
+	Put(out, "static const RECOMP_ENTRY ENTRIES[] =\n{\n%s};\n\n\n", entries.empty() ? "\t{ 0, nullptr },\n" :
+		entries.c_str());
+	Put(out, "extern const RECOMP_MODULE %s;\n", symbol);
+	Put(out, "const RECOMP_MODULE %s =\n{\n\t\"%s\", 0x%X, 0x%016llXull, %u, %u, ENTRIES\n};\n", symbol, rom,
+		bus.rom_start, (unsigned long long)h, instructions, blocks);
+} // end Write
+
+
+//=========================================================================================================|
+int main(int argc, char** argv)
+{
+	const char* rom = nullptr;
+	const char* out_path = nullptr;
+	const char* symbol = "RECOMPILED_MODULE";
+	std::vector<u16> entries;
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-o") && i + 1 < argc)
+			out_path = argv[++i];
+		else if (!strcmp(argv[i], "--symbol") && i + 1 < argc)
+			symbol = argv[++i];
+		else if (!strcmp(argv[i], "--entry") && i + 1 < argc)
+			entries.push_back((u16)strtoul(argv[++i], nullptr, 16));
+		else if (argv[i][0] != '-' && !rom)
+			rom = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	if (!rom || busage)
+	{
+		fprintf(stderr, "usage: %s rom.nes [-o file.cpp] [--symbol name] [--entry hexaddr]...\n", argv[0]);
+		return 2;
+	} // end if
+
+	Cartridge cart;
+	if (!cart.Load(rom))
+	{
+		fprintf(stderr, "%s\n", cart.Error().c_str());
+		return 1;
+	} // end if
+
+	std::unique_ptr<Bus> bus(new Bus);
+	cart.Insert(*bus);
+
+	Recompiler recompiler(*bus);
+	for (u16 pc : entries)
+		recompiler.Add_Entry(pc);
+	recompiler.Walk();
+
+	std::string out;
+	recompiler.Write(out, rom, symbol);
+
+	FILE* fp = out_path ? fopen(out_path, "w") : stdout;
+	if (!fp || fwrite(out.data(), 1, out.size(), fp) != out.size() || (out_path && fclose(fp) != 0))
+	{
+		fprintf(stderr, "can't write %s\n", out_path ? out_path : "stdout");
+		return 1;
+	} // end if
+
+	fprintf(stderr, "%s: %u blocks, %u instructions; %u entry points left to the interpreter\n", rom,
+		recompiler.Blocks(), recompiler.Instructions(), recompiler.Left_Out());
+	return 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,275 @@
+//=========================================================================================================|
+// ResamplerBench.cpp
+//	Throughput benchmark and sanity check for the polyphase resampler.
+//
+//	The benchmark pushes a frame at a time (1/60th of a second of input) through every rate/quality/kernel
+//	combination asked for and reports output samples per second along with what that costs per emulated
+//	frame, which is the number that matters; audio has to stay a rounding error in the 16.6 ms budget.
+//
+//	--verify checks each configuration against the exact answer, worked out analytically rather than by
+//	another resampler; pure sines make that trivial. A tone in the pass band must come out as the same
+//	tone (gain and phase), and a tone above the output nyquist must come out as (nearly) nothing. The
+//	AVX2 kernel is also checked against the scalar one. Exits with 1 if anything is out of tolerance.
+//
+//	Usage:
+//		ResamplerBench [--in rate] [--out 44100|48000|96000] [--quality fast|medium|best]
+//		               [--seconds n] [--verify]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Resampler.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define BENCH_PI			3.14159265358979323846
+#define FRAMES_PER_SECOND	60.0988		// NTSC
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+static const char* QUALITY_NAMES[3] = { "fast", "medium", "best" };
+
+// verify tolerances per tier: pass band gain error (dB), stop band floor (dB), tone error floor (dB)
+static const struct
+{
+	double gain_db;
+	double stop_db;
+	double error_db;
+} TOLERANCE[3] =
+{
+	{ 0.50, -50.0, -40.0 },
+	{ 0.10, -70.0, -60.0 },
+	{ 0.05, -85.0, -75.0 }
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Runs n_in samples of a sine of freq Hz through r; returns the output with the warm up chopped off.
+ */
+static std::vector<float> Run_Tone(Resampler& r, double in_rate, double freq, int n_in, int& skipped)
+{
+	std::vector<float> in(n_in), out((size_t)(n_in / r.Ratio()) + 16);
+	for (int i = 0; i < n_in; i++)
+		in[i] = (float)(0.5 * sin(2 * BENCH_PI * freq * i / in_rate));
+
+	r.Reset();
+	int n = r.Process(in.data(), n_in, out.data(), (int)out.size());
+	out.resize(n);
+
+	// the first half filter length of output is the filter filling up
+	skipped = (int)(r.Taps() / r.Ratio()) + 1;
+	return out;
+} // end Run_Tone
+
+
+//=========================================================================================================|
+/**
+ * Checks one configuration; prints the numbers and returns false when something is out of tolerance.
+ */
+static bool Verify(double in_rate, double out_rate, RESAMPLER_QUALITY q, RESAMPLER_KERNEL k)
+{
+	Resampler r;
+	if (!r.Init(in_rate, out_rate, q, k))
+		return true;		// kernel not available here; nothing to check
+
+	const double nyquist = out_rate / 2;
+	const int n_in = (int)(r.Ratio() * 4096) + r.Taps() * 2;
+	bool bok = true;
+
+	// pass band: gain should be unity and the tone should land where the math says it should
+	double worst_gain = 0, worst_error = -200;
+	const double pass[3] = { 0.05, 0.30, 0.60 };
+	for (double frac : pass)
+	{
+		double freq = nyquist * frac;
+		int skip;
+		std::vector<float> out = Run_Tone(r, in_rate, freq, n_in, skip);
+
+		double sig = 0, err = 0;
+		for (size_t i = skip; i < out.size(); i++)
+		{
+			double expect = 0.5 * sin(2 * BENCH_PI * freq * i * r.Ratio() / in_rate);
+			sig += out[i] * out[i];
+			err += (out[i] - expect) * (out[i] - expect);
+		} // end for
+
+		double gain = 10 * log10(sig / ((out.size() - skip) * 0.125));
+		double error = 10 * log10(err / sig + 1e-30);
+		if (fabs(gain) > fabs(worst_gain)) worst_gain = gain;
+		if (error > worst_error) worst_error = error;
+	} // end for
+
+	// stop band: anything above the output nyquist must be gone, or it folds back as aliasing
+	double worst_stop = -200;
+	const double stop[3] = { 1.15, 1.6, 3.0 };
+	for (double mult : stop)
+	{
+		double freq = nyquist * mult;
+		if (freq >= in_rate / 2)
+			continue;
+
+		int skip;
+		std::vector<float> out = Run_Tone(r, in_rate, freq, n_in, skip);
+
+		double sig = 0;
+		for (size_t i = skip; i < out.size(); i++)
+			sig += out[i] * out[i];
+
+		double level = 10 * log10(sig / ((out.size() - skip) * 0.125) + 1e-30);
+		if (level > worst_stop) worst_stop = level;
+	} // end for
+
+	if (fabs(worst_gain) > TOLERANCE[q].gain_db || worst_stop > TOLERANCE[q].stop_db ||
+		worst_error > TOLERANCE[q].error_db)
+		bok = false;
+
+	printf("  verify %8.0f -> %6.0f %-6s %-6s taps %5d  gain %+6.3f dB  tone err %7.1f dB  alias %7.1f dB  %s\n",
+		in_rate, out_rate, QUALITY_NAMES[q], k == KERNEL_AVX2 ? "avx2" : "scalar", r.Taps(),
+		worst_gain, worst_error, worst_stop, bok ? "ok" : "FAIL");
+
+	// the simd kernel must agree with the scalar one to within float rounding
+	if (k == KERNEL_AVX2)
+	{
+		Resampler ref;
+		ref.Init(in_rate, out_rate, q, KERNEL_SCALAR);
+
+		int skip;
+		std::vector<float> a = Run_Tone(r, in_rate, nyquist * 0.3, n_in, skip);
+		std::vector<float> b = Run_Tone(ref, in_rate, nyquist * 0.3, n_in, skip);
+
+		double max_diff = 0;
+		for (size_t i = 0; i < a.size() && i < b.size(); i++)
+			max_diff = fmax(max_diff, fabs((double)a[i] - b[i]));
+
+		bool bsame = a.size() == b.size() && max_diff < 1e-4;
+		printf("  verify %8.0f -> %6.0f %-6s avx2 vs scalar: max diff %.2e  %s\n",
+			in_rate, out_rate, QUALITY_NAMES[q], max_diff, bsame ? "ok" : "FAIL");
+		bok = bok && bsame;
+	} // end if
+
+	return bok;
+} // end Verify
+
+
+//=========================================================================================================|
+/**
+ * Times one configuration over the given number of seconds of input, fed a frame at a time.
+ */
+static void Bench(double in_rate, double out_rate, RESAMPLER_QUALITY q, RESAMPLER_KERNEL k, double seconds)
+{
+	Resampler r;
+	if (!r.Init(in_rate, out_rate, q, k))
+		return;
+
+	int frame_in = (int)(in_rate / FRAMES_PER_SECOND);
+	int frames = (int)(seconds * FRAMES_PER_SECOND);
+
+	std::vector<float> in(frame_in), out((size_t)(frame_in / r.Ratio()) + 16);
+	for (int i = 0; i < frame_in; i++)
+		in[i] = (float)(0.3 * sin(2 * BENCH_PI * 440.0 * i / in_rate) + 0.1 * sin(2 * BENCH_PI * 3000.0 * i / in_rate));
+
+	u64 produced = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int f = 0; f < frames; f++)
+		produced += r.Process(in.data(), frame_in, out.data(), (int)out.size());
+	double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double per_frame_us = secs / frames * 1e6;
+	printf("  bench  %8.0f -> %6.0f %-6s %-6s taps %5d  %9.2f Msamples/s out  %8.1f us/frame  (%.3f%% of 16.6 ms)\n",
+		in_rate, out_rate, QUALITY_NAMES[q], k == KERNEL_AVX2 ? "avx2" : "scalar", r.Taps(),
+		produced / secs / 1e6, per_frame_us, per_frame_us / 16639.0 * 100);
+} // end Bench
+
+
+//=========================================================================================================|
+// program entry point
+int main(int argc, char** argv)
+{
+	double in_rate = 1789773.0;
+	double seconds = 2.0;
+	bool bverify = false;
+	std::vector<double> outs = { 44100, 48000, 96000 };
+	std::vector<RESAMPLER_QUALITY> qualities = { RESAMPLE_FAST, RESAMPLE_MEDIUM, RESAMPLE_BEST };
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--in") && i + 1 < argc)
+			in_rate = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--out") && i + 1 < argc)
+			outs = { atof(argv[++i]) };
+		else if (!strcmp(argv[i], "--seconds") && i + 1 < argc)
+			seconds = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--verify"))
+			bverify = true;
+		else if (!strcmp(argv[i], "--quality") && i + 1 < argc)
+		{
+			++i;
+			for (int q = 0; q < 3; q++)
+				if (!strcmp(argv[i], QUALITY_NAMES[q]))
+					qualities = { (RESAMPLER_QUALITY)q };
+		} // end else if
+		else
+		{
+			fprintf(stderr, "usage: %s [--in rate] [--out rate] [--quality fast|medium|best] "
+				"[--seconds n] [--verify]\n", argv[0]);
+			return 2;
+		} // end else
+	} // end for
+
+	std::vector<RESAMPLER_KERNEL> kernels = { KERNEL_SCALAR };
+	if (Resampler::Has_AVX2())
+		kernels.push_back(KERNEL_AVX2);
+
+	printf("resampler: input %.0f Hz, avx2 %s\n", in_rate, Resampler::Has_AVX2() ? "yes" : "no");
+
+	bool bok = true;
+	for (double out_rate : outs)
+	{
+		for (RESAMPLER_QUALITY q : qualities)
+		{
+			for (RESAMPLER_KERNEL k : kernels)
+			{
+				if (bverify)
+					bok = Verify(in_rate, out_rate, q, k) && bok;
+				Bench(in_rate, out_rate, q, k, seconds);
+			} // end for kernels
+		} // end for qualities
+	} // end for rates
+
+	return bok ? 0 : 1;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
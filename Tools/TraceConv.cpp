@@ -0,0 +1,150 @@
+//=========================================================================================================|
+// TraceConv.cpp
+//	Turns a binary trace (see Tracer.h) into text laid out like nestest.log, so it can be diffed against
+//	that or any other emulator's log:
+//
+//		C000  4C F5 C5  JMP $C5F5                       A:00 X:00 Y:00 P:24 SP:FD PPU:  0, 21 CYC:7
+//
+//	There is no PPU yet, so the PPU column is worked out from the cycle count the way nestest's own log
+//	runs (three dots a cycle, 341 dots a line, 262 lines). The "= xx" memory annotations nestest adds after
+//	some operands aren't in the trace and are left off.
+//
+//	Usage:
+//		TraceConv in.trace [out.log] [--from n] [--count n]
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "Bus.h"
+#include "Disassembler.h"
+#include "Tracer.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define CONV_CHUNK		65536		// records read at a time
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * One full log line, newline included.
+ */
+static void Write_Line(FILE* out, const Disassembler& dis, const TRACE_RECORD& r)
+{
+	DISASM_LINE line;
+	dis.Decode(r.pc, &r.opcode, line);
+
+	char bytes[16];
+	Disassembler::Format_Bytes(line, bytes);
+
+	char ins[DISASM_TEXT];
+	Disassembler::Format(line, ins);
+
+	unsigned long long cycle = r.cycle_lo | ((unsigned long long)r.cycle_hi << 32);
+	unsigned long long dot = cycle * 3;
+
+	fprintf(out, "%04X  %-8s  %-32sA:%02X X:%02X Y:%02X P:%02X SP:%02X PPU:%3llu,%3llu CYC:%llu\n",
+		r.pc, bytes, ins, r.a, r.x, r.y, r.p, r.sp, (dot / 341) % 262, dot % 341, cycle);
+} // end Write_Line
+
+
+//=========================================================================================================|
+// program entry point
+int main(int argc, char** argv)
+{
+	const char* in_path = nullptr;
+	const char* out_path = nullptr;
+	unsigned long long from = 0, count = ~0ull;
+	bool busage = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--from") && i + 1 < argc)
+			from = strtoull(argv[++i], nullptr, 0);
+		else if (!strcmp(argv[i], "--count") && i + 1 < argc)
+			count = strtoull(argv[++i], nullptr, 0);
+		else if (argv[i][0] != '-' && !in_path)
+			in_path = argv[i];
+		else if (argv[i][0] != '-' && !out_path)
+			out_path = argv[i];
+		else
+			busage = true;
+	} // end for
+
+	if (!in_path || busage)
+	{
+		fprintf(stderr, "usage: %s in.trace [out.log] [--from n] [--count n]\n", argv[0]);
+		return 2;
+	} // end if
+
+	FILE* in = fopen(in_path, "rb");
+	if (!in)
+	{
+		fprintf(stderr, "can't open %s\n", in_path);
+		return 1;
+	} // end if
+
+	TRACE_HEADER h;
+	if (fread(&h, sizeof(h), 1, in) != 1 || memcmp(h.magic, TRACE_MAGIC, sizeof(h.magic)) ||
+		h.record_size != sizeof(TRACE_RECORD))
+	{
+		fprintf(stderr, "%s is not a trace this build understands\n", in_path);
+		fclose(in);
+		return 1;
+	} // end if
+
+	FILE* out = out_path ? fopen(out_path, "w") : stdout;
+	if (!out)
+	{
+		fprintf(stderr, "can't write %s\n", out_path);
+		fclose(in);
+		return 1;
+	} // end if
+
+	if (from)
+		fseek(in, (long)(sizeof(h) + from * sizeof(TRACE_RECORD)), SEEK_SET);
+
+	std::unique_ptr<Bus> bus(new Bus);		// the bus is big; keep it off the stack
+	Disassembler dis(*bus);		// only for its opcode table; the bytes come out of the trace
+	std::vector<TRACE_RECORD> chunk(CONV_CHUNK);
+	size_t n;
+	while (count && (n = fread(chunk.data(), sizeof(TRACE_RECORD), chunk.size(), in)) > 0)
+	{
+		for (size_t i = 0; i < n && count; i++, count--)
+			Write_Line(out, dis, chunk[i]);
+	} // end while
+
+	fclose(in);
+	if (out != stdout)
+		fclose(out);
+	return 0;
+} // end main
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,799 @@
+//=========================================================================================================|
+// APU2A03.cpp
+//	Implementation of the NES APU.
+//
+//	Channels are run in bursts between "interesting" clocks (register accesses, frame counter steps and the
+//	end of a frame). Inside a burst a channel only walks its timer expirations and hands amplitude changes
+//	to the blip buffer; channels that are silent skip the whole burst with a bit of arithmetic.
+//
+//	Mixing uses the linear approximation of the 2A03's non-linear dac, which is what lets us feed plain
+//	deltas per channel into one shared buffer:
+//		pulse_out = 0.00752 * (pulse1 + pulse2)
+//		tnd_out   = 0.00851 * triangle + 0.00494 * noise + 0.00335 * dmc
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstring>
+
+#include "APU2A03.h"
+#include "Bus.h"
+
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+// channel output units on a 16-bit scale; see the mixer formula above
+#define PULSE_UNIT		246
+#define TRIANGLE_UNIT	279
+#define NOISE_UNIT		162
+#define DMC_UNIT		110
+
+// frame counter step clocks (in cpu cycles since the sequencer was reset)
+#define FRAME_PERIOD4	29830
+#define FRAME_PERIOD5	37282
+#define FRAME_IRQ_STEP	3			// the 4th step of the 4-step sequence raises the irq
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+static const u8 LENGTH_TABLE[32] =
+{
+	10, 254, 20,  2, 40,  4, 80,  6, 160,  8, 60, 10, 14, 12, 26, 14,
+	12,  16, 24, 18, 48, 20, 96, 22, 192, 24, 72, 26, 16, 28, 32, 30
+};
+
+static const u8 DUTY_TABLE[4][8] =
+{
+	{ 0, 1, 0, 0, 0, 0, 0, 0 },		// 12.5%
+	{ 0, 1, 1, 0, 0, 0, 0, 0 },		// 25%
+	{ 0, 1, 1, 1, 1, 0, 0, 0 },		// 50%
+	{ 1, 0, 0, 1, 1, 1, 1, 1 }		// 25% negated
+};
+
+static const u8 TRIANGLE_TABLE[32] =
+{
+	15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1,  0,
+	 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15
+};
+
+static const u16 NOISE_PERIODS[16] =
+{
+	4, 8, 16, 32, 64, 96, 128, 160, 202, 254, 380, 508, 762, 1016, 2034, 4068
+};
+
+static const u16 DMC_PERIODS[16] =
+{
+	428, 380, 340, 320, 286, 254, 226, 214, 190, 160, 142, 128, 106, 84, 72, 54
+};
+
+static const u16 FRAME_STEPS[2][5] =
+{
+	{ 7457, 14913, 22371, 29829, 0 },			// 4-step
+	{ 7457, 14913, 22371, 29829, 37281 }		// 5-step
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; sets the default sample rate of 44.1 kHz.
+ */
+APU2A03::APU2A03()
+	:pbus{ nullptr }, boutput{ true }
+{
+	Set_Sample_Rate(44100);
+	Reset();
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+APU2A03::~APU2A03()
+{} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Connects the APU to the bus; the DMC reads its samples through it.
+ */
+void APU2A03::Connect_Bus(Bus* pn)
+{
+	pbus = pn;
+} // end Connect_Bus
+
+
+//=========================================================================================================|
+/**
+ * Sets the host's output rate; 44100 or 48000 are the usual suspects.
+ */
+bool APU2A03::Set_Sample_Rate(long rate)
+{
+	return blip.Set_Rates(APU_CLOCK_RATE, rate);
+} // end Set_Sample_Rate
+
+
+//=========================================================================================================|
+/**
+ * Power up state; all channels silent and the clock back at 0 (the bus resets its clock along with us).
+ */
+void APU2A03::Reset()
+{
+	time_now = frame_start = 0;
+
+	memset(&pulse, 0, sizeof(pulse));
+	memset(&triangle, 0, sizeof(triangle));
+	memset(&noise, 0, sizeof(noise));
+	memset(&dmc, 0, sizeof(dmc));
+
+	pulse[1].bsecond = true;
+	noise.lfsr = 1;
+	noise.period = NOISE_PERIODS[0];
+	dmc.period = DMC_PERIODS[0];
+	dmc.bits_remaining = 8;
+	dmc.bsilence = true;
+
+	bfive_step = birq_inhibit = bframe_irq = false;
+	frame_step = 0;
+	frame_base = 0;
+	frame_next = FRAME_STEPS[0][0];
+
+	blip.Clear();
+} // end Reset
+
+
+//=========================================================================================================|
+/**
+ * Copies the channel and frame counter state out. Samples already in the blip buffer aren't included, so
+ *	a Load_State only lines up with the buffer if nothing was added to it in between; turn the output off
+ *	(Set_Output) for frames that are going to be rolled back.
+ */
+void APU2A03::Save_State(APU_STATE& state) const
+{
+	state.time_now = time_now;
+	state.frame_start = frame_start;
+	state.pulse[0] = pulse[0];
+	state.pulse[1] = pulse[1];
+	state.triangle = triangle;
+	state.noise = noise;
+	state.dmc = dmc;
+	state.bfive_step = bfive_step;
+	state.birq_inhibit = birq_inhibit;
+	state.bframe_irq = bframe_irq;
+	state.frame_step = frame_step;
+	state.frame_base = frame_base;
+	state.frame_next = frame_next;
+} // end Save_State
+
+
+//=========================================================================================================|
+/**
+ * The reverse of Save_State.
+ */
+void APU2A03::Load_State(const APU_STATE& state)
+{
+	time_now = state.time_now;
+	frame_start = state.frame_start;
+	pulse[0] = state.pulse[0];
+	pulse[1] = state.pulse[1];
+	triangle = state.triangle;
+	noise = state.noise;
+	dmc = state.dmc;
+	bfive_step = state.bfive_step;
+	birq_inhibit = state.birq_inhibit;
+	bframe_irq = state.bframe_irq;
+	frame_step = state.frame_step;
+	frame_base = state.frame_base;
+	frame_next = state.frame_next;
+} // end Load_State
+
+
+//=========================================================================================================|
+/**
+ * Handles cpu writes to $4000 - $4017. The channels are caught up first so the change lands at its clock.
+ */
+void APU2A03::Write_Register(u64 time, u16 addr, u8 data)
+{
+	Run_Until(time);
+
+	if (addr < 0x4008)
+	{
+		APU_PULSE& p = pulse[(addr >> 2) & 1];
+		p.regs[addr & 3] = data;
+
+		switch (addr & 3)
+		{
+		case 1: p.bsweep_reload = true; break;
+		case 2: p.period = (p.period & 0x0700) | data; break;
+		case 3:
+			p.period = (p.period & 0x00FF) | ((data & 0x07) << 8);
+			if (p.benabled)
+				p.length = LENGTH_TABLE[data >> 3];
+			p.phase = 0;
+			p.benv_start = true;
+			break;
+		} // end switch
+
+		Update_Pulse_Amp(p);
+	} // end if pulse
+	else if (addr < 0x400C)
+	{
+		triangle.regs[addr & 3] = data;
+		if (addr == 0x400A)
+			triangle.period = (triangle.period & 0x0700) | data;
+		else if (addr == 0x400B)
+		{
+			triangle.period = (triangle.period & 0x00FF) | ((data & 0x07) << 8);
+			if (triangle.benabled)
+				triangle.length = LENGTH_TABLE[data >> 3];
+			triangle.blinear_reload = true;
+		} // end else if
+
+		Update_Triangle_Amp();
+	} // end else if triangle
+	else if (addr < 0x4010)
+	{
+		noise.regs[addr & 3] = data;
+		if (addr == 0x400E)
+			noise.period = NOISE_PERIODS[data & 0x0F];
+		else if (addr == 0x400F)
+		{
+			if (noise.benabled)
+				noise.length = LENGTH_TABLE[data >> 3];
+			noise.benv_start = true;
+		} // end else if
+
+		Update_Noise_Amp();
+	} // end else if noise
+	else if (addr < 0x4014)
+	{
+		dmc.regs[addr & 3] = data;
+		switch (addr & 3)
+		{
+		case 0:
+			dmc.period = DMC_PERIODS[data & 0x0F];
+			if (!(data & 0x80))
+				dmc.birq_flag = false;
+			break;
+
+		case 1:
+			dmc.level = data & 0x7F;
+			Set_Amp(dmc.amp, dmc.level * DMC_UNIT, time_now);
+			break;
+		} // end switch
+	} // end else if dmc
+	else if (addr == 0x4015)
+	{
+		APU_CHANNEL* channels[4] = { &pulse[0], &pulse[1], &triangle, &noise };
+		for (int i = 0; i < 4; i++)
+		{
+			channels[i]->benabled = (data >> i) & 1;
+			if (!channels[i]->benabled)
+				channels[i]->length = 0;
+		} // end for
+
+		dmc.birq_flag = false;
+		if (!(data & 0x10))
+			dmc.bytes_remaining = 0;
+		else if (!dmc.bytes_remaining)
+			Start_DMC_Sample();
+
+		Update_Pulse_Amp(pulse[0]);
+		Update_Pulse_Amp(pulse[1]);
+		Update_Triangle_Amp();
+		Update_Noise_Amp();
+	} // end else if status
+	else if (addr == 0x4017)
+	{
+		bfive_step = (data & 0x80) != 0;
+		birq_inhibit = (data & 0x40) != 0;
+		if (birq_inhibit)
+			bframe_irq = false;
+
+		// the real thing waits 3 or 4 cpu cycles before it resets, close enough
+		frame_base = time_now;
+		frame_step = 0;
+		frame_next = frame_base + FRAME_STEPS[bfive_step][0];
+
+		if (bfive_step)
+		{
+			Clock_Quarter_Frame();
+			Clock_Half_Frame();
+		} // end if
+	} // end else if frame counter
+} // end Write_Register
+
+
+//=========================================================================================================|
+/**
+ * Reads $4015; length counter, dmc and irq status. Reading clears the frame irq flag.
+ */
+u8 APU2A03::Read_Status(u64 time)
+{
+	Run_Until(time);
+
+	u8 status = Peek_Status();
+	bframe_irq = false;
+	return status;
+} // end Read_Status
+
+
+//=========================================================================================================|
+/**
+ * What $4015 reads as right now, as far as the apu has been run; clears nothing.
+ */
+u8 APU2A03::Peek_Status() const
+{
+	u8 status = 0;
+	if (pulse[0].length) status |= 0x01;
+	if (pulse[1].length) status |= 0x02;
+	if (triangle.length) status |= 0x04;
+	if (noise.length) status |= 0x08;
+	if (dmc.bytes_remaining) status |= 0x10;
+	if (bframe_irq) status |= 0x40;
+	if (dmc.birq_flag) status |= 0x80;
+	return status;
+} // end Peek_Status
+
+
+//=========================================================================================================|
+/**
+ * Catches every channel upto time, stopping at each frame counter step on the way.
+ */
+void APU2A03::Run_Until(u64 time)
+{
+	while (time_now < time)
+	{
+		u64 end = time < frame_next ? time : frame_next;
+
+		Run_Pulse(pulse[0], end);
+		Run_Pulse(pulse[1], end);
+		Run_Triangle(end);
+		Run_Noise(end);
+		Run_DMC(end);
+
+		time_now = end;
+		if (time_now == frame_next)
+			Clock_Frame_Counter();
+	} // end while
+} // end Run_Until
+
+
+//=========================================================================================================|
+/**
+ * Returns the earliest clock at which the APU could raise an irq; the bus only needs to catch us up then.
+ *	Being early is harmless (the bus just asks again), being late is not.
+ */
+u64 APU2A03::Next_Irq_Clock() const
+{
+	u64 next = APU_NO_EVENT;
+
+	if (!bfive_step && !birq_inhibit && !bframe_irq)
+		next = frame_base + FRAME_STEPS[0][FRAME_IRQ_STEP];
+
+	// a dmc sample that ends with an irq; step through its bits one at a time
+	if ((dmc.regs[0] & 0xC0) == 0x80 && dmc.bytes_remaining && dmc.timer_next < next)
+		next = dmc.timer_next;
+
+	return next;
+} // end Next_Irq_Clock
+
+
+//=========================================================================================================|
+/**
+ * Ends the audio frame at time; samples upto here become available through Read_Samples.
+ */
+void APU2A03::End_Frame(u64 time)
+{
+	Run_Until(time);
+	if (boutput)
+		blip.End_Frame((u32)(time - frame_start));
+	frame_start = time;
+} // end End_Frame
+
+
+//=========================================================================================================|
+/**
+ * Reads upto max_samples of 16-bit mono PCM produced by the frames ended so far.
+ */
+int APU2A03::Read_Samples(s16* out, int max_samples)
+{
+	return blip.Read_Samples(out, max_samples);
+} // end Read_Samples
+
+
+
+//=========================================================================================================|
+// CHANNELS
+//=========================================================================================================|
+/**
+ * Pulse timer clocks every other cpu cycle, so the sequencer steps every (period + 1) * 2 clocks.
+ */
+void APU2A03::Run_Pulse(APU_PULSE& p, u64 end)
+{
+	if (p.timer_next >= end)
+		return;
+
+	u64 step = ((u64)p.period + 1) * 2;
+	int vol = p.length && p.period >= 8 && Sweep_Target(p) <= 0x7FF ? Envelope_Volume(p) : 0;
+
+	if (!vol)
+	{
+		// silent, keep the phase honest and move along
+		u64 count = (end - p.timer_next + step - 1) / step;
+		p.phase = (u8)((p.phase + count) & 7);
+		p.timer_next += count * step;
+		return;
+	} // end if
+
+	const u8* duty = DUTY_TABLE[p.regs[0] >> 6];
+	for (; p.timer_next < end; p.timer_next += step)
+	{
+		p.phase = (p.phase + 1) & 7;
+		Set_Amp(p.amp, duty[p.phase] ? vol * PULSE_UNIT : 0, p.timer_next);
+	} // end for
+} // end Run_Pulse
+
+
+//=========================================================================================================|
+/**
+ * Triangle timer clocks at the cpu rate; the sequencer only moves while both counters are non-zero. Periods
+ *	below 2 are ultrasonic and the sequencer is left where it is (the usual pop free trick).
+ */
+void APU2A03::Run_Triangle(u64 end)
+{
+	if (triangle.timer_next >= end)
+		return;
+
+	u64 step = (u64)triangle.period + 1;
+	if (!triangle.length || !triangle.linear || triangle.period < 2)
+	{
+		triangle.timer_next += (end - triangle.timer_next + step - 1) / step * step;
+		return;
+	} // end if
+
+	for (; triangle.timer_next < end; triangle.timer_next += step)
+	{
+		triangle.phase = (triangle.phase + 1) & 31;
+		Set_Amp(triangle.amp, TRIANGLE_TABLE[triangle.phase] * TRIANGLE_UNIT, triangle.timer_next);
+	} // end for
+} // end Run_Triangle
+
+
+//=========================================================================================================|
+/**
+ * Noise shifts its LFSR at every timer expiry. When silent the shifts are skipped altogether; nobody can
+ *	tell one stretch of noise from another.
+ */
+void APU2A03::Run_Noise(u64 end)
+{
+	if (noise.timer_next >= end)
+		return;
+
+	u64 step = noise.period;
+	int vol = noise.length ? Envelope_Volume(noise) : 0;
+
+	if (!vol)
+	{
+		noise.timer_next += (end - noise.timer_next + step - 1) / step * step;
+		return;
+	} // end if
+
+	int tap = (noise.regs[2] & 0x80) ? 6 : 1;
+	for (; noise.timer_next < end; noise.timer_next += step)
+	{
+		u16 feedback = (noise.lfsr ^ (noise.lfsr >> tap)) & 1;
+		noise.lfsr = (noise.lfsr >> 1) | (feedback << 14);
+		Set_Amp(noise.amp, (noise.lfsr & 1) ? 0 : vol * NOISE_UNIT, noise.timer_next);
+	} // end for
+} // end Run_Noise
+
+
+//=========================================================================================================|
+/**
+ * The DMC output unit moves the 7-bit level by +/-2 for each bit of the sample, one bit per timer expiry.
+ *	When it has nothing to play the bit counter just spins.
+ */
+void APU2A03::Run_DMC(u64 end)
+{
+	if (dmc.timer_next >= end)
+		return;
+
+	u64 step = dmc.period;
+	if (dmc.bsilence && !dmc.bbuffer_full && !dmc.bytes_remaining)
+	{
+		u64 count = (end - dmc.timer_next + step - 1) / step;
+		dmc.bits_remaining = (u8)(((dmc.bits_remaining - 1 + 8 - count % 8) % 8) + 1);
+		dmc.timer_next += count * step;
+		return;
+	} // end if idle
+
+	for (; dmc.timer_next < end; dmc.timer_next += step)
+	{
+		if (!dmc.bsilence)
+		{
+			if (dmc.shift & 1)
+			{
+				if (dmc.level <= 125)
+					dmc.level += 2;
+			} // end if
+			else if (dmc.level >= 2)
+				dmc.level -= 2;
+
+			dmc.shift >>= 1;
+			Set_Amp(dmc.amp, dmc.level * DMC_UNIT, dmc.timer_next);
+		} // end if
+
+		if (--dmc.bits_remaining == 0)
+		{
+			dmc.bits_remaining = 8;
+			dmc.bsilence = !dmc.bbuffer_full;
+			if (dmc.bbuffer_full)
+			{
+				dmc.shift = dmc.sample_buffer;
+				dmc.bbuffer_full = false;
+				Fetch_DMC_Sample();
+			} // end if
+		} // end if
+	} // end for
+} // end Run_DMC
+
+
+//=========================================================================================================|
+/**
+ * Recomputes what pulse p should be putting out right now and tells the buffer if that changed.
+ */
+void APU2A03::Update_Pulse_Amp(APU_PULSE& p)
+{
+	int vol = 0;
+	if (p.length && p.period >= 8 && Sweep_Target(p) <= 0x7FF && DUTY_TABLE[p.regs[0] >> 6][p.phase])
+		vol = Envelope_Volume(p);
+
+	Set_Amp(p.amp, vol * PULSE_UNIT, time_now);
+} // end Update_Pulse_Amp
+
+
+//=========================================================================================================|
+/**
+ * The triangle never drops to 0 when silenced, it just freezes wherever the sequencer was.
+ */
+void APU2A03::Update_Triangle_Amp()
+{
+	Set_Amp(triangle.amp, TRIANGLE_TABLE[triangle.phase] * TRIANGLE_UNIT, time_now);
+} // end Update_Triangle_Amp
+
+
+//=========================================================================================================|
+/**
+ * Same as Update_Pulse_Amp for noise.
+ */
+void APU2A03::Update_Noise_Amp()
+{
+	int vol = noise.length && !(noise.lfsr & 1) ? Envelope_Volume(noise) : 0;
+	Set_Amp(noise.amp, vol * NOISE_UNIT, time_now);
+} // end Update_Noise_Amp
+
+
+//=========================================================================================================|
+/**
+ * Sets a channel's amplitude, handing the difference to the blip buffer at time.
+ */
+void APU2A03::Set_Amp(int& amp, int new_amp, u64 time)
+{
+	int delta = new_amp - amp;
+	if (delta)
+	{
+		amp = new_amp;
+		if (boutput)
+			blip.Add_Delta((u32)(time - frame_start), delta);
+	} // end if
+} // end Set_Amp
+
+
+
+//=========================================================================================================|
+// FRAME COUNTER
+//=========================================================================================================|
+/**
+ * One step of the frame sequencer; called when the clock reaches frame_next.
+ */
+void APU2A03::Clock_Frame_Counter()
+{
+	if (!bfive_step)
+	{
+		Clock_Quarter_Frame();
+		if (frame_step & 1)
+			Clock_Half_Frame();
+
+		if (frame_step == FRAME_IRQ_STEP && !birq_inhibit)
+			bframe_irq = true;
+
+		if (++frame_step == 4)
+		{
+			frame_step = 0;
+			frame_base += FRAME_PERIOD4;
+		} // end if
+	} // end if 4-step
+	else
+	{
+		// 5-step: Q, QH, Q, -, QH and never an irq
+		if (frame_step != 3)
+			Clock_Quarter_Frame();
+		if (frame_step == 1 || frame_step == 4)
+			Clock_Half_Frame();
+
+		if (++frame_step == 5)
+		{
+			frame_step = 0;
+			frame_base += FRAME_PERIOD5;
+		} // end if
+	} // end else 5-step
+
+	frame_next = frame_base + FRAME_STEPS[bfive_step][frame_step];
+} // end Clock_Frame_Counter
+
+
+//=========================================================================================================|
+/**
+ * Envelopes and the triangle's linear counter.
+ */
+void APU2A03::Clock_Quarter_Frame()
+{
+	APU_CHANNEL* channels[3] = { &pulse[0], &pulse[1], &noise };
+	for (int i = 0; i < 3; i++)
+	{
+		APU_CHANNEL& c = *channels[i];
+		if (c.benv_start)
+		{
+			c.benv_start = false;
+			c.env_volume = 15;
+			c.env_divider = c.regs[0] & 0x0F;
+		} // end if
+		else if (!c.env_divider)
+		{
+			c.env_divider = c.regs[0] & 0x0F;
+			if (c.env_volume)
+				--c.env_volume;
+			else if (c.regs[0] & 0x20)
+				c.env_volume = 15;		// loop
+		} // end else if
+		else
+			--c.env_divider;
+	} // end for
+
+	if (triangle.blinear_reload)
+		triangle.linear = triangle.regs[0] & 0x7F;
+	else if (triangle.linear)
+		--triangle.linear;
+
+	if (!(triangle.regs[0] & 0x80))
+		triangle.blinear_reload = false;
+
+	Update_Pulse_Amp(pulse[0]);
+	Update_Pulse_Amp(pulse[1]);
+	Update_Noise_Amp();
+} // end Clock_Quarter_Frame
+
+
+//=========================================================================================================|
+/**
+ * Length counters and the pulse sweep units.
+ */
+void APU2A03::Clock_Half_Frame()
+{
+	for (int i = 0; i < 2; i++)
+	{
+		APU_PULSE& p = pulse[i];
+		if (p.length && !(p.regs[0] & 0x20))
+			--p.length;
+
+		// sweep: E PPP N SSS
+		u8 sweep = p.regs[1];
+		u16 target = Sweep_Target(p);
+		if (!p.sweep_divider && (sweep & 0x80) && (sweep & 0x07) && p.period >= 8 && target <= 0x7FF)
+			p.period = target;
+
+		if (!p.sweep_divider || p.bsweep_reload)
+		{
+			p.sweep_divider = (sweep >> 4) & 0x07;
+			p.bsweep_reload = false;
+		} // end if
+		else
+			--p.sweep_divider;
+	} // end for pulses
+
+	if (triangle.length && !(triangle.regs[0] & 0x80))
+		--triangle.length;
+
+	if (noise.length && !(noise.regs[0] & 0x20))
+		--noise.length;
+
+	Update_Pulse_Amp(pulse[0]);
+	Update_Pulse_Amp(pulse[1]);
+	Update_Noise_Amp();
+} // end Clock_Half_Frame
+
+
+//=========================================================================================================|
+/**
+ * The period the sweep unit is aiming for; also used for muting, which happens even with the sweep off.
+ */
+u16 APU2A03::Sweep_Target(const APU_PULSE& p) const
+{
+	u16 change = p.period >> (p.regs[1] & 0x07);
+	if (p.regs[1] & 0x08)
+		return p.period - change - (p.bsecond ? 0 : 1);
+	return p.period + change;
+} // end Sweep_Target
+
+
+//=========================================================================================================|
+/**
+ * Constant volume or the envelope's decay level.
+ */
+u8 APU2A03::Envelope_Volume(const APU_CHANNEL& c) const
+{
+	return (c.regs[0] & 0x10) ? (c.regs[0] & 0x0F) : c.env_volume;
+} // end Envelope_Volume
+
+
+//=========================================================================================================|
+/**
+ * (Re)starts the DMC sample from $4012/$4013.
+ */
+void APU2A03::Start_DMC_Sample()
+{
+	dmc.address = 0xC000 | (dmc.regs[2] << 6);
+	dmc.bytes_remaining = (dmc.regs[3] << 4) + 1;
+	Fetch_DMC_Sample();
+} // end Start_DMC_Sample
+
+
+//=========================================================================================================|
+/**
+ * Fills the sample buffer from cpu memory if it's empty. The real DMA steals upto 4 cpu cycles per byte,
+ *	we don't bother stalling the cpu for that.
+ */
+void APU2A03::Fetch_DMC_Sample()
+{
+	if (dmc.bbuffer_full || !dmc.bytes_remaining)
+		return;
+
+	dmc.sample_buffer = pbus ? pbus->Read(dmc.address) : 0;
+	dmc.bbuffer_full = true;
+	dmc.address = dmc.address == 0xFFFF ? 0x8000 : dmc.address + 1;
+
+	if (--dmc.bytes_remaining == 0)
+	{
+		if (dmc.regs[0] & 0x40)
+			Start_DMC_Sample();		// loop; the buffer is full so this won't recurse into another fetch
+		else if (dmc.regs[0] & 0x80)
+			dmc.birq_flag = true;
+	} // end if
+} // end Fetch_DMC_Sample
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,238 @@
+//=========================================================================================================|
+// APU2A03.h
+//	The NES Audio Processing Unit lives inside the same Ricoh 2A03 chip as the CPU. It has 5 channels:
+//		2 x Pulse	: square waves with 4 duty cycles, envelope and a pitch sweep unit
+//		Triangle	: 32-step triangle wave gated by a linear counter
+//		Noise		: 15-bit LFSR with 16 selectable periods
+//		DMC			: delta modulation channel that plays 1-bit samples straight out of CPU memory
+//	and a frame counter that clocks the envelopes, length counters and sweeps at ~240 Hz and can throw an
+//	IRQ at the CPU.
+//
+//	The APU is emulated lazily; nothing happens on the CPU clock tick. Instead every register access and
+//	the end of each frame "catches up" the channels upto the current clock, and each channel only does work
+//	when its output actually changes; those changes are handed to a BlipBuffer at their exact cycle.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef APU2A03_H
+#define APU2A03_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdint>
+#include "BlipBuffer.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define APU_CLOCK_RATE		1789773.0	// NTSC CPU clock in Hz
+#define APU_NO_EVENT		UINT64_MAX	// nothing scheduled
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+
+// forward declare the bus
+class Bus;
+
+
+/**
+ * State common to the pulse, triangle and noise channels; all times are absolute cpu clocks.
+ */
+struct APU_CHANNEL
+{
+	u8 regs[4];				// last values written to the channel's 4 registers
+	u8 length;				// length counter; channel is silent at 0
+	bool benabled;			// enabled through $4015
+
+	u8 env_volume;			// envelope decay level (15 .. 0)
+	u8 env_divider;
+	bool benv_start;
+
+	u16 period;				// timer reload value from the registers
+	u64 timer_next;			// clock at which the timer next expires
+	u8 phase;				// position in the waveform sequence
+	int amp;				// last amplitude handed to the blip buffer
+};
+
+
+/**
+ * Pulse extras; the sweep unit.
+ */
+struct APU_PULSE : APU_CHANNEL
+{
+	u8 sweep_divider;
+	bool bsweep_reload;
+	bool bsecond;			// pulse 2 negates with 2's complement, pulse 1 with 1's
+};
+
+
+/**
+ * Triangle extras; the linear counter.
+ */
+struct APU_TRIANGLE : APU_CHANNEL
+{
+	u8 linear;
+	bool blinear_reload;
+};
+
+
+/**
+ * Noise extras; the shift register.
+ */
+struct APU_NOISE : APU_CHANNEL
+{
+	u16 lfsr;
+};
+
+
+/**
+ * The delta modulation channel is different enough to get its own struct.
+ */
+struct APU_DMC
+{
+	u8 regs[4];
+	bool birq_flag;
+
+	u16 address;			// current sample address
+	u16 bytes_remaining;
+	u8 sample_buffer;
+	bool bbuffer_full;
+
+	u8 shift;				// output unit
+	u8 bits_remaining;
+	bool bsilence;
+	u8 level;				// 7-bit dac
+
+	u16 period;
+	u64 timer_next;
+	int amp;
+};
+
+
+
+/**
+ * Everything Save_State keeps: the channels and the frame counter. The blip buffer's samples aren't part of
+ *	it; see Save_State.
+ */
+struct APU_STATE
+{
+	u64 time_now;
+	u64 frame_start;
+
+	APU_PULSE pulse[2];
+	APU_TRIANGLE triangle;
+	APU_NOISE noise;
+	APU_DMC dmc;
+
+	bool bfive_step;
+	bool birq_inhibit;
+	bool bframe_irq;
+	u8 frame_step;
+	u64 frame_base;
+	u64 frame_next;
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class APU2A03
+{
+public:
+
+	APU2A03();
+	~APU2A03();
+
+	void Connect_Bus(Bus* pn);
+	bool Set_Sample_Rate(long rate);
+	void Set_Rate_Adjust(double ratio) { blip.Set_Ratio_Adjust(ratio); }
+	void Reset();
+
+	void Save_State(APU_STATE& state) const;
+	void Load_State(const APU_STATE& state);
+	void Set_Output(bool benable) { boutput = benable; }
+
+	// cpu side; time is the absolute cpu clock of the access
+	void Write_Register(u64 time, u16 addr, u8 data);
+	u8 Read_Status(u64 time);
+	u8 Peek_Status() const;
+
+	// catches the channels upto time; handles frame counter steps and irqs on the way
+	void Run_Until(u64 time);
+	u64 Next_Irq_Clock() const;
+	bool Irq_Asserted() const { return bframe_irq || dmc.birq_flag; }
+
+	// audio side
+	void End_Frame(u64 time);
+	int Samples_Avail() const { return blip.Samples_Avail(); }
+	int Read_Samples(s16* out, int max_samples);
+
+private:
+
+	Bus* pbus;
+	BlipBuffer blip;
+	bool boutput;			// false while frames are run only to be thrown away; nothing goes to blip
+
+	u64 time_now;			// clock the channels have been run upto
+	u64 frame_start;		// clock at which the current blip frame started
+
+	APU_PULSE pulse[2];
+	APU_TRIANGLE triangle;
+	APU_NOISE noise;
+	APU_DMC dmc;
+
+	// frame counter
+	bool bfive_step;
+	bool birq_inhibit;
+	bool bframe_irq;
+	u8 frame_step;
+	u64 frame_base;			// clock at which the sequencer was last reset/wrapped
+	u64 frame_next;			// clock of the next frame counter step
+
+	void Run_Pulse(APU_PULSE& p, u64 end);
+	void Run_Triangle(u64 end);
+	void Run_Noise(u64 end);
+	void Run_DMC(u64 end);
+
+	void Update_Pulse_Amp(APU_PULSE& p);
+	void Update_Triangle_Amp();
+	void Update_Noise_Amp();
+	void Set_Amp(int& amp, int new_amp, u64 time);
+
+	void Clock_Frame_Counter();
+	void Clock_Quarter_Frame();
+	void Clock_Half_Frame();
+
+	u16 Sweep_Target(const APU_PULSE& p) const;
+	u8 Envelope_Volume(const APU_CHANNEL& c) const;
+	void Start_DMC_Sample();
+	void Fetch_DMC_Sample();
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
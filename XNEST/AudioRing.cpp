@@ -0,0 +1,178 @@
+//=========================================================================================================|
+// AudioRing.cpp
+//	Implementation of the SPSC sample ring and its rate control.
+//
+//	The read and write positions are free running 32-bit counters; the slot is the counter masked by the
+//	(power of two) capacity and the fill level is simply their difference, wrap around and all.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstring>
+
+#include "AudioRing.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FILL_SMOOTHING		0.05		// weight of the newest fill reading
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; the capacity is rounded upto a power of two and the target fill defaults to half of it.
+ */
+AudioRing::AudioRing(u32 capacity_samples)
+	:write_pos{ 0 }, pushed{ 0 }, overrun_samples{ 0 },
+	read_pos{ 0 }, pulled{ 0 }, underruns{ 0 }, underrun_samples{ 0 }, last_sample{ 0 }
+{
+	u32 cap = 2;
+	while (cap < capacity_samples)
+		cap <<= 1;
+
+	samples.assign(cap, 0);
+	mask = cap - 1;
+	target_fill = cap / 2;
+	smoothed_fill = target_fill;
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+AudioRing::~AudioRing()
+{} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Queues upto count samples; whatever doesn't fit is dropped and counted. Returns the number queued.
+ */
+u32 AudioRing::Push(const s16* in, u32 count)
+{
+	u32 w = write_pos.load(std::memory_order_relaxed);
+	u32 r = read_pos.load(std::memory_order_acquire);
+	u32 space = Capacity() - (w - r);
+
+	u32 n = count < space ? count : space;
+	u32 slot = w & mask;
+	u32 first = n < Capacity() - slot ? n : Capacity() - slot;
+
+	memcpy(&samples[slot], in, first * sizeof(s16));
+	memcpy(&samples[0], in + first, (n - first) * sizeof(s16));
+
+	write_pos.store(w + n, std::memory_order_release);
+	pushed.store(pushed.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	if (n < count)
+		overrun_samples.store(overrun_samples.load(std::memory_order_relaxed) + count - n,
+			std::memory_order_relaxed);
+
+	return n;
+} // end Push
+
+
+//=========================================================================================================|
+/**
+ * Hands out exactly count samples. If the ring runs dry the rest is padded with the last sample played (a
+ *	flat line clicks less than a jump to 0) and the underrun is counted. Returns the number of real samples.
+ */
+u32 AudioRing::Pull(s16* out, u32 count)
+{
+	u32 r = read_pos.load(std::memory_order_relaxed);
+	u32 w = write_pos.load(std::memory_order_acquire);
+	u32 avail = w - r;
+
+	u32 n = count < avail ? count : avail;
+	u32 slot = r & mask;
+	u32 first = n < Capacity() - slot ? n : Capacity() - slot;
+
+	memcpy(out, &samples[slot], first * sizeof(s16));
+	memcpy(out + first, &samples[0], (n - first) * sizeof(s16));
+
+	read_pos.store(r + n, std::memory_order_release);
+	pulled.store(pulled.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+
+	if (n)
+		last_sample = out[n - 1];
+
+	if (n < count)
+	{
+		for (u32 i = n; i < count; i++)
+			out[i] = last_sample;
+
+		underruns.store(underruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		underrun_samples.store(underrun_samples.load(std::memory_order_relaxed) + count - n,
+			std::memory_order_relaxed);
+	} // end if short
+
+	return n;
+} // end Pull
+
+
+//=========================================================================================================|
+/**
+ * Called by the producer once per frame; returns the ratio to feed the APU's Set_Rate_Adjust. Running low
+ *	gives a ratio above 1 (make a few more samples per frame), running high gives one below 1.
+ */
+double AudioRing::Rate_Adjust()
+{
+	smoothed_fill += (Fill() - smoothed_fill) * FILL_SMOOTHING;
+
+	double error = ((double)target_fill - smoothed_fill) / (double)target_fill;
+	if (error > 1.0) error = 1.0;
+	else if (error < -1.0) error = -1.0;
+
+	return 1.0 + error * AUDIO_MAX_RATE_ADJUST;
+} // end Rate_Adjust
+
+
+//=========================================================================================================|
+/**
+ * Samples currently queued; exact for either side, a snapshot for anyone else.
+ */
+u32 AudioRing::Fill() const
+{
+	// read position first; it can only trail the write position, so the difference never goes negative
+	u32 r = read_pos.load(std::memory_order_acquire);
+	return write_pos.load(std::memory_order_acquire) - r;
+} // end Fill
+
+
+//=========================================================================================================|
+/**
+ * Copies out the counters.
+ */
+void AudioRing::Get_Stats(AUDIO_RING_STATS& stats) const
+{
+	stats.fill = Fill();
+	stats.capacity = Capacity();
+	stats.pushed = pushed.load(std::memory_order_relaxed);
+	stats.pulled = pulled.load(std::memory_order_relaxed);
+	stats.overrun_samples = overrun_samples.load(std::memory_order_relaxed);
+	stats.underruns = underruns.load(std::memory_order_relaxed);
+	stats.underrun_samples = underrun_samples.load(std::memory_order_relaxed);
+} // end Get_Stats
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,116 @@
+//=========================================================================================================|
+// AudioRing.h
+//	A wait-free single producer/single consumer ring of 16-bit samples sitting between the emulation thread
+//	(which pushes a frame's worth of samples at a time) and the audio callback thread (which pulls whatever
+//	the device asks for). Neither side ever blocks or takes a lock; a full ring drops the newest samples and
+//	an empty ring pads with the last sample, both get counted.
+//
+//	The ring also does the dynamic rate control. Video is locked to the host's refresh (or whatever the frame
+//	pacer decides), audio is locked to the sound card's crystal, and the two never agree exactly. So after
+//	each frame the producer asks Rate_Adjust() for a resampling ratio within +/-0.5% that pushes the fill
+//	level back towards the target; way too small a change to hear, big enough to never drift.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef AUDIORING_H
+#define AUDIORING_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define AUDIO_MAX_RATE_ADJUST	0.005		// +/- 0.5%
+#define AUDIO_CACHE_LINE		64
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef uint8_t u8;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int16_t s16;
+
+
+/**
+ * Counters anyone can read at any time; they are only ever updated by one side each.
+ */
+struct AUDIO_RING_STATS
+{
+	u32 fill;					// samples currently queued
+	u32 capacity;
+	u64 pushed;					// samples accepted from the producer
+	u64 pulled;					// samples handed to the consumer (padding not included)
+	u64 overrun_samples;		// samples dropped because the ring was full
+	u64 underruns;				// pulls that came up short
+	u64 underrun_samples;		// samples padded in for those
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class AudioRing
+{
+public:
+
+	AudioRing(u32 capacity_samples = 8192);
+	~AudioRing();
+
+	// producer side (emulation thread)
+	u32 Push(const s16* samples, u32 count);
+	double Rate_Adjust();
+	void Set_Target_Fill(u32 samples) { target_fill = samples; }
+
+	// consumer side (audio callback thread)
+	u32 Pull(s16* out, u32 count);
+
+	// either side
+	u32 Fill() const;
+	u32 Capacity() const { return mask + 1; }
+	void Get_Stats(AUDIO_RING_STATS& stats) const;
+
+private:
+
+	std::vector<s16> samples;
+	u32 mask;
+	u32 target_fill;
+	double smoothed_fill;		// producer's low-passed view of the fill level
+
+	// each side's index on its own cache line so they don't fight over it
+	alignas(AUDIO_CACHE_LINE) std::atomic<u32> write_pos;
+	std::atomic<u64> pushed;
+	std::atomic<u64> overrun_samples;
+
+	alignas(AUDIO_CACHE_LINE) std::atomic<u32> read_pos;
+	std::atomic<u64> pulled;
+	std::atomic<u64> underruns;
+	std::atomic<u64> underrun_samples;
+	s16 last_sample;
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,216 @@
+//=========================================================================================================|
+// AudioSink.cpp
+//	Implementation of the audio callback thread and the null/wav sinks.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+
+#include "AudioSink.h"
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; the thread doesn't start till Start is called.
+ */
+AudioSink::AudioSink(AudioRing& r, long rate, bool brt, u32 per)
+	:ring(r), sample_rate{ rate }, brealtime{ brt }, period{ per }, block(per), brunning{ false }
+{} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor; derived sinks must call Stop in their own destructor, since Consume is theirs.
+ */
+AudioSink::~AudioSink()
+{
+	Stop();
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Fires up the callback thread.
+ */
+bool AudioSink::Start()
+{
+	if (brunning.exchange(true))
+		return false;
+
+	thread = std::thread(&AudioSink::Callback_Thread, this);
+	return true;
+} // end Start
+
+
+//=========================================================================================================|
+/**
+ * Stops the callback thread. In free-running mode whatever is still queued is drained first.
+ */
+void AudioSink::Stop()
+{
+	if (!brunning.exchange(false))
+		return;
+
+	if (thread.joinable())
+		thread.join();
+} // end Stop
+
+
+//=========================================================================================================|
+/**
+ * The "sound card". Real-time mode wakes every period and always takes a full block, padding included,
+ *	just like a device would; free-running mode takes only what's there.
+ */
+void AudioSink::Callback_Thread()
+{
+	using namespace std::chrono;
+
+	const auto tick = duration_cast<steady_clock::duration>(duration<double>((double)period / sample_rate));
+	auto next = steady_clock::now() + tick;
+
+	while (brunning.load(std::memory_order_relaxed))
+	{
+		if (brealtime)
+		{
+			std::this_thread::sleep_until(next);
+			next += tick;
+
+			ring.Pull(block.data(), period);
+			Consume(block.data(), period);
+		} // end if
+		else
+		{
+			u32 fill = ring.Fill();
+			u32 n = fill < period ? fill : period;
+			if (!n)
+			{
+				std::this_thread::sleep_for(milliseconds(1));
+				continue;
+			} // end if
+
+			ring.Pull(block.data(), n);
+			Consume(block.data(), n);
+		} // end else
+	} // end while
+
+	// leave nothing behind in free-running mode; the producer has stopped by now
+	for (u32 n; !brealtime && (n = ring.Fill()) > 0; )
+	{
+		n = n < period ? n : period;
+		ring.Pull(block.data(), n);
+		Consume(block.data(), n);
+	} // end for
+} // end Callback_Thread
+
+
+
+//=========================================================================================================|
+// WAV SINK
+//=========================================================================================================|
+/**
+ * Constructor
+ */
+WavSink::WavSink(AudioRing& r, long rate, bool brt)
+	:AudioSink(r, rate, brt), fp{ nullptr }, data_bytes{ 0 }
+{} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor; stops the thread before the file goes away.
+ */
+WavSink::~WavSink()
+{
+	Stop();
+	Close();
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Creates the file and writes a placeholder header.
+ */
+bool WavSink::Open(const char* path)
+{
+	Close();
+	if (!(fp = fopen(path, "wb")))
+		return false;
+
+	data_bytes = 0;
+	Write_Header();
+	return true;
+} // end Open
+
+
+//=========================================================================================================|
+/**
+ * Patches the header with the final sizes and closes the file. Stop the sink first.
+ */
+void WavSink::Close()
+{
+	if (!fp)
+		return;
+
+	fseek(fp, 0, SEEK_SET);
+	Write_Header();
+	fclose(fp);
+	fp = nullptr;
+} // end Close
+
+
+//=========================================================================================================|
+/**
+ * Appends the block; wav is little endian and so is every machine we build on.
+ */
+void WavSink::Consume(const s16* samples, u32 count)
+{
+	if (fp)
+		data_bytes += (u32)fwrite(samples, sizeof(s16), count, fp) * sizeof(s16);
+} // end Consume
+
+
+//=========================================================================================================|
+/**
+ * The canonical 44-byte header for 16-bit mono PCM.
+ */
+void WavSink::Write_Header()
+{
+	auto put32 = [this](u32 v) { u8 b[4] = { (u8)v, (u8)(v >> 8), (u8)(v >> 16), (u8)(v >> 24) }; fwrite(b, 1, 4, fp); };
+	auto put16 = [this](u32 v) { u8 b[2] = { (u8)v, (u8)(v >> 8) }; fwrite(b, 1, 2, fp); };
+
+	fwrite("RIFF", 1, 4, fp);
+	put32(36 + data_bytes);
+	fwrite("WAVEfmt ", 1, 8, fp);
+	put32(16);							// fmt chunk size
+	put16(1);							// pcm
+	put16(1);							// mono
+	put32((u32)Sample_Rate());
+	put32((u32)Sample_Rate() * 2);		// byte rate
+	put16(2);							// block align
+	put16(16);							// bits per sample
+	fwrite("data", 1, 4, fp);
+	put32(data_bytes);
+} // end Write_Header
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,128 @@
+//=========================================================================================================|
+// AudioSink.h
+//	The consumer end of the AudioRing. A sink owns the "audio callback" thread; it wakes up once per device
+//	period, pulls exactly that many samples out of the ring and does something with them. Real sound cards
+//	come later, for now there are two sinks that run anywhere (headless Linux boxes included):
+//		NullSink	: throws the samples away; good for measuring the ring and the rate control
+//		WavSink		: writes 16-bit mono PCM to a .wav file
+//
+//	In real-time mode the thread paces itself against the steady clock like a sound card would, so under
+//	and over runs are real. In free-running mode it just drains whatever shows up, which is what you want
+//	when the emulator runs unthrottled and you only care about the file.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef AUDIOSINK_H
+#define AUDIOSINK_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "AudioRing.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define AUDIO_DEFAULT_PERIOD	512			// samples per callback; ~11.6 ms at 44.1 kHz
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class AudioSink
+{
+public:
+
+	AudioSink(AudioRing& ring, long sample_rate, bool brealtime = true, u32 period = AUDIO_DEFAULT_PERIOD);
+	virtual ~AudioSink();
+
+	bool Start();
+	void Stop();
+
+	long Sample_Rate() const { return sample_rate; }
+
+protected:
+
+	// called on the callback thread with every block pulled out of the ring
+	virtual void Consume(const s16* samples, u32 count) = 0;
+
+private:
+
+	AudioRing& ring;
+	long sample_rate;
+	bool brealtime;
+	u32 period;
+
+	std::vector<s16> block;
+	std::thread thread;
+	std::atomic<bool> brunning;
+
+	void Callback_Thread();
+};
+
+
+/**
+ * Listens very carefully and forgets everything.
+ */
+class NullSink : public AudioSink
+{
+public:
+
+	NullSink(AudioRing& ring, long sample_rate, bool brealtime = true)
+		: AudioSink(ring, sample_rate, brealtime) {}
+	~NullSink() { Stop(); }
+
+protected:
+
+	void Consume(const s16*, u32) override {}
+};
+
+
+/**
+ * Writes the stream to a RIFF/WAVE file; the header sizes are patched up on Close.
+ */
+class WavSink : public AudioSink
+{
+public:
+
+	WavSink(AudioRing& ring, long sample_rate, bool brealtime = true);
+	~WavSink();
+
+	bool Open(const char* path);
+	void Close();
+
+protected:
+
+	void Consume(const s16* samples, u32 count) override;
+
+private:
+
+	FILE* fp;
+	u32 data_bytes;
+
+	void Write_Header();
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,260 @@
+//=========================================================================================================|
+// BlipBuffer.cpp
+//	Implementation of the band-limited step buffer.
+//
+//	Each delta is spread over BLIP_WIDTH output samples using a windowed-sinc impulse picked from one of
+//	BLIP_PHASES pre-computed rows (the fractional position of the step). Reading samples integrates the
+//	impulses back into steps, which is what the channels meant in the first place, minus the aliasing.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "BlipBuffer.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define BLIP_PI				3.14159265358979323846
+#define BLIP_CUTOFF			0.90		// fraction of nyquist the kernel passes; the rest is transition band
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+/**
+ * The impulse table shared by all buffers; built once on first use (thread safe since C++11 statics).
+ */
+struct BLIP_KERNEL
+{
+	s16 taps[BLIP_PHASES][BLIP_WIDTH];
+
+	BLIP_KERNEL()
+	{
+		for (int p = 0; p < BLIP_PHASES; p++)
+		{
+			double frac = (double)p / BLIP_PHASES;
+			double ftaps[BLIP_WIDTH];
+			double sum = 0;
+
+			for (int i = 0; i < BLIP_WIDTH; i++)
+			{
+				// distance of this tap from the step, in samples
+				double xs = (i - BLIP_HALF_WIDTH + 1) - frac;
+				double sinc = xs == 0 ? BLIP_CUTOFF : sin(BLIP_PI * BLIP_CUTOFF * xs) / (BLIP_PI * xs);
+
+				// blackman window stretched over the whole kernel
+				double wx = (xs + BLIP_HALF_WIDTH) / BLIP_WIDTH;
+				double window = wx <= 0 || wx >= 1 ? 0 :
+					0.42 - 0.5 * cos(2 * BLIP_PI * wx) + 0.08 * cos(4 * BLIP_PI * wx);
+
+				ftaps[i] = sinc * window;
+				sum += ftaps[i];
+			} // end for taps
+
+			// normalize so the taps add upto exactly 1 << BLIP_KERNEL_BITS, otherwise every step leaves a
+			//	little dc error behind and the integrator wanders off
+			int isum = 0;
+			for (int i = 0; i < BLIP_WIDTH; i++)
+			{
+				taps[p][i] = (s16)lround(ftaps[i] / sum * (1 << BLIP_KERNEL_BITS));
+				isum += taps[p][i];
+			} // end for
+
+			taps[p][BLIP_HALF_WIDTH - 1] += (s16)((1 << BLIP_KERNEL_BITS) - isum);
+		} // end for phases
+	} // end BLIP_KERNEL
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+static const BLIP_KERNEL& Get_Kernel()
+{
+	static const BLIP_KERNEL k;
+	return k;
+} // end Get_Kernel
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; the buffer is useless till Set_Rates is called.
+ */
+BlipBuffer::BlipBuffer()
+	:avail{ 0 }, size{ 0 }, factor{ 0 }, offset{ 0 }, integrator{ 0 },
+	clock_rate{ 0 }, ratio_adjust{ 1.0 }, sample_rate{ 0 }, kernel{ Get_Kernel().taps }
+{} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+BlipBuffer::~BlipBuffer()
+{} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Sets the input clock rate (1789773 Hz for the NTSC 2A03) and the output sample rate. The buffer is sized
+ *	to hold msec_length worth of samples, which must be longer than the longest frame ever ended on it.
+ */
+bool BlipBuffer::Set_Rates(double clock, long rate, int msec_length)
+{
+	if (clock <= 0 || rate <= 0 || msec_length <= 0)
+		return false;
+
+	clock_rate = clock;
+	sample_rate = rate;
+	Update_Factor();
+
+	size = (u32)((u64)rate * msec_length / 1000) + 1;
+	buf.assign(size + BLIP_WIDTH, 0);
+	Clear();
+
+	return true;
+} // end Set_Rates
+
+
+//=========================================================================================================|
+/**
+ * Stretches (ratio > 1) or squeezes (ratio < 1) the output by a small amount without touching the nominal
+ *	rates; the audio output path uses this to keep its ring buffer from under/over running. Takes effect
+ *	from the current frame on; samples already in the buffer are left as they are.
+ */
+void BlipBuffer::Set_Ratio_Adjust(double ratio)
+{
+	if (ratio <= 0)
+		return;
+
+	ratio_adjust = ratio;
+	Update_Factor();
+} // end Set_Ratio_Adjust
+
+
+//=========================================================================================================|
+/**
+ * Recomputes the clock to sample conversion factor.
+ */
+void BlipBuffer::Update_Factor()
+{
+	if (clock_rate > 0)
+		factor = (u64)llround((double)sample_rate * ratio_adjust / clock_rate * ((u64)1 << BLIP_FRAC_BITS));
+} // end Update_Factor
+
+
+//=========================================================================================================|
+/**
+ * Removes all samples and deltas; the next frame starts at sample 0.
+ */
+void BlipBuffer::Clear()
+{
+	avail = 0;
+	offset = 0;
+	integrator = 0;
+	std::fill(buf.begin(), buf.end(), 0);
+} // end Clear
+
+
+//=========================================================================================================|
+/**
+ * Drops an amplitude change of delta at clock_time, which is relative to the start of the current frame.
+ */
+void BlipBuffer::Add_Delta(u32 clock_time, int delta)
+{
+	u64 fixed = offset + (u64)clock_time * factor;
+	u32 index = (u32)(fixed >> BLIP_FRAC_BITS);
+	if (index >= size)
+		return;		// frame ran longer than the buffer; the caller forgot to read us out
+
+	const s16* taps = kernel[(fixed >> (BLIP_FRAC_BITS - BLIP_PHASE_BITS)) & (BLIP_PHASES - 1)];
+	s32* out = &buf[index];
+
+	for (int i = 0; i < BLIP_WIDTH; i++)
+		out[i] += taps[i] * delta;
+} // end Add_Delta
+
+
+//=========================================================================================================|
+/**
+ * Ends the current frame after clock_duration clocks; the samples it covers become available for reading
+ *	and the next frame starts counting from clock 0 again.
+ */
+void BlipBuffer::End_Frame(u32 clock_duration)
+{
+	offset += (u64)clock_duration * factor;
+	avail = (u32)(offset >> BLIP_FRAC_BITS);
+	if (avail > size)
+	{
+		avail = size;
+		offset = (u64)size << BLIP_FRAC_BITS;
+	} // end if overflow
+} // end End_Frame
+
+
+//=========================================================================================================|
+/**
+ * Integrates upto max_samples from the buffer into 16-bit mono PCM and removes them. Returns the number of
+ *	samples written. Only call this between frames, i.e. after End_Frame.
+ */
+int BlipBuffer::Read_Samples(s16* out, int max_samples)
+{
+	int count = max_samples < (int)avail ? max_samples : (int)avail;
+	if (count <= 0)
+		return 0;
+
+	s32 sum = integrator;
+	const s32* in = buf.data();
+
+	for (int i = 0; i < count; i++)
+	{
+		sum += in[i];
+		s32 s = sum >> BLIP_KERNEL_BITS;
+		if (s < -32768) s = -32768;
+		else if (s > 32767) s = 32767;
+		out[i] = (s16)s;
+
+		// leak a little each sample; i.e. a one pole high pass that keeps the output centered
+		sum -= s * (1 << (BLIP_KERNEL_BITS - BLIP_HIGHPASS_SHIFT));
+	} // end for
+
+	integrator = sum;
+
+	// slide whatever is left (including the kernel spill over) down to the start
+	u32 remain = avail + BLIP_WIDTH - count;
+	memmove(&buf[0], &buf[count], remain * sizeof(s32));
+	memset(&buf[remain], 0, count * sizeof(s32));
+
+	avail -= count;
+	offset -= (u64)count << BLIP_FRAC_BITS;
+	return count;
+} // end Read_Samples
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
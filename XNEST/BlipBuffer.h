@@ -0,0 +1,105 @@
+//=========================================================================================================|
+// BlipBuffer.h
+//	A band-limited step (BLEP) synthesis buffer. Sound channels do not produce a sample at every tick of the
+//	1.79 MHz clock, instead they tell the buffer "at clock t my output changed by delta" and the buffer
+//	drops a band-limited step at that exact (fractional) sample position. Turning the buffer into PCM is
+//	then just a running sum over the output samples; so the cost of audio is proportional to the number of
+//	amplitude changes and samples produced, not to the number of emulated clock cycles.
+//
+//	Same idea as blargg's Blip_Buffer (the godfather of NES audio), written from scratch for this emulator.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef BLIPBUFFER_H
+#define BLIPBUFFER_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdint>
+#include <vector>
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define BLIP_PHASE_BITS		5							// 32 sub-sample positions for a step
+#define BLIP_PHASES			(1 << BLIP_PHASE_BITS)
+#define BLIP_HALF_WIDTH		8							// kernel is 16 taps wide
+#define BLIP_WIDTH			(BLIP_HALF_WIDTH * 2)
+#define BLIP_KERNEL_BITS	15							// kernel taps sum upto 1 << 15
+#define BLIP_FRAC_BITS		32							// fixed point fraction of a sample position
+#define BLIP_HIGHPASS_SHIFT	9							// the dc blocker's time constant (~14Hz @ 44.1k)
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef uint64_t u64;
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class BlipBuffer
+{
+public:
+
+	BlipBuffer();
+	~BlipBuffer();
+
+	bool Set_Rates(double clock_rate, long sample_rate, int msec_length = 100);
+	void Set_Ratio_Adjust(double ratio);
+	void Clear();
+
+	void Add_Delta(u32 clock_time, int delta);
+	void End_Frame(u32 clock_duration);
+
+	int Samples_Avail() const { return (int)avail; }
+	int Read_Samples(s16* out, int max_samples);
+
+	long Sample_Rate() const { return sample_rate; }
+	double Clock_Rate() const { return clock_rate; }
+
+private:
+
+	std::vector<s32> buf;		// the deltas pending integration plus kernel spill over
+	u32 avail;					// number of samples ready to be read
+	u32 size;					// capacity in samples (not counting the kernel spill over)
+
+	u64 factor;					// output samples per input clock in BLIP_FRAC_BITS fixed point
+	u64 offset;					// position of clock 0 of the current frame; fixed point
+	s32 integrator;				// running sum of the steps; scaled by BLIP_KERNEL_BITS
+
+	double clock_rate;
+	double ratio_adjust;		// dynamic rate control nudge; 1.0 is nominal
+	long sample_rate;
+
+	const s16 (*kernel)[BLIP_WIDTH];	// shared band-limited impulse table; one row per phase
+
+	void Update_Factor();
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
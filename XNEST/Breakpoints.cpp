@@ -0,0 +1,377 @@
+//=========================================================================================================|
+// Breakpoints.cpp
+//	The breakpoint list and its address maps; see Breakpoints.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstring>
+#include <string>
+
+#include "Breakpoints.h"
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; nothing armed.
+ */
+Breakpoints::Breakpoints()
+	:pbus{ nullptr }, missed_hits{ 0 }, next_id{ 1 }, barmed{ false }
+{
+	hits.reserve(BREAK_MAX_HITS);
+	memset(map, 0, sizeof(map));
+	memset(access, 0, sizeof(access));
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+Breakpoints::~Breakpoints()
+{
+
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * The bus whose cpu and clock the breakpoints look at, and which gets stopped. Works out what each opcode
+ *	does with its operand from the cpu's table while at it.
+ */
+void Breakpoints::Connect_Bus(Bus* pn)
+{
+	pbus = pn;
+
+	for (int op = 0; op < 256; op++)
+	{
+		OPCODE_INFO info;
+		pbus->cpu6502.Get_Opcode_Info((u8)op, info);
+
+		access[op] = 0;
+		if (info.mode == AM_IMP || info.mode == AM_IMM || info.mode == AM_REL || info.mode == AM_IND)
+			continue;
+
+		std::string name = info.name;
+		if (name == "JMP" || name == "JSR" || name == "NOP" || name == "???")
+			continue;
+		else if (name == "STA" || name == "STX" || name == "STY")
+			access[op] = 1 << BREAK_WRITE;
+		else if (name == "ASL" || name == "LSR" || name == "ROL" || name == "ROR" || name == "INC" || name == "DEC")
+			access[op] = (1 << BREAK_READ) | (1 << BREAK_WRITE);
+		else
+			access[op] = 1 << BREAK_READ;
+	} // end for
+} // end Connect_Bus
+
+
+//=========================================================================================================|
+/**
+ * Arms a new breakpoint; returns its id. Ranges given backwards are swapped round and kinds out of range
+ *	are refused with -1.
+ */
+int Breakpoints::Add(const BREAKPOINT& bp)
+{
+	if (bp.kind >= BREAK_KINDS)
+		return -1;
+
+	ENTRY e = { next_id++, bp, true, 0, Condition() };
+	if (e.bp.lo > e.bp.hi)
+	{
+		e.bp.lo = bp.hi;
+		e.bp.hi = bp.lo;
+	} // end if
+
+	entries.push_back(e);
+	Rebuild();
+	return e.id;
+} // end Add
+
+
+//=========================================================================================================|
+/**
+ * Stop when the cpu gets to pc, letting the first skip visits go.
+ */
+int Breakpoints::Add_Exec(u16 pc, u64 skip)
+{
+	BREAKPOINT bp = { BREAK_EXEC, pc, pc, BREAK_ALWAYS, BREAK_EQ, 0, skip, false };
+	return Add(bp);
+} // end Add_Exec
+
+
+//=========================================================================================================|
+/**
+ * Stop on any read or write (kind) to lo..hi.
+ */
+int Breakpoints::Add_Watch(u8 kind, u16 lo, u16 hi)
+{
+	BREAKPOINT bp = { kind, lo, hi, BREAK_ALWAYS, BREAK_EQ, 0, 0, false };
+	return Add(bp);
+} // end Add_Watch
+
+
+//=========================================================================================================|
+/**
+ * Takes breakpoint id out; false when there's no such thing.
+ */
+bool Breakpoints::Remove(int id)
+{
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		if (entries[i].id == id)
+		{
+			entries.erase(entries.begin() + i);
+			Rebuild();
+			return true;
+		} // end if
+	} // end for
+
+	return false;
+} // end Remove
+
+
+//=========================================================================================================|
+/**
+ * Disarms (or re-arms) breakpoint id without forgetting it or its hit count.
+ */
+bool Breakpoints::Enable(int id, bool benable)
+{
+	for (ENTRY& e : entries)
+	{
+		if (e.id == id)
+		{
+			e.benabled = benable;
+			Rebuild();
+			return true;
+		} // end if
+	} // end for
+
+	return false;
+} // end Enable
+
+
+//=========================================================================================================|
+/**
+ * Gives breakpoint id an expression that has to come out non zero for it to count a hit, on top of its
+ *	reg/cmp/value test. An empty (or null) expr takes it off again. False with Error() set when id is
+ *	unknown or expr doesn't compile; the breakpoint keeps the condition it had.
+ */
+bool Breakpoints::Set_Condition(int id, const char* expr)
+{
+	for (ENTRY& e : entries)
+	{
+		if (e.id != id)
+			continue;
+
+		if (!expr || !*expr)
+		{
+			e.condition.Clear();
+			return true;
+		} // end if
+
+		Condition c;
+		if (!c.Compile(expr))
+		{
+			error = c.Error();
+			return false;
+		} // end if
+
+		e.condition = c;
+		return true;
+	} // end for
+
+	error = "no breakpoint #" + std::to_string(id);
+	return false;
+} // end Set_Condition
+
+
+//=========================================================================================================|
+/**
+ * Removes every breakpoint; hits already recorded stay.
+ */
+void Breakpoints::Clear()
+{
+	entries.clear();
+	Rebuild();
+} // end Clear
+
+
+//=========================================================================================================|
+/**
+ * Hit count of breakpoint id.
+ */
+u64 Breakpoints::Hit_Count(int id) const
+{
+	for (const ENTRY& e : entries)
+		if (e.id == id)
+			return e.hits;
+	return 0;
+} // end Hit_Count
+
+
+//=========================================================================================================|
+/**
+ * The instruction opcode at op_pc has just run, its operand at addr (fetched being what it read there), and
+ *	the cpu's pc is on the next one. Stops the run once the instruction's cycles_left have gone by, when
+ *	the next pc has an exec breakpoint or the operand a watchpoint that fires.
+ */
+void Breakpoints::Instruction(const CPU6502& cpu, u16 op_pc, u8 opcode, u16 addr, u8 fetched, u8 cycles_left)
+{
+	bool bstop = false;
+	u64 at = pbus->system_clock + cycles_left;
+	u16 pc = cpu.Pc();
+	if (Mapped(BREAK_EXEC, pc))
+		bstop = Check(BREAK_EXEC, pc, 0, pc, at);
+
+	u8 acc = access[opcode];
+	if ((acc & (1 << BREAK_READ)) && Mapped(BREAK_READ, addr))
+		bstop = Check(BREAK_READ, addr, fetched, op_pc, at) || bstop;
+
+	if ((acc & (1 << BREAK_WRITE)) && Mapped(BREAK_WRITE, addr))
+	{
+		// ram has what was stored, unless it went to rom or a register; the stores then say it themselves
+		u8 data = pbus->Peek(addr);
+		if (acc == (1 << BREAK_WRITE))
+			data = (opcode & 0x03) == 0x01 ? cpu.A() : (opcode & 0x03) == 0x02 ? cpu.X() : cpu.Y();
+		bstop = Check(BREAK_WRITE, addr, data, op_pc, at) || bstop;
+	} // end if
+
+	if (bstop)
+		pbus->Stop(at);
+} // end Instruction
+
+
+//=========================================================================================================|
+/**
+ * The cpu has taken an interrupt and will run the handler at its pc once cycles_left have gone by; only
+ *	exec breakpoints apply.
+ */
+void Breakpoints::Exec(const CPU6502& cpu, u8 cycles_left)
+{
+	u16 pc = cpu.Pc();
+	u64 at = pbus->system_clock + cycles_left;
+	if (Mapped(BREAK_EXEC, pc) && Check(BREAK_EXEC, pc, 0, pc, at))
+		pbus->Stop(at);
+} // end Exec
+
+
+//=========================================================================================================|
+/**
+ * Something of kind is set on addr, so see which breakpoints cover it and whether any of them pass their
+ *	condition and hit count; at is the clock the run would stop on. Every one that does is recorded, not just the first, so overlapping
+ *	breakpoints all see their hits counted.
+ */
+bool Breakpoints::Check(u8 kind, u16 addr, u8 data, u16 pc, u64 at)
+{
+	const CPU6502& cpu = pbus->cpu6502;
+	bool bstop = false;
+	bool bremoved = false;
+
+	for (size_t i = 0; i < entries.size(); )
+	{
+		ENTRY& e = entries[i];
+		if (!e.benabled || e.bp.kind != kind || addr < e.bp.lo || addr > e.bp.hi)
+		{
+			i++;
+			continue;
+		} // end if
+
+		u16 v = 0;
+		switch (e.bp.reg)
+		{
+		case BREAK_A: v = cpu.A(); break;
+		case BREAK_X: v = cpu.X(); break;
+		case BREAK_Y: v = cpu.Y(); break;
+		case BREAK_SP: v = cpu.Sp(); break;
+		case BREAK_P: v = cpu.Status(); break;
+		case BREAK_PC: v = pc; break;
+		case BREAK_DATA: v = data; break;
+		} // end switch
+
+		bool bpass = true;
+		if (e.bp.reg != BREAK_ALWAYS)
+		{
+			switch (e.bp.cmp)
+			{
+			case BREAK_EQ: bpass = v == e.bp.value; break;
+			case BREAK_NE: bpass = v != e.bp.value; break;
+			case BREAK_LT: bpass = v < e.bp.value; break;
+			case BREAK_LE: bpass = v <= e.bp.value; break;
+			case BREAK_GT: bpass = v > e.bp.value; break;
+			case BREAK_GE: bpass = v >= e.bp.value; break;
+			case BREAK_ANY_BITS: bpass = (v & e.bp.value) != 0; break;
+			default: bpass = false;
+			} // end switch
+		} // end if
+
+		if (bpass && !e.condition.Empty())
+			bpass = e.condition.Test(*pbus, data);
+
+		if (!bpass || ++e.hits <= e.bp.skip)
+		{
+			i++;
+			continue;
+		} // end if
+
+		if (hits.size() < BREAK_MAX_HITS)
+			hits.push_back({ e.id, kind, addr, data, pc, at });
+		else
+			missed_hits++;
+		bstop = true;
+
+		if (e.bp.btemporary)
+		{
+			entries.erase(entries.begin() + i);
+			bremoved = true;
+		} // end if
+		else
+			i++;
+	} // end for
+
+	if (bremoved)
+		Rebuild();
+	return bstop;
+} // end Check
+
+
+//=========================================================================================================|
+/**
+ * Redraws the address maps from the enabled breakpoints and works out whether anything is armed.
+ */
+void Breakpoints::Rebuild()
+{
+	memset(map, 0, sizeof(map));
+	barmed = false;
+
+	for (const ENTRY& e : entries)
+	{
+		if (!e.benabled)
+			continue;
+
+		for (u32 a = e.bp.lo; a <= e.bp.hi; a++)
+			map[e.bp.kind][a >> 6] |= 1ull << (a & 63);
+		barmed = true;
+	} // end for
+} // end Rebuild
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,197 @@
+//=========================================================================================================|
+// Breakpoints.h
+//	Execution breakpoints and read/write watchpoints, for debuggers and for test harnesses that want the
+//	emulator to stop when the game gets somewhere.
+//
+//	Every breakpoint covers an address range of one kind (exec, read or write) and can carry a condition
+//	on a register (or, for watchpoints, on the byte moved) plus a hit count to let pass before it stops.
+//	Anything more involved goes in an expression (Set_Condition; see Condition.h), compiled once when set.
+//	Which addresses have anything on them is kept in three 64K-bit maps, so the checks only ever test a
+//	bit; the list of breakpoints is only walked when the bit is set.
+//
+//	All of it is checked from the cpu's fetch, once per instruction, behind a single test of Armed(); with
+//	nothing armed that's the whole cost. Watchpoints are matched against the instruction's effective
+//	address (and what it read or wrote there) rather than from inside Bus::Read/Write, because a test in
+//	there is paid on every access and came to 5-10% of the run time unarmed. The price is that the accesses
+//	an instruction makes on the side don't count: stack pushes and pulls, zero page pointers of (zp,X) and
+//	(zp),Y, JMP's indirect vector, interrupt vectors.
+//
+//	A hit asks the bus to stop its run (see Bus::Stop) once the current instruction is done; i.e. an exec
+//	breakpoint stops with the cpu sitting on the instruction, before it has run, and a watchpoint right
+//	after the instruction that made the access. What fired is kept in Hits() till cleared.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef BREAKPOINTS_H
+#define BREAKPOINTS_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CPU6502.h"
+#include "Condition.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define BREAK_MAP_WORDS		(65536 / 64)
+#define BREAK_MAX_HITS		64			// hits kept between Clear_Hits; later ones are only counted
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+enum BREAK_KIND
+{
+	BREAK_EXEC,
+	BREAK_READ,
+	BREAK_WRITE,
+	BREAK_KINDS
+};
+
+
+// what a condition looks at
+enum BREAK_REG
+{
+	BREAK_ALWAYS,		// no condition
+	BREAK_A,
+	BREAK_X,
+	BREAK_Y,
+	BREAK_SP,
+	BREAK_P,
+	BREAK_PC,
+	BREAK_DATA			// the byte read or written; watchpoints only
+};
+
+
+// and how it compares it with the value
+enum BREAK_CMP
+{
+	BREAK_EQ,
+	BREAK_NE,
+	BREAK_LT,
+	BREAK_LE,
+	BREAK_GT,
+	BREAK_GE,
+	BREAK_ANY_BITS		// (reg & value) != 0
+};
+
+
+/**
+ * What to stop on. lo..hi is inclusive; the condition is reg cmp value. The first skip hits that pass
+ *	the condition are counted but let go, so skip = 9 stops on the tenth.
+ */
+struct BREAKPOINT
+{
+	u8 kind;			// BREAK_KIND
+	u16 lo, hi;
+	u8 reg;				// BREAK_REG
+	u8 cmp;				// BREAK_CMP
+	u16 value;
+	u64 skip;
+	bool btemporary;	// removed once it has stopped the run
+};
+
+
+class Bus;
+
+
+// one stop
+struct BREAK_HIT
+{
+	int id;
+	u8 kind;
+	u16 addr;			// pc for exec, the address accessed otherwise
+	u8 data;			// byte read or written
+	u16 pc;				// the instruction that made the access; the pc stopped on for exec
+	u64 cycle;			// system clock the run stops on
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class Breakpoints
+{
+public:
+
+	Breakpoints();
+	~Breakpoints();
+
+	void Connect_Bus(Bus* pn);
+
+	int Add(const BREAKPOINT& bp);
+	int Add_Exec(u16 pc, u64 skip = 0);
+	int Add_Watch(u8 kind, u16 lo, u16 hi);
+	bool Remove(int id);
+	bool Enable(int id, bool benable);
+	bool Set_Condition(int id, const char* expr);
+	void Clear();
+
+	// why the last Set_Condition failed
+	const std::string& Error() const { return error; }
+
+	// how often breakpoint id passed its condition, stops included; 0 for unknown ids
+	u64 Hit_Count(int id) const;
+
+	const std::vector<BREAK_HIT>& Hits() const { return hits; }
+	u64 Missed_Hits() const { return missed_hits; }
+	void Clear_Hits() { hits.clear(); missed_hits = 0; }
+
+	// the one test the cpu makes; the calls below are only made while it's true
+	bool Armed() const { return barmed; }
+
+	void Instruction(const CPU6502& cpu, u16 op_pc, u8 opcode, u16 addr, u8 fetched, u8 cycles_left);
+	void Exec(const CPU6502& cpu, u8 cycles_left);
+
+private:
+
+	struct ENTRY
+	{
+		int id;
+		BREAKPOINT bp;
+		bool benabled;
+		u64 hits;
+		Condition condition;
+	};
+
+	Bus* pbus;
+	std::vector<ENTRY> entries;
+	std::vector<BREAK_HIT> hits;
+	u64 missed_hits;
+	int next_id;
+	std::string error;
+
+	u64 map[BREAK_KINDS][BREAK_MAP_WORDS];
+	bool barmed;
+
+	u8 access[256];				// per opcode, (1 << BREAK_READ) | (1 << BREAK_WRITE) for its operand
+
+	bool Mapped(u8 kind, u16 addr) const { return map[kind][addr >> 6] >> (addr & 63) & 1; }
+	bool Check(u8 kind, u16 addr, u8 data, u16 pc, u64 at);
+	void Rebuild();
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -13,7 +13,7 @@
 //	14th of November 2022, Monday
 //
 // Last Update:
-//	15th of Novemeber 2022, Tuesday
+//	19th of October 2026, Monday
 //
 // Compiled On:
 //	HP Pavallion (Areselaliyur) running on Intel Core I7 16GB RAM on Microsoft's Windows 11. 
@@ -25,6 +25,8 @@
 // INCLUDES
 //=========================================================================================================|
 #include "Bus.h"
+#include "LatencyTracer.h"
+#include "Recompiled.h"
 
 
 //=========================================================================================================|
@@ -40,9 +42,15 @@
  * Clear's the RAM (main memory); this is a software emulation baby!
  */
 Bus::Bus()
+	:system_clock{ 0 }, frame_count{ 0 }, apu_sync_clock{ 0 }, rom_start{ RAM_SIZE }, bstrobe{ false },
+	platency{ nullptr }, precompiled{ nullptr }, frame_end{ 0 }, break_at{ UINT64_MAX }, run_until{ 0 }
 {
 	memset(ram, 0, RAM_SIZE);
+	memset(controller, 0, sizeof(controller));
+	memset(controller_shift, 0, sizeof(controller_shift));
 	cpu6502.Connect_Bus(this);
+	apu.Connect_Bus(this);
+	breakpoints.Connect_Bus(this);
 } // end Consturctor
 
 
@@ -62,7 +70,23 @@ Bus::~Bus()
  */
 void Bus::Write(u16 addr, u8 data)
 {
-	if (addr >= 0x0000 && addr <= 0xFFFF)
+	heat.Write(addr);
+
+	if ((addr >= 0x4000 && addr <= 0x4013) || addr == 0x4015 || addr == 0x4017)
+	{
+		apu.Write_Register(system_clock, addr, data);
+		apu_sync_clock = apu.Next_Irq_Clock();
+	} // end if apu
+	else if (addr == 0x4016)
+	{
+		bstrobe = data & 0x01;
+		if (bstrobe)
+		{
+			controller_shift[0] = controller[0];
+			controller_shift[1] = controller[1];
+		} // end if
+	} // end else if controllers
+	else if (addr < rom_start)
 		ram[addr] = data;
 } // end Write
 
@@ -71,14 +95,235 @@ void Bus::Write(u16 addr, u8 data)
 /**
  * Read's the 8-bit value stored at the 16-bit address.
  */
-u8 Bus::Read(u16 addr, bool bread_only)
+u8 Bus::Read(u16 addr)
 {
-	if (addr >= 0x0000 && addr <= 0xFFFF)
+	heat.Read(addr);
+
+	if (addr == 0x4015)
+	{
+		u8 status = apu.Read_Status(system_clock);
+		apu_sync_clock = apu.Next_Irq_Clock();
+		return status;
+	} // end if apu
+	else if (addr == 0x4016 || addr == 0x4017)
+	{
+		u8 port = addr & 0x01;
+		if (bstrobe)
+			controller_shift[port] = controller[port];
+		if (platency)
+			platency->Read(port);
+
+		// A first; once all eight are out a real pad keeps returning 1's
+		u8 bit = controller_shift[port] & 0x01;
+		controller_shift[port] = (controller_shift[port] >> 1) | 0x80;
+		return 0x40 | bit;		// the upper bits are open bus, usually the $40 of the address
+	} // end else if controllers
+	else if (addr >= 0x0000 && addr <= 0xFFFF)
 		return ram[addr];
 	return 0;
 } // end Read
 
 
+//=========================================================================================================|
+/**
+ * Points at as much of addr..addr+len-1 as is plain memory, i.e. stops short of the first register that
+ *	Peek has to work out (and of the end of the address space); nothing is copied. A size of 0 means addr
+ *	itself is such a register. Callers walk a range by taking spans and Peek'ing the gaps.
+ */
+PEEK_SPAN Bus::Peek_Range(u16 addr, u32 len) const
+{
+	u32 end = addr < IO_READ_FIRST ? IO_READ_FIRST : addr <= IO_READ_LAST ? addr : RAM_SIZE;
+	u32 size = end - addr;
+	return { ram + addr, size < len ? size : len };
+} // end Peek_Range
+
+
+//=========================================================================================================|
+/**
+ * Peeks len bytes from addr into out, wrapping round from $FFFF to $0000; memcpy for the plain parts.
+ */
+void Bus::Peek_Copy(u16 addr, u8* out, u32 len) const
+{
+	while (len)
+	{
+		PEEK_SPAN span = Peek_Range(addr, len);
+		if (!span.size)
+		{
+			*out = Peek(addr);
+			span.size = 1;
+		} // end if
+		else
+			memcpy(out, span.data, span.size);
+
+		out += span.size;
+		addr = (u16)(addr + span.size);
+		len -= span.size;
+	} // end while
+} // end Peek_Copy
+
+
+//=========================================================================================================|
+/**
+ * Peek for the registers whose reads change something. $4015 is as of the apu's last catch-up, which is
+ *	never behind by more than the irq it's waiting on; catching it up here would change when its samples
+ *	get made.
+ */
+u8 Bus::Peek_Io(u16 addr) const
+{
+	if (addr == 0x4015)
+		return apu.Peek_Status();
+
+	u8 port = addr & 0x01;
+	u8 shift = bstrobe ? controller[port] : controller_shift[port];
+	return 0x40 | (shift & 0x01);
+} // end Peek_Io
+
+
+//=========================================================================================================|
+/**
+ * Resets the components on the bus and the system clock along with them.
+ */
+void Bus::Reset()
+{
+	system_clock = frame_count = 0;
+	frame_end = run_until = 0;
+	break_at = UINT64_MAX;
+	bstrobe = false;
+	controller_shift[0] = controller_shift[1] = 0;
+	apu.Reset();
+	apu_sync_clock = apu.Next_Irq_Clock();
+	cpu6502.Reset();
+} // end Reset
+
+
+//=========================================================================================================|
+/**
+ * One tick of the system clock. The APU is not clocked here; it's only caught up when it may be about to
+ *	raise an irq, the rest of the time it catches up on its own when its registers are touched.
+ */
+void Bus::Clock()
+{
+	cpu6502.Clock();
+
+	if (++system_clock >= apu_sync_clock)
+	{
+		apu.Run_Until(system_clock);
+		apu_sync_clock = apu.Next_Irq_Clock();
+	} // end if
+
+	if (apu.Irq_Asserted() && cpu6502.Complete())
+		cpu6502.IRQ();
+} // end Clock
+
+
+//=========================================================================================================|
+/**
+ * Runs one NTSC frame worth of cycles and closes the audio frame, so a frame's worth of samples is ready
+ *	to be read from the APU in one batch.
+ *
+ * With a Recompiled attached the frame goes through it instead; same cycles, same result.
+ *
+ * A breakpoint can cut the run short, in which case this returns false with the machine stopped where the
+ *	breakpoint wanted it (see Breakpoints::Hits for why); the next call carries on with the same frame.
+ *	That holds for a stop on the frame's last cycle too: the frame is only closed by the call that returns
+ *	true, and frame_end stays set until then, so the next call closes it rather than starting another.
+ */
+bool Bus::Run_Frame()
+{
+	if (!frame_end)
+		frame_end = system_clock + CPU_CYCLES_PER_FRAME + (frame_count & 1);
+
+	run_until = frame_end < break_at ? frame_end : break_at;
+	if (precompiled)
+		precompiled->Run();
+	else
+		while (system_clock < run_until)
+			Clock();
+
+	bool bstopped = system_clock >= break_at;
+	if (bstopped)
+		break_at = UINT64_MAX;
+	else if (system_clock >= frame_end)
+	{
+		apu.End_Frame(system_clock);
+		++frame_count;
+		frame_end = 0;
+	} // end if
+
+	return !bstopped;
+} // end Run_Frame
+
+
+//=========================================================================================================|
+/**
+ * Asks the run to stop once the system clock gets to at_clock; the earliest of several asks wins.
+ */
+void Bus::Stop(u64 at_clock)
+{
+	if (at_clock < break_at)
+		break_at = at_clock;
+	if (at_clock < run_until)
+		run_until = at_clock;
+} // end Stop
+
+
+//=========================================================================================================|
+/**
+ * Copies the machine out: cpu, apu, pads, clocks and memory. Memory from rom_start up can't change, so
+ *	only what's below it is copied, which for a cartridge is half. Debugging state (breakpoints, heat, a
+ *	pending stop) isn't machine state and stays as it is.
+ */
+void Bus::Save_State(MACHINE_STATE& state) const
+{
+	cpu6502.Save_State(state.cpu);
+	apu.Save_State(state.apu);
+
+	state.system_clock = system_clock;
+	state.frame_count = frame_count;
+	state.apu_sync_clock = apu_sync_clock;
+	state.frame_end = frame_end;
+
+	state.controller[0] = controller[0];
+	state.controller[1] = controller[1];
+	state.controller_shift[0] = controller_shift[0];
+	state.controller_shift[1] = controller_shift[1];
+	state.bstrobe = bstrobe;
+
+	state.ram_size = rom_start;
+	memcpy(state.ram, ram, rom_start);
+} // end Save_State
+
+
+//=========================================================================================================|
+/**
+ * The reverse of Save_State. The state has to come from this bus (or one with the same cartridge in);
+ *	the rom isn't in it. A state whose memory doesn't end where this bus's rom starts is off another
+ *	cartridge, or corrupt; it's refused with false and nothing is loaded.
+ */
+bool Bus::Load_State(const MACHINE_STATE& state)
+{
+	if (state.ram_size != rom_start)
+		return false;
+
+	cpu6502.Load_State(state.cpu);
+	apu.Load_State(state.apu);
+
+	system_clock = state.system_clock;
+	frame_count = state.frame_count;
+	apu_sync_clock = state.apu_sync_clock;
+	frame_end = state.frame_end;
+
+	controller[0] = state.controller[0];
+	controller[1] = state.controller[1];
+	controller_shift[0] = state.controller_shift[0];
+	controller_shift[1] = state.controller_shift[1];
+	bstrobe = state.bstrobe;
+
+	memcpy(ram, state.ram, state.ram_size);
+	return true;
+} // end Load_State
+
+
 //=========================================================================================================|
 //			THE END
 //=========================================================================================================|
\ No newline at end of file
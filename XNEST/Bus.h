@@ -16,7 +16,7 @@
 //	14th of November 2022, Monday
 //
 // Last Update:
-//	15th of Novemeber 2022, Tuesday
+//	19th of October 2026, Monday
 //
 // Compiled On:
 //	HP Pavallion (Areselaliyur) running on Intel Core I7 16GB RAM on Microsoft's Windows 11. 
@@ -31,6 +31,9 @@
 #include <cstdint>
 #include <memory.h>
 #include "CPU6502.h"
+#include "APU2A03.h"
+#include "MemHeat.h"
+#include "Breakpoints.h"
 
 
 //=========================================================================================================|
@@ -38,6 +41,23 @@
 //=========================================================================================================|
 #define RAM_SIZE		65536
 
+// an NTSC frame is 29780.5 cpu cycles; frames alternate between the two
+#define CPU_CYCLES_PER_FRAME	29780
+
+// the addresses whose reads do something besides read; Peek works these out instead of reading them
+#define IO_READ_FIRST	0x4015
+#define IO_READ_LAST	0x4017
+
+// standard controller buttons, in the order the pad shifts them out
+#define BUTTON_A		(1 << 0)
+#define BUTTON_B		(1 << 1)
+#define BUTTON_SELECT	(1 << 2)
+#define BUTTON_START	(1 << 3)
+#define BUTTON_UP		(1 << 4)
+#define BUTTON_DOWN		(1 << 5)
+#define BUTTON_LEFT		(1 << 6)
+#define BUTTON_RIGHT	(1 << 7)
+
 
 
 //=========================================================================================================|
@@ -46,6 +66,39 @@
 typedef uint8_t u8;
 typedef uint16_t u16;
 typedef uint32_t u32;
+typedef uint64_t u64;
+
+
+class LatencyTracer;
+class Recompiled;
+
+
+// a whole machine, for run-ahead, rollback and the like; see Bus::Save_State
+struct MACHINE_STATE
+{
+	CPU_STATE cpu;
+	APU_STATE apu;
+
+	u64 system_clock;
+	u64 frame_count;
+	u64 apu_sync_clock;
+	u64 frame_end;
+
+	u8 controller[2];
+	u8 controller_shift[2];
+	bool bstrobe;
+
+	u32 ram_size;				// how much of ram below is in use; everything up to the write protected part
+	u8 ram[RAM_SIZE];
+};
+
+
+// a run of memory seen through Peek_Range; data points into the bus itself, good until the next write
+struct PEEK_SPAN
+{
+	const u8* data;
+	u32 size;
+};
 
 
 
@@ -60,15 +113,65 @@ public:
 	~Bus();
 	
 	void Write(u16 addr, u8 data);
-	uint8_t Read(u16 addr, bool bread_only = false);
+	uint8_t Read(u16 addr);
+
+	// for debuggers and tools: what a read would give, without anything a read does besides
+	u8 Peek(u16 addr) const;
+	PEEK_SPAN Peek_Range(u16 addr, u32 len) const;
+	void Peek_Copy(u16 addr, u8* out, u32 len) const;
+
+	void Reset();
+	void Clock();
+	bool Run_Frame();
+	void Stop(u64 at_clock);
+
+	void Save_State(MACHINE_STATE& state) const;
+	bool Load_State(const MACHINE_STATE& state);
 
 //private:
 
 	CPU6502 cpu6502;			// 6502 8-bit CPU
+	APU2A03 apu;				// the sound half of the 2A03
 	uint8_t ram[RAM_SIZE];		// I'm using plain old array's, suck it up C++, I like it in C style...
+
+	u64 system_clock;			// cpu cycles since reset
+	u64 frame_count;			// frames run since reset
+	u64 apu_sync_clock;			// next clock the apu may raise an irq; we catch it up then
+
+	u32 rom_start;				// writes from here up are dropped; RAM_SIZE when nothing is write protected
+
+	u8 controller[2];			// buttons held on each pad, as set by the front end
+	u8 controller_shift[2];		// what's left to shift out of $4016/$4017
+	bool bstrobe;				// $4016 bit 0; the pads keep reloading while it's high
+	LatencyTracer* platency;	// told about every pad read while attached; null otherwise
+	Recompiled* precompiled;	// runs the frames while attached (Recompiled.h); null otherwise
+
+	MemHeat<XNEST_HEATMAP> heat;	// access counters; empty unless built with XNEST_HEATMAP
+
+	Breakpoints breakpoints;	// checked by the cpu after each instruction while any are armed
+	u64 frame_end;				// system clock the frame being run ends on; 0 between frames
+	u64 break_at;				// where a breakpoint asked the run to stop; ~0 when none did
+	u64 run_until;				// Run_Frame's limit; the frame's end or break_at, whichever is first
+
+private:
+
+	u8 Peek_Io(u16 addr) const;
 };
 
 
+//=========================================================================================================|
+/**
+ * The byte at addr as the cpu would read it, minus the side effects: no controller shifts, no acknowledged
+ *	irqs, no heat. Inline, since everything outside the handful of registers is a plain array index.
+ */
+inline u8 Bus::Peek(u16 addr) const
+{
+	if ((u16)(addr - IO_READ_FIRST) <= IO_READ_LAST - IO_READ_FIRST)
+		return Peek_Io(addr);
+	return ram[addr];
+} // end Peek
+
+
 #endif
 //=========================================================================================================|
 //			THE END
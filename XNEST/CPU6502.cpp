@@ -21,7 +21,7 @@
 //	14th of November 2022, Monday
 //
 // Last Update:
-//	23rd of Novemeber 2022, Wednesday
+//	19th of October 2026, Monday
 //
 // Compiled On:
 //	HP Pavallion (Areselaliyur) running on Intel Core I7 16GB RAM on Microsoft's Windows 11. 
@@ -32,6 +32,8 @@
 //=========================================================================================================|
 // INCLUDES
 //=========================================================================================================|
+#include <cstring>
+
 #include "CPU6502.h"
 #include "Bus.h"
 
@@ -43,6 +45,20 @@
 
 
 
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * True for the twelve opcodes that halt a real 6502 till reset ($02, $12 .. $F2 but $82, $A2, $C2, $E2).
+ *	This cpu runs them as a NOP, like the rest of the unofficial ones.
+ */
+static bool Is_Jam(u8 op)
+{
+	return (op & 0x1F) == 0x12 || op == 0x02 || op == 0x22 || op == 0x42 || op == 0x62;
+} // end Is_Jam
+
+
+
 //=========================================================================================================|
 // CLASS DEFINTION
 //=========================================================================================================|
@@ -51,7 +67,9 @@
  */
 CPU6502::CPU6502()
 	:pbus{nullptr},
-	a{ 0 }, x{ 0 }, y{ 0 }, sp {0}, pc{ 0 }, status{ 0 }
+	a{ 0 }, x{ 0 }, y{ 0 }, sp {0}, pc{ 0 }, status{ 0 }, bobserved{ false },
+	sample_period{ CPU_NO_SAMPLES }, sample_span{ CPU_NO_SAMPLES }, sample_countdown{ CPU_NO_SAMPLES },
+	observed_base{ 0 }, coverage{ nullptr }, jams{ 0 }, jam_pc{ 0 }
 {
 	using a = CPU6502;
 	lookup =
@@ -73,6 +91,20 @@ CPU6502::CPU6502()
 		{ "CPX", &a::CPX, &a::IMM, 2 },{ "SBC", &a::SBC, &a::IZX, 6 },{ "???", &a::NOP, &a::IMP, 2 },{ "???", &a::UNK, &a::IMP, 8 },{ "CPX", &a::CPX, &a::ZP0, 3 },{ "SBC", &a::SBC, &a::ZP0, 3 },{ "INC", &a::INC, &a::ZP0, 5 },{ "???", &a::UNK, &a::IMP, 5 },{ "INX", &a::INX, &a::IMP, 2 },{ "SBC", &a::SBC, &a::IMM, 2 },{ "NOP", &a::NOP, &a::IMP, 2 },{ "???", &a::SBC, &a::IMP, 2 },{ "CPX", &a::CPX, &a::ABS, 4 },{ "SBC", &a::SBC, &a::ABS, 4 },{ "INC", &a::INC, &a::ABS, 6 },{ "???", &a::UNK, &a::IMP, 6 },
 		{ "BEQ", &a::BEQ, &a::REL, 2 },{ "SBC", &a::SBC, &a::IZY, 5 },{ "???", &a::UNK, &a::IMP, 2 },{ "???", &a::UNK, &a::IMP, 8 },{ "???", &a::NOP, &a::IMP, 4 },{ "SBC", &a::SBC, &a::ZPX, 4 },{ "INC", &a::INC, &a::ZPX, 6 },{ "???", &a::UNK, &a::IMP, 6 },{ "SED", &a::SED, &a::IMP, 2 },{ "SBC", &a::SBC, &a::ABY, 4 },{ "NOP", &a::NOP, &a::IMP, 2 },{ "???", &a::UNK, &a::IMP, 7 },{ "???", &a::NOP, &a::IMP, 4 },{ "SBC", &a::SBC, &a::ABX, 4 },{ "INC", &a::INC, &a::ABX, 7 },{ "???", &a::UNK, &a::IMP, 7 },
 	};
+
+	// name the addressing mode of each entry once, so nobody has to compare member pointers later
+	u8(CPU6502::* modes[AM_COUNT])(void) =
+	{
+		&a::IMP, &a::IMM, &a::ZP0, &a::ZPX, &a::ZPY, &a::REL,
+		&a::ABS, &a::ABX, &a::ABY, &a::IND, &a::IZX, &a::IZY
+	};
+
+	for (auto& ins : lookup)
+		for (u8 m = 0; m < AM_COUNT; m++)
+			if (ins.Addrmode == modes[m])
+				ins.mode = m;
+
+	memset(observe_opcode, 0, sizeof(observe_opcode));
 } // end constructor
 
 
@@ -94,6 +126,180 @@ void CPU6502::Connect_Bus(Bus* pn)
 } // end Connect_NESBus
 
 
+//=========================================================================================================|
+/**
+ * Starts telling pobserver about the OBSERVE_* events asked for; attaching again just changes those.
+ */
+void CPU6502::Attach(CpuObserver* pobserver, u32 events)
+{
+	if (observers.empty())
+		observed_base = sample_span = sample_countdown = 0;
+
+	for (OBSERVER& o : observers)
+	{
+		if (o.p == pobserver)
+		{
+			o.events = events;
+			Update_Observers();
+			return;
+		} // end if
+	} // end for
+
+	observers.push_back({ pobserver, events });
+	Update_Observers();
+} // end Attach
+
+
+//=========================================================================================================|
+/**
+ * Stops telling pobserver anything.
+ */
+void CPU6502::Detach(CpuObserver* pobserver)
+{
+	for (size_t i = 0; i < observers.size(); i++)
+	{
+		if (observers[i].p == pobserver)
+		{
+			observers.erase(observers.begin() + i);
+			break;
+		} // end if
+	} // end for
+
+	Update_Observers();
+} // end Detach
+
+
+//=========================================================================================================|
+/**
+ * Starts counting edges into map (see COVERAGE_SIZE), or stops with nullptr. The jam count starts over.
+ */
+void CPU6502::Set_Coverage(u8* map)
+{
+	coverage = map;
+	jams = 0;
+	jam_pc = 0;
+	Update_Observers();
+} // end Set_Coverage
+
+
+//=========================================================================================================|
+/**
+ * How many cycles between OBSERVE_SAMPLES callbacks; takes effect when the current period runs out.
+ */
+void CPU6502::Set_Sample_Period(u32 period)
+{
+	sample_period = period ? period : 1;
+	Restart_Samples();
+} // end Set_Sample_Period
+
+
+//=========================================================================================================|
+/**
+ * Starts a new sample period now, keeping the cycles counted so far.
+ */
+void CPU6502::Restart_Samples()
+{
+	observed_base += sample_span - sample_countdown;
+	sample_countdown = sample_span = sample_period;
+} // end Restart_Samples
+
+
+//=========================================================================================================|
+/**
+ * Works out which opcodes need Observe called after them, from what everyone attached asked for.
+ */
+void CPU6502::Update_Observers()
+{
+	u32 events = 0;
+	for (const OBSERVER& o : observers)
+		events |= o.events;
+
+	for (int op = 0; op < 256; op++)
+	{
+		bool bflow = op == 0x20 || op == 0x60 || op == 0x00 || op == 0x40;
+		observe_opcode[op] = (events & OBSERVE_INSTRUCTIONS) | (bflow ? events & OBSERVE_FLOW : 0);
+
+		// the branches ($10, $30 .. $F0), JMP, the flow ones above, and the jams
+		bool bedge = bflow || (op & 0x1F) == 0x10 || op == 0x4C || op == 0x6C;
+		if (coverage && (bedge || Is_Jam((u8)op)))
+			observe_opcode[op] |= OBSERVE_EDGES;
+	} // end for
+
+	if (!(events & OBSERVE_SAMPLES))
+		sample_period = CPU_NO_SAMPLES;
+	Restart_Samples();
+	bobserved = !observers.empty() || coverage;
+} // end Update_Observers
+
+
+//=========================================================================================================|
+/**
+ * Called after an instruction when a sample is due or somebody wants to hear about the opcode; kept out
+ *	of line so the hot path in Clock stays a subtract, a test and a jump.
+ */
+void CPU6502::Observe(u16 op_pc)
+{
+	if (sample_countdown <= 0)
+	{
+		Restart_Samples();
+
+		for (const OBSERVER& o : observers)
+			if (o.events & OBSERVE_SAMPLES)
+				o.p->Sample(*this, op_pc);
+	} // end if
+
+	if (!observe_opcode[opcode])
+		return;
+	if (observe_opcode[opcode] & OBSERVE_EDGES)
+	{
+		Cover(op_pc);
+		if (Is_Jam(opcode))
+		{
+			jams++;
+			jam_pc = op_pc;
+		} // end if
+	} // end if
+
+	CPU_FLOW kind = opcode == 0x20 ? FLOW_JSR : opcode == 0x60 ? FLOW_RTS : opcode == 0x00 ? FLOW_BRK : FLOW_RTI;
+	bool bflow = opcode == 0x20 || opcode == 0x60 || opcode == 0x00 || opcode == 0x40;
+
+	for (const OBSERVER& o : observers)
+	{
+		if (o.events & OBSERVE_INSTRUCTIONS)
+			o.p->Instruction(*this, op_pc, opcode, cycles);
+		if (bflow && (o.events & OBSERVE_FLOW))
+			o.p->Flow(*this, kind, op_pc);
+	} // end for
+} // end Observe
+
+
+//=========================================================================================================|
+/**
+ * Same as above for an interrupt having been taken at int_pc; it has cycles of its own to count.
+ */
+void CPU6502::Observe_Interrupt(CPU_FLOW kind, u16 int_pc, u8 int_cycles)
+{
+	sample_countdown -= int_cycles;
+	if (coverage)
+		Cover(int_pc);
+
+	for (const OBSERVER& o : observers)
+		if (o.events & OBSERVE_FLOW)
+			o.p->Flow(*this, kind, int_pc);
+} // end Observe_Interrupt
+
+
+//=========================================================================================================|
+/**
+ * Counts the edge from the instruction (or interrupted pc) at from to where the cpu is now.
+ */
+void CPU6502::Cover(u16 from)
+{
+	u8& hits = coverage[COVERAGE_EDGE(from, pc)];
+	hits += hits != 0xFF;
+} // end Cover
+
+
 //=========================================================================================================|
 /**
  * Writes the byte data at the 16-bit address provided
@@ -124,17 +330,109 @@ void CPU6502::Clock()
 {
 	if (!cycles)
 	{
+		u16 op_pc = pc;
 		opcode = Read(pc++);
+		pbus->heat.Execute(op_pc);
 		cycles = lookup[opcode].cycles;
 		uint8_t add_cycle1 = (this->*lookup[opcode].Addrmode)();
 		uint8_t add_cycle2 = (this->*lookup[opcode].Operate)();
 		cycles += (add_cycle1 & add_cycle2);
+
+		counters.Instruction(opcode, lookup[opcode].mode, lookup[opcode].cycles, cycles, add_cycle1 & add_cycle2);
+
+		if (bobserved && ((sample_countdown -= cycles) <= 0 || observe_opcode[opcode]))
+			Observe(op_pc);
+
+		if (pbus->breakpoints.Armed())
+			pbus->breakpoints.Instruction(*this, op_pc, opcode, addr_abs, fetched, cycles);
 	} // end if
 
 	--cycles;
 } // end Clock
 
 
+//=========================================================================================================|
+/**
+ * Runs the clock till the current instruction (or the next one, if we're between instructions) is done.
+ *	Returns the number of ticks that took.
+ */
+u32 CPU6502::Step()
+{
+	u32 ticks = 0;
+	do
+	{
+		Clock();
+		++ticks;
+	} while (cycles);
+
+	return ticks;
+} // end Step
+
+
+//=========================================================================================================|
+/**
+ * Copies the registers and the in flight instruction's bits out.
+ */
+void CPU6502::Save_State(CPU_STATE& state) const
+{
+	state.a = a; state.x = x; state.y = y;
+	state.sp = sp; state.status = status; state.pc = pc;
+
+	state.fetched = fetched;
+	state.addr_abs = addr_abs;
+	state.addr_rel = addr_rel;
+	state.opcode = opcode;
+	state.cycles = cycles;
+} // end Save_State
+
+
+//=========================================================================================================|
+/**
+ * The reverse of Save_State.
+ */
+void CPU6502::Load_State(const CPU_STATE& state)
+{
+	a = state.a; x = state.x; y = state.y;
+	sp = state.sp; status = state.status; pc = state.pc;
+
+	fetched = state.fetched;
+	addr_abs = state.addr_abs;
+	addr_rel = state.addr_rel;
+	opcode = state.opcode;
+	cycles = state.cycles;
+} // end Load_State
+
+
+//=========================================================================================================|
+/**
+ * Describes opcode op out of the lookup table.
+ */
+void CPU6502::Get_Opcode_Info(u8 op, OPCODE_INFO& info) const
+{
+	static const u8 LENGTHS[AM_COUNT] = { 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 2, 2 };
+
+	info.name = lookup[op].name;
+	info.mode = lookup[op].mode;
+	info.bytes = LENGTHS[info.mode];
+	info.cycles = lookup[op].cycles;
+} // end Get_Opcode_Info
+
+
+//=========================================================================================================|
+/**
+ * The ADDRMODE as the three letters used all over this file; "???" when out of range.
+ */
+const char* CPU6502::Mode_Name(u8 mode)
+{
+	static const char* NAMES[AM_COUNT] =
+	{
+		"IMP", "IMM", "ZP0", "ZPX", "ZPY", "REL", "ABS", "ABX", "ABY", "IND", "IZX", "IZY"
+	};
+
+	return mode < AM_COUNT ? NAMES[mode] : "???";
+} // end Mode_Name
+
+
 //=========================================================================================================|
 /*
  * Reset's the CPU and start's it in the default state; i.e. pc = 0xFFFC
@@ -144,7 +442,11 @@ void CPU6502::Reset()
 	a = x = y = 0;
 	sp = 0xFD;
 	status = 0x0 | U;
-	pc = 0xFCFF;		// 0xFFFC
+
+	// the reset vector lives at 0xFFFC/0xFFFD
+	u16 lo = Read(0xFFFC);
+	u16 hi = Read(0xFFFD);
+	pc = (hi << 8) | lo;
 
 	addr_rel = addr_abs = fetched = 0;
 	cycles = 8;		// take your time
@@ -162,13 +464,20 @@ void CPU6502::IRQ()
 		Write(0x0100 + sp--, (pc >> 8) & 0x00FF);
 		Write(0x0100 + sp--, (pc & 0x00FF));
 
+		// pushed with I as it was, so the RTI unmasks again; masked only from here on
 		SET_FLAG(status, B, 0);
 		SET_FLAG(status, U, 1);
-		SET_FLAG(status, I, 1);
 		Write(0x0100 + sp--, status);
+		SET_FLAG(status, I, 1);
 
+		u16 return_pc = pc;
 		pc = (((u16)Read(0xFFFF) << 8) | ((u16)Read(0xFFFE)));
 		cycles = 7;
+
+		if (bobserved)
+			Observe_Interrupt(FLOW_IRQ, return_pc, cycles);
+		if (pbus->breakpoints.Armed())
+			pbus->breakpoints.Exec(*this, cycles);
 	} // end if
 } // end IRQ
 
@@ -184,11 +493,17 @@ void CPU6502::NMI()
 
 	SET_FLAG(status, B, 0);
 	SET_FLAG(status, U, 1);
-	SET_FLAG(status, I, 1);
 	Write(0x0100 + sp--, status);
+	SET_FLAG(status, I, 1);
 
+	u16 return_pc = pc;
 	pc = (((u16)Read(0xFFFB) << 8) | ((u16)Read(0xFFFA)));
 	cycles = 8;
+
+	if (bobserved)
+		Observe_Interrupt(FLOW_NMI, return_pc, cycles);
+	if (pbus->breakpoints.Armed())
+		pbus->breakpoints.Exec(*this, cycles);
 } // end NMI
 
 
@@ -348,7 +663,7 @@ u8 CPU6502::IZX()
 u8 CPU6502::IZY()
 {
 	u16 t = Read(pc++);
-	u16 lo = Read(t + 0x00FF);
+	u16 lo = Read(t & 0x00FF);
 	u16 hi = Read((t + 1) & 0x00FF);
 	addr_abs = ((hi << 8) | lo) + y;
 	if ((addr_abs & 0xFF00) != (hi << 8))
@@ -413,7 +728,7 @@ u8 CPU6502::AND()
 {
 	a &= Fetch();
 	SET_FLAG(status, Z, a == 0x00);
-	SET_FLAG(status, N, a &= 0x80);
+	SET_FLAG(status, N, a & 0x80);
 	return 1;
 } // end AND
 
@@ -755,7 +1070,7 @@ u8 CPU6502::EOR()
 {
 	a ^= Fetch();
 	SET_FLAG(status, Z, a == 0x00);
-	SET_FLAG(status, N, a == 0x80);
+	SET_FLAG(status, N, a & 0x80);
 	return 1;
 } // end EOR
 
@@ -915,7 +1230,7 @@ u8 CPU6502::ORA()
 {
 	a |= Fetch();
 	SET_FLAG(status, Z, a == 0x00);
-	SET_FLAG(status, N, a == 0x80);
+	SET_FLAG(status, N, a & 0x80);
 	return 1;
 } // end ORA
 
@@ -1013,12 +1328,12 @@ u8 CPU6502::ROR()
  */
 u8 CPU6502::RTI()
 {
-	status = Read(0x0100 + sp);
+	status = Read(0x0100 + (++sp));
 	status &= ~B;
 	status &= ~U;
 
-	pc = (uint16_t)Read(0x0100 + sp++);
-	pc |= (uint16_t)Read(0x0100 + sp++) << 8;
+	pc = (uint16_t)Read(0x0100 + (++sp));
+	pc |= (uint16_t)Read(0x0100 + (++sp)) << 8;
 	return 0;
 } // end RTI
 
@@ -1029,8 +1344,8 @@ u8 CPU6502::RTI()
  */
 u8 CPU6502::RTS()
 {
-	pc = (uint16_t)Read(0x0100 + sp++);
-	pc |= (uint16_t)Read(0x0100 + sp++) << 8;
+	pc = (uint16_t)Read(0x0100 + (++sp));
+	pc |= (uint16_t)Read(0x0100 + (++sp)) << 8;
 
 	pc++;
 	return 0;
@@ -1043,11 +1358,12 @@ u8 CPU6502::RTS()
  */
 u8 CPU6502::SBC()
 {
-	u16 t = (u16)a + ((u16)Fetch() ^ 0x00FF) + (u16)GET_FLAG(status, C);
+	u16 value = (u16)Fetch() ^ 0x00FF;	// subtraction is addition of the ones' complement
+	u16 t = (u16)a + value + (u16)GET_FLAG(status, C);
 
 	SET_FLAG(status, C, t > 255);
 	SET_FLAG(status, Z, (t & 0x00FF) == 0x00);
-	SET_FLAG(status, V, (~((u16)a ^ (u16)fetched) & ((u16)a ^ (u16)t)) & 0x0080);
+	SET_FLAG(status, V, (~((u16)a ^ value) & ((u16)a ^ (u16)t)) & 0x0080);
 	SET_FLAG(status, N, t & 0x80);
 	a = t & 0x00FF;
 	return 1;
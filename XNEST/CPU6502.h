@@ -30,7 +30,7 @@
 //	14th of November 2022, Monday
 //
 // Last Update:
-//	23rd of Novemeber 2022, Wednesday
+//	19th of October 2026, Monday
 //
 // Compiled On:
 //	HP Pavallion (Areselaliyur) running on Intel Core I7 16GB RAM on Microsoft's Windows 11. 
@@ -48,12 +48,119 @@
 #include <vector>
 
 
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+// build with -DXNEST_CPU_STATS=1 to have every instruction counted (see CpuCounters below); with it off the
+// counting calls are empty inlines and the compiler leaves nothing behind
+#ifndef XNEST_CPU_STATS
+#define XNEST_CPU_STATS		0
+#endif
+
+
+
 //=========================================================================================================|
 // TYPES
 //=========================================================================================================|
 typedef uint8_t u8;
 typedef uint16_t u16;
 typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int64_t s64;
+
+
+// the 12 addressing modes as plain numbers; for tools that need to know an instruction's shape
+enum ADDRMODE
+{
+	AM_IMP, AM_IMM, AM_ZP0, AM_ZPX,
+	AM_ZPY, AM_REL, AM_ABS, AM_ABX,
+	AM_ABY, AM_IND, AM_IZX, AM_IZY,
+	AM_COUNT
+};
+
+
+// what the outside world gets to know about an opcode
+struct OPCODE_INFO
+{
+	const char* name;		// mnemonic; "???" for the unofficial ones
+	u8 mode;				// ADDRMODE
+	u8 bytes;				// instruction length including the opcode
+	u8 cycles;				// base cycle count (page crossings and taken branches not included)
+};
+
+
+// everything needed to stop the cpu and pick it back up later, mid instruction included
+struct CPU_STATE
+{
+	u8 a, x, y, sp, status;
+	u16 pc;
+
+	u8 fetched;
+	u16 addr_abs;
+	u16 addr_rel;
+	u8 opcode;
+	u8 cycles;
+};
+
+
+// execution counters; only ever filled in by builds with XNEST_CPU_STATS on
+struct CPU_COUNTERS
+{
+	u64 op_exec[256];			// instructions run, per opcode
+	u64 op_cycles[256];			// cycles they took, penalties included
+	u64 mode_exec[AM_COUNT];	// the same per addressing mode
+	u64 mode_cycles[AM_COUNT];
+	u64 page_cross[AM_COUNT];	// extra cycles paid for crossing a page on ABX/ABY/IZY reads
+	u64 branches;				// conditional branches run
+	u64 branches_taken;
+	u64 branch_page_cross;		// taken ones that landed on another page
+};
+
+
+/**
+ * The counting policy. The disabled one is what production builds get: no state worth speaking of and an
+ *	Instruction() that inlines to nothing, so neither the calls nor the arguments cost a thing.
+ */
+template <bool benabled>
+struct CpuCounters
+{
+	static constexpr bool ENABLED = false;
+
+	void Instruction(u8, u8, u8, u8, u8) {}
+	void Clear() {}
+	const CPU_COUNTERS* Get() const { return nullptr; }
+};
+
+
+template <>
+struct CpuCounters<true>
+{
+	static constexpr bool ENABLED = true;
+
+	CPU_COUNTERS c = {};
+
+	// op finished decoding in mode: base cycles from the table, total after penalties, 1 when it paid for
+	// a page cross in its addressing mode
+	void Instruction(u8 op, u8 mode, u8 base, u8 total, u8 penalty)
+	{
+		c.op_exec[op]++;
+		c.op_cycles[op] += total;
+		c.mode_exec[mode]++;
+		c.mode_cycles[mode] += total;
+		c.page_cross[mode] += penalty;
+
+		if (mode == AM_REL)
+		{
+			// branches add their own cycles: one for taking it, another for leaving the page
+			c.branches++;
+			c.branches_taken += total > base;
+			c.branch_page_cross += total > base + 1;
+		} // end if
+	}
+
+	void Clear() { c = CPU_COUNTERS(); }
+	const CPU_COUNTERS* Get() const { return &c; }
+};
 
 
 
@@ -71,13 +178,67 @@ typedef uint32_t u32;
 #define N (1 << 7)		// Negative
 
 // helper macros
-#define SET_FLAG(r8, f, b)	(b ? r8 |= f : r8 &= ~f)
-#define GET_FLAG(r8, f)		((r8 & f) > 0) ? 1 : 0
+#define SET_FLAG(r8, f, b)	(((b)) ? ((r8) |= (f)) : ((r8) &= ~(f)))
+#define GET_FLAG(r8, f)		((((r8) & (f)) > 0) ? 1 : 0)
 
 
 
 // forward declare the bus
 class Bus;
+class CPU6502;
+
+
+// what an observer can ask to be told about (Attach's events)
+#define OBSERVE_INSTRUCTIONS	(1 << 0)	// every instruction; the expensive one
+#define OBSERVE_FLOW			(1 << 1)	// JSR, RTS, BRK, RTI and the interrupts
+#define OBSERVE_SAMPLES			(1 << 2)	// every Set_Sample_Period cycles
+#define OBSERVE_EDGES			(1 << 3)	// Set_Coverage's own; not one to Attach with
+
+#define CPU_NO_SAMPLES			(1u << 30)	// sample period while nobody wants samples
+
+// edge coverage, for fuzzers (Set_Coverage). Every branch (taken or not), jump, call, return, BRK and
+// interrupt is an edge from the pc it was at to the pc it leaves the cpu at. Each bumps a byte of the
+// map at COVERAGE_EDGE(from, to), up to 255, the way AFL does. Both pcs are spread over 16 bits first,
+// and from is halved, so a -> b and b -> a land apart. It rides on the observer path: nothing extra
+// per instruction, and a call out of line per edge.
+#define COVERAGE_SIZE			65536
+#define COVERAGE_KEY(pc)		((u16)((pc) * 0x9E37u))
+#define COVERAGE_EDGE(from, to)	((u16)((COVERAGE_KEY(from) >> 1) ^ COVERAGE_KEY(to)))
+
+
+// the control flow events an observer with OBSERVE_FLOW gets
+enum CPU_FLOW
+{
+	FLOW_JSR,
+	FLOW_RTS,
+	FLOW_BRK,
+	FLOW_RTI,
+	FLOW_NMI,
+	FLOW_IRQ
+};
+
+
+/**
+ * Anything that wants to watch the cpu run (profilers, tracers and the like) derives from this and gets
+ *	attached to the cpu with the events it cares about. With nothing attached the cost is one well
+ *	predicted branch per instruction; with only flow and samples asked for, it's a subtract and a table
+ *	lookup on top.
+ */
+class CpuObserver
+{
+public:
+
+	virtual ~CpuObserver() {}
+
+	// after an instruction has executed; pc is where it was fetched from, cycles what it took
+	virtual void Instruction(const CPU6502& cpu, u16 pc, u8 opcode, u8 cycles) {}
+
+	// after the flow instruction at pc executed (or the interrupt at pc was taken); the cpu is at the target
+	virtual void Flow(const CPU6502& cpu, CPU_FLOW kind, u16 pc) {}
+
+	// the sample period ran out during the instruction at pc
+	virtual void Sample(const CPU6502& cpu, u16 pc) {}
+};
 
 
 //=========================================================================================================|
@@ -99,6 +260,43 @@ public:
 	void IRQ();
 	void NMI();
 
+	// true when the current instruction has used up its cycles; i.e. the next tick fetches a new one
+	bool Complete() const { return cycles == 0; }
+	u32 Step();
+
+	void Save_State(CPU_STATE& state) const;
+	void Load_State(const CPU_STATE& state);
+	void Get_Opcode_Info(u8 op, OPCODE_INFO& info) const;
+	static const char* Mode_Name(u8 mode);
+
+	void Attach(CpuObserver* pobserver, u32 events);
+	void Detach(CpuObserver* pobserver);
+	void Set_Sample_Period(u32 cycles);
+
+	// COVERAGE_SIZE bytes for edges to be counted into, or nullptr to stop; the caller clears it
+	void Set_Coverage(u8* map);
+	u32 Jams() const { return jams; }		// JAM opcodes run since Set_Coverage; a real 6502 locks up on one
+	u16 Jam_Pc() const { return jam_pc; }	// where the last was
+
+	// anything attached or coverage on; i.e. something wants to see every instruction go by
+	bool Observed() const { return bobserved; }
+
+	// cycles run while anything was attached (counted at the start of each instruction, so including the
+	// one being observed)
+	u64 Observed_Cycles() const { return observed_base + (sample_span - sample_countdown); }
+
+	// a look at the registers, for observers and tools
+	u16 Pc() const { return pc; }
+	u8 Sp() const { return sp; }
+	u8 A() const { return a; }
+	u8 X() const { return x; }
+	u8 Y() const { return y; }
+	u8 Status() const { return status; }
+
+	// nullptr unless built with XNEST_CPU_STATS
+	const CPU_COUNTERS* Counters() const { return counters.Get(); }
+	void Clear_Counters() { counters.Clear(); }
+
 private:
 
 	Bus* pbus;
@@ -153,13 +351,41 @@ private:
 	// a lookup table
 	struct INSTRUCTION
 	{
-		std::string name;		// opcode name
+		const char* name;		// opcode name
 		u8(CPU6502::* Operate)(void) = nullptr;
 		u8(CPU6502::* Addrmode)(void) = nullptr;
 		u8 cycles{ 0 };
+		u8 mode{ AM_IMP };		// Addrmode as an ADDRMODE; filled in by the constructor
 	};
 
 	std::vector<INSTRUCTION> lookup;
+
+	CpuCounters<XNEST_CPU_STATS != 0> counters;
+
+	struct OBSERVER
+	{
+		CpuObserver* p;
+		u32 events;
+	};
+
+	std::vector<OBSERVER> observers;
+	bool bobserved;				// !observers.empty(), kept in a plain bool for the hot path
+	u8 observe_opcode[256];		// OBSERVE_* bits that want to hear about each opcode
+
+	u32 sample_period;			// CPU_NO_SAMPLES unless someone asked
+	u32 sample_span;			// what sample_countdown last started from
+	s64 sample_countdown;		// also the cycle count while observed; see Observed_Cycles
+	u64 observed_base;
+
+	u8* coverage;				// Set_Coverage's map; OBSERVE_EDGES is on for the flow opcodes while set
+	u32 jams;
+	u16 jam_pc;
+
+	void Update_Observers();
+	void Restart_Samples();
+	void Observe(u16 op_pc);
+	void Observe_Interrupt(CPU_FLOW kind, u16 int_pc, u8 int_cycles);
+	void Cover(u16 from);
 };
 
 
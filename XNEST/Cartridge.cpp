@@ -0,0 +1,179 @@
+//=========================================================================================================|
+// Cartridge.cpp
+//	iNES and raw binary loading; see Cartridge.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdio>
+#include <cstring>
+
+#include "Cartridge.h"
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Reads the whole of path into out; false if it can't be opened.
+ */
+static bool Read_File(const char* path, std::vector<u8>& out)
+{
+	FILE* fp = fopen(path, "rb");
+	if (!fp)
+		return false;
+
+	out.clear();
+	u8 chunk[4096];
+	size_t n;
+	while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+		out.insert(out.end(), chunk, chunk + n);
+
+	fclose(fp);
+	return true;
+} // end Read_File
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; nothing loaded.
+ */
+Cartridge::Cartridge()
+	:mapper{ 0 }, mirroring{ MIRROR_HORIZONTAL }, bbattery{ false }, braw{ false }, load_addr{ 0 }
+{
+
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+Cartridge::~Cartridge()
+{
+
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Loads an iNES file. Returns false (and sets Error()) when it's not one, it's cut short, or it needs a
+ *	mapper we don't have.
+ */
+bool Cartridge::Load(const char* path)
+{
+	std::vector<u8> file;
+	if (!Read_File(path, file))
+	{
+		error = std::string("can't open ") + path;
+		return false;
+	} // end if
+
+	if (file.size() < INES_HEADER_SIZE || memcmp(file.data(), "NES\x1A", 4))
+	{
+		error = std::string(path) + " is not an iNES file";
+		return false;
+	} // end if
+
+	const u8* h = file.data();
+	size_t prg_size = h[4] * (size_t)INES_PRG_UNIT;
+	size_t chr_size = h[5] * (size_t)INES_CHR_UNIT;
+
+	mapper = (h[6] >> 4) | (h[7] & 0xF0);
+	if ((h[7] & 0x0C) == 0x08)
+		mapper |= (h[8] & 0x0F) << 8;		// NES 2.0 adds four more bits
+
+	mirroring = (h[6] & 0x08) ? MIRROR_FOUR_SCREEN : (h[6] & 0x01) ? MIRROR_VERTICAL : MIRROR_HORIZONTAL;
+	bbattery = (h[6] & 0x02) != 0;
+
+	size_t offset = INES_HEADER_SIZE + ((h[6] & 0x04) ? INES_TRAINER_SIZE : 0);
+	if (prg_size == 0 || file.size() < offset + prg_size + chr_size)
+	{
+		error = std::string(path) + " is truncated";
+		return false;
+	} // end if
+
+	if (mapper != 0 || prg_size > 2 * INES_PRG_UNIT)
+	{
+		char buf[64];
+		snprintf(buf, sizeof(buf), "mapper %u is not supported", mapper);
+		error = buf;
+		return false;
+	} // end if
+
+	prg.assign(file.begin() + offset, file.begin() + offset + prg_size);
+	chr.assign(file.begin() + offset + prg_size, file.begin() + offset + prg_size + chr_size);
+	braw = false;
+	error.clear();
+	return true;
+} // end Load
+
+
+//=========================================================================================================|
+/**
+ * Loads a plain binary that goes to load_addr as is; test roms and the like. Anything running past $FFFF
+ *	is dropped.
+ */
+bool Cartridge::Load_Raw(const char* path, u16 addr)
+{
+	if (!Read_File(path, prg))
+	{
+		error = std::string("can't open ") + path;
+		return false;
+	} // end if
+
+	if (prg.size() > (size_t)(RAM_SIZE - addr))
+		prg.resize(RAM_SIZE - addr);
+
+	chr.clear();
+	mapper = 0;
+	braw = true;
+	load_addr = addr;
+	error.clear();
+	return true;
+} // end Load_Raw
+
+
+//=========================================================================================================|
+/**
+ * Maps the cartridge into the bus. Call before Bus::Reset so the cpu picks up the reset vector.
+ */
+void Cartridge::Insert(Bus& bus) const
+{
+	if (braw)
+	{
+		memcpy(bus.ram + load_addr, prg.data(), prg.size());
+		bus.rom_start = RAM_SIZE;		// raw images may write wherever they please
+		return;
+	} // end if
+
+	// NROM: 32K fills $8000-$FFFF, 16K shows up twice
+	memcpy(bus.ram + 0x8000, prg.data(), prg.size());
+	if (prg.size() == INES_PRG_UNIT)
+		memcpy(bus.ram + 0xC000, prg.data(), prg.size());
+
+	bus.rom_start = 0x8000;
+} // end Insert
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,104 @@
+//=========================================================================================================|
+// Cartridge.h
+//	Loads a game off disk. Understands iNES (and the NES 2.0 flavour of the header, as far as mapper 0 goes)
+//	and raw binaries that are dropped into memory at a given address.
+//
+//	The bus is still a flat 64K of RAM, so "inserting" a cartridge means copying its PRG ROM into $8000-$FFFF
+//	(16K carts get mirrored into $C000) and asking the bus to ignore writes up there. That's exactly NROM,
+//	i.e. mapper 0; anything with bank switching is refused until there's a mapper interface to hang it on.
+//	CHR ROM is kept around for when there is a PPU to read it.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef CARTRIDGE_H
+#define CARTRIDGE_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define INES_HEADER_SIZE	16
+#define INES_TRAINER_SIZE	512
+#define INES_PRG_UNIT		16384
+#define INES_CHR_UNIT		8192
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+
+
+enum MIRRORING
+{
+	MIRROR_HORIZONTAL,
+	MIRROR_VERTICAL,
+	MIRROR_FOUR_SCREEN
+};
+
+
+class Bus;
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class Cartridge
+{
+public:
+
+	Cartridge();
+	~Cartridge();
+
+	bool Load(const char* path);
+	bool Load_Raw(const char* path, u16 load_addr);
+	void Insert(Bus& bus) const;
+
+	const std::string& Error() const { return error; }
+	u16 Mapper() const { return mapper; }
+	MIRRORING Mirroring() const { return mirroring; }
+	bool Battery() const { return bbattery; }
+	size_t Prg_Size() const { return prg.size(); }
+	size_t Chr_Size() const { return chr.size(); }
+
+private:
+
+	std::vector<u8> prg;
+	std::vector<u8> chr;
+	u16 mapper;
+	MIRRORING mirroring;
+	bool bbattery;
+
+	bool braw;				// prg is a plain binary going to load_addr, not a cartridge
+	u16 load_addr;
+
+	std::string error;		// why the last Load failed
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,401 @@
+//=========================================================================================================|
+// Condition.cpp
+//	The expression compiler and the stack machine that runs what it makes; see Condition.h.
+//
+//	The parser is plain recursive descent, one function per precedence level, and writes code as it goes:
+//	operands are pushed as they're met and each operator comes out after both its operands, i.e. the code
+//	is the expression in reverse Polish. && and || don't short circuit; nothing in an expression has side
+//	effects, so evaluating both sides costs a few bytes of code and changes nothing.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include "Condition.h"
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define COND_LEVELS		10			// binary precedence levels, || (0) to * / % (9)
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+// the binary operators, by precedence level; longer spellings first so "<<" isn't taken for "<"
+static const struct
+{
+	int level;
+	const char* text;
+	u8 op;
+} OPERATORS[] =
+{
+	{ 0, "||", COND_LOR },
+	{ 1, "&&", COND_LAND },
+	{ 2, "|", COND_BOR },
+	{ 3, "^", COND_XOR },
+	{ 4, "&", COND_BAND },
+	{ 5, "==", COND_EQ }, { 5, "!=", COND_NE },
+	{ 6, "<=", COND_LE }, { 6, ">=", COND_GE }, { 6, "<", COND_LT }, { 6, ">", COND_GT },
+	{ 7, "<<", COND_SHL }, { 7, ">>", COND_SHR },
+	{ 8, "+", COND_ADD }, { 8, "-", COND_SUB },
+	{ 9, "*", COND_MUL }, { 9, "/", COND_DIV }, { 9, "%", COND_MOD }
+};
+
+
+// the names an operand can go by; flags carry their bit in P
+static const struct
+{
+	const char* name;
+	u8 op;
+	u8 bit;
+} NAMES[] =
+{
+	{ "A", COND_A, 0 }, { "X", COND_X, 0 }, { "Y", COND_Y, 0 },
+	{ "SP", COND_SP, 0 }, { "P", COND_P, 0 }, { "PC", COND_PC, 0 },
+	{ "N", COND_FLAG, N }, { "V", COND_FLAG, V }, { "D", COND_FLAG, D },
+	{ "I", COND_FLAG, I }, { "Z", COND_FLAG, Z }, { "C", COND_FLAG, C },
+	{ "CYCLES", COND_CYCLES, 0 }, { "FRAME", COND_FRAME, 0 }, { "DATA", COND_DATA, 0 }
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; an empty condition, which is always true as far as Breakpoints goes.
+ */
+Condition::Condition()
+	:src{ nullptr }, depth{ 0 }
+{
+
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+Condition::~Condition()
+{
+
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Compiles expr, replacing whatever was there. On a syntax error nothing is kept and Error() says where.
+ */
+bool Condition::Compile(const char* expr)
+{
+	code.clear();
+	error.clear();
+	text = expr;
+	src = text.c_str();
+	depth = 0;
+
+	bool bok = Parse_Binary(0);
+	Skip_Spaces();
+	if (bok && *src)
+		bok = Fail("expected an operator");
+	if (bok)
+		bok = Emit(COND_END, 0);
+
+	if (!bok)
+	{
+		code.clear();
+		text.clear();
+	} // end if
+
+	src = nullptr;
+	return bok;
+} // end Compile
+
+
+//=========================================================================================================|
+/**
+ * Back to empty.
+ */
+void Condition::Clear()
+{
+	code.clear();
+	text.clear();
+	error.clear();
+} // end Clear
+
+
+//=========================================================================================================|
+/**
+ * Runs the code against bus (its cpu, clock and memory); data is the byte moved, for watchpoints. An
+ *	empty condition is 1.
+ */
+s64 Condition::Evaluate(const Bus& bus, u8 data) const
+{
+	if (code.empty())
+		return 1;
+
+	const CPU6502& cpu = bus.cpu6502;
+	s64 stack[COND_STACK];
+	int top = -1;
+
+	for (const u8* ip = code.data(); ; )
+	{
+		switch (*ip++)
+		{
+		case COND_END: return stack[0];
+
+		case COND_CONST: memcpy(&stack[++top], ip, sizeof(s64)); ip += sizeof(s64); break;
+		case COND_A: stack[++top] = cpu.A(); break;
+		case COND_X: stack[++top] = cpu.X(); break;
+		case COND_Y: stack[++top] = cpu.Y(); break;
+		case COND_SP: stack[++top] = cpu.Sp(); break;
+		case COND_P: stack[++top] = cpu.Status(); break;
+		case COND_PC: stack[++top] = cpu.Pc(); break;
+		case COND_FLAG: stack[++top] = (cpu.Status() & *ip++) != 0; break;
+		case COND_CYCLES: stack[++top] = (s64)bus.system_clock; break;
+		case COND_FRAME: stack[++top] = (s64)bus.frame_count; break;
+		case COND_DATA: stack[++top] = data; break;
+		case COND_PEEK: stack[top] = bus.Peek((u16)stack[top]); break;
+
+		case COND_NEG: stack[top] = -stack[top]; break;
+		case COND_NOT: stack[top] = !stack[top]; break;
+		case COND_INV: stack[top] = ~stack[top]; break;
+
+		case COND_MUL: top--; stack[top] *= stack[top + 1]; break;
+		case COND_DIV: top--; stack[top] = stack[top + 1] ? stack[top] / stack[top + 1] : 0; break;
+		case COND_MOD: top--; stack[top] = stack[top + 1] ? stack[top] % stack[top + 1] : 0; break;
+		case COND_ADD: top--; stack[top] += stack[top + 1]; break;
+		case COND_SUB: top--; stack[top] -= stack[top + 1]; break;
+		case COND_SHL: top--; stack[top] = (s64)((u64)stack[top] << (stack[top + 1] & 63)); break;
+		case COND_SHR: top--; stack[top] >>= (stack[top + 1] & 63); break;
+		case COND_LT: top--; stack[top] = stack[top] < stack[top + 1]; break;
+		case COND_LE: top--; stack[top] = stack[top] <= stack[top + 1]; break;
+		case COND_GT: top--; stack[top] = stack[top] > stack[top + 1]; break;
+		case COND_GE: top--; stack[top] = stack[top] >= stack[top + 1]; break;
+		case COND_EQ: top--; stack[top] = stack[top] == stack[top + 1]; break;
+		case COND_NE: top--; stack[top] = stack[top] != stack[top + 1]; break;
+		case COND_BAND: top--; stack[top] &= stack[top + 1]; break;
+		case COND_XOR: top--; stack[top] ^= stack[top + 1]; break;
+		case COND_BOR: top--; stack[top] |= stack[top + 1]; break;
+		case COND_LAND: top--; stack[top] = stack[top] && stack[top + 1]; break;
+		case COND_LOR: top--; stack[top] = stack[top] || stack[top + 1]; break;
+
+		default: return 0;		// can't happen with code out of Compile
+		} // end switch
+	} // end for
+} // end Evaluate
+
+
+//=========================================================================================================|
+/**
+ * One precedence level: operands from the level above, joined by this level's operators, left to right.
+ */
+bool Condition::Parse_Binary(int level)
+{
+	if (level == COND_LEVELS)
+		return Parse_Unary();
+
+	if (!Parse_Binary(level + 1))
+		return false;
+
+	u8 op;
+	int len;
+	while ((len = Match_Operator(level, op)) > 0)
+	{
+		src += len;
+		if (!Parse_Binary(level + 1) || !Emit(op, -1))
+			return false;
+	} // end while
+
+	return true;
+} // end Parse_Binary
+
+
+//=========================================================================================================|
+/**
+ * ! ~ and - in front of an operand.
+ */
+bool Condition::Parse_Unary()
+{
+	Skip_Spaces();
+
+	u8 op;
+	switch (*src)
+	{
+	case '!': op = COND_NOT; break;
+	case '~': op = COND_INV; break;
+	case '-': op = COND_NEG; break;
+	default: return Parse_Primary();
+	} // end switch
+
+	src++;
+	return Parse_Unary() && Emit(op, 0);
+} // end Parse_Unary
+
+
+//=========================================================================================================|
+/**
+ * A number, a name, (expr) or [expr].
+ */
+bool Condition::Parse_Primary()
+{
+	Skip_Spaces();
+
+	if (*src == '(' || *src == '[')
+	{
+		char close = *src == '(' ? ')' : ']';
+		src++;
+		if (!Parse_Binary(0))
+			return false;
+
+		Skip_Spaces();
+		if (*src != close)
+			return Fail(close == ')' ? "expected )" : "expected ]");
+		src++;
+		return close == ')' || Emit(COND_PEEK, 0);
+	} // end if
+
+	if (isdigit((u8)*src) || *src == '$' || (*src == '.' && isdigit((u8)src[1])))
+	{
+		s64 value;
+		char* end;
+		if (*src == '$')
+		{
+			value = (s64)strtoull(src + 1, &end, 16);
+			if (end == src + 1)
+				return Fail("expected hex digits");
+		} // end if
+		else if (src[0] == '0' && (src[1] == 'x' || src[1] == 'X'))
+			value = (s64)strtoull(src + 2, &end, 16);
+		else
+		{
+			value = (s64)strtoull(src, &end, 10);
+			if (*end == '.' || *end == 'e' || *end == 'E')
+				value = (s64)strtod(src, &end);		// 1e6 and the like
+		} // end else
+
+		src = end;
+		if (!Emit(COND_CONST, 1))
+			return false;
+		code.resize(code.size() + sizeof(s64));
+		memcpy(&code[code.size() - sizeof(s64)], &value, sizeof(s64));
+		return true;
+	} // end if
+
+	if (isalpha((u8)*src) || *src == '_')
+	{
+		std::string name;
+		while (isalnum((u8)*src) || *src == '_')
+			name += (char)toupper((u8)*src++);
+
+		for (const auto& n : NAMES)
+		{
+			if (name == n.name)
+			{
+				if (!Emit(n.op, 1))
+					return false;
+				if (n.op == COND_FLAG)
+					code.push_back(n.bit);
+				return true;
+			} // end if
+		} // end for
+
+		src -= name.size();
+		return Fail("unknown name");
+	} // end if
+
+	return Fail(*src ? "expected a value" : "expression ends early");
+} // end Parse_Primary
+
+
+//=========================================================================================================|
+/**
+ * Is there an operator of level next? Returns its length (0 for no) and the op.
+ */
+int Condition::Match_Operator(int level, u8& op)
+{
+	Skip_Spaces();
+
+	for (const auto& o : OPERATORS)
+	{
+		size_t len = strlen(o.text);
+		if (o.level != level || strncmp(src, o.text, len))
+			continue;
+
+		// don't take the first half of a longer operator from another level; "&" out of "&&", "<" out of "<<".
+		// Only those that have a longer form, mind: "A--1" is A minus -1
+		char next = src[len];
+		bool blonger = next == o.text[0] || ((*src == '<' || *src == '>') && next == '=');
+		if (len == 1 && strchr("&|<>=", *src) && blonger)
+			return 0;
+
+		op = o.op;
+		return (int)len;
+	} // end for
+
+	return 0;
+} // end Match_Operator
+
+
+//=========================================================================================================|
+/**
+ * Appends op, keeping track of how deep the stack gets when it runs.
+ */
+bool Condition::Emit(u8 op, int stack_change)
+{
+	depth += stack_change;
+	if (depth > COND_STACK)
+		return Fail("expression nests too deep");
+
+	code.push_back(op);
+	return true;
+} // end Emit
+
+
+//=========================================================================================================|
+/**
+ * Steps over white space.
+ */
+void Condition::Skip_Spaces()
+{
+	while (isspace((u8)*src))
+		src++;
+} // end Skip_Spaces
+
+
+//=========================================================================================================|
+/**
+ * Sets Error() to what, with where in the text it went wrong; returns false to pass on up.
+ */
+bool Condition::Fail(const char* what)
+{
+	if (error.empty())
+		error = std::string(what) + " at column " + std::to_string(src - text.c_str() + 1) + " of \"" + text + "\"";
+	return false;
+} // end Fail
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
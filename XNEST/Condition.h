@@ -0,0 +1,131 @@
+//=========================================================================================================|
+// Condition.h
+//	Breakpoint conditions written as expressions, e.g.
+//
+//		A == $40 && [$00FF] > 3 && cycles > 1e6
+//
+//	Compile() parses the text once into a few bytes of postfix code; Evaluate() runs that on a little stack
+//	machine against the cpu's registers and the bus' memory. No strings, no allocations and no calls per
+//	node when it runs, which is what lets a condition sit on a pc that's hit millions of times.
+//
+//	What an expression can be made of:
+//		numbers		42, $2A, 0x2A, 1e6 (anything strtod takes; fractions are cut off)
+//		registers	A X Y SP P PC
+//		flags		N V D I Z C; 0 or 1, out of P
+//		cycles		the system clock
+//		frame		frames run since reset
+//		data		the byte read or written, for watchpoints (0 otherwise)
+//		[expr]		the byte at expr
+//		operators	as in C, with C's precedence: ( ) ! ~ - * / % + - << >> < <= > >= == != & ^ | && ||
+//
+//	Names go in any case. Everything is worked out in 64-bit signed integers; division by 0 gives 0.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef CONDITION_H
+#define CONDITION_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define COND_STACK		32			// deepest the evaluation stack may get; deeper expressions don't compile
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint64_t u64;
+typedef int64_t s64;
+
+
+// the instruction set of the stack machine; all but COND_CONST and COND_FLAG are a single byte
+enum COND_OP
+{
+	COND_END,
+	COND_CONST,			// followed by 8 bytes of value, little endian
+	COND_A, COND_X, COND_Y, COND_SP, COND_P, COND_PC,
+	COND_FLAG,			// followed by the flag's bit in P
+	COND_CYCLES, COND_FRAME, COND_DATA,
+	COND_PEEK,			// top = [top]
+	COND_NEG, COND_NOT, COND_INV,
+	COND_MUL, COND_DIV, COND_MOD,
+	COND_ADD, COND_SUB,
+	COND_SHL, COND_SHR,
+	COND_LT, COND_LE, COND_GT, COND_GE,
+	COND_EQ, COND_NE,
+	COND_BAND, COND_XOR, COND_BOR,
+	COND_LAND, COND_LOR
+};
+
+
+class Bus;
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class Condition
+{
+public:
+
+	Condition();
+	~Condition();
+
+	bool Compile(const char* expr);
+	void Clear();
+
+	bool Empty() const { return code.empty(); }
+	s64 Evaluate(const Bus& bus, u8 data) const;
+	bool Test(const Bus& bus, u8 data) const { return Evaluate(bus, data) != 0; }
+
+	const std::string& Text() const { return text; }
+	const std::string& Error() const { return error; }
+	size_t Code_Size() const { return code.size(); }
+
+private:
+
+	std::vector<u8> code;
+	std::string text;
+	std::string error;			// why the last Compile failed
+
+	// parser state; only used inside Compile
+	const char* src;
+	int depth;
+
+	bool Parse_Binary(int level);
+	bool Parse_Unary();
+	bool Parse_Primary();
+	int Match_Operator(int level, u8& op);
+	bool Emit(u8 op, int stack_change);
+	void Skip_Spaces();
+	bool Fail(const char* what);
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
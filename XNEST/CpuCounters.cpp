@@ -0,0 +1,136 @@
+//=========================================================================================================|
+// CpuCounters.cpp
+//	CSV and JSON writers for the cpu's execution counters.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdio>
+#include <cstring>
+
+#include "CpuCounters.h"
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Opens path for writing when there are counters to write; complains and returns nullptr otherwise.
+ */
+static FILE* Open_For(const CPU6502& cpu, const char* path)
+{
+	if (!cpu.Counters())
+	{
+		fprintf(stderr, "cpu counters are not compiled in; rebuild with XNEST_CPU_STATS=1\n");
+		return nullptr;
+	} // end if
+
+	FILE* fp = fopen(path, "w");
+	if (!fp)
+		fprintf(stderr, "can't write %s\n", path);
+	return fp;
+} // end Open_For
+
+
+//=========================================================================================================|
+/**
+ * One table, one row per thing counted; the kind column says which section a row belongs to.
+ */
+bool Write_Counters_Csv(const CPU6502& cpu, const char* path)
+{
+	FILE* fp = Open_For(cpu, path);
+	if (!fp)
+		return false;
+
+	const CPU_COUNTERS& c = *cpu.Counters();
+	fprintf(fp, "kind,opcode,name,mode,exec,cycles,page_cross\n");
+
+	for (int op = 0; op < 256; op++)
+	{
+		OPCODE_INFO info;
+		cpu.Get_Opcode_Info((u8)op, info);
+		fprintf(fp, "opcode,0x%02X,%s,%s,%llu,%llu,\n", op, info.name, CPU6502::Mode_Name(info.mode),
+			(unsigned long long)c.op_exec[op], (unsigned long long)c.op_cycles[op]);
+	} // end for
+
+	for (int m = 0; m < AM_COUNT; m++)
+		fprintf(fp, "mode,,,%s,%llu,%llu,%llu\n", CPU6502::Mode_Name((u8)m),
+			(unsigned long long)c.mode_exec[m], (unsigned long long)c.mode_cycles[m],
+			(unsigned long long)c.page_cross[m]);
+
+	fprintf(fp, "branch,,all,REL,%llu,,\n", (unsigned long long)c.branches);
+	fprintf(fp, "branch,,taken,REL,%llu,,%llu\n", (unsigned long long)c.branches_taken,
+		(unsigned long long)c.branch_page_cross);
+
+	fclose(fp);
+	return true;
+} // end Write_Counters_Csv
+
+
+//=========================================================================================================|
+/**
+ * The same numbers as a JSON object of three sections.
+ */
+bool Write_Counters_Json(const CPU6502& cpu, const char* path)
+{
+	FILE* fp = Open_For(cpu, path);
+	if (!fp)
+		return false;
+
+	const CPU_COUNTERS& c = *cpu.Counters();
+	fprintf(fp, "{\n  \"opcodes\": [\n");
+	for (int op = 0; op < 256; op++)
+	{
+		OPCODE_INFO info;
+		cpu.Get_Opcode_Info((u8)op, info);
+		fprintf(fp, "    { \"opcode\": %d, \"name\": \"%s\", \"mode\": \"%s\", \"exec\": %llu, \"cycles\": %llu }%s\n",
+			op, info.name, CPU6502::Mode_Name(info.mode), (unsigned long long)c.op_exec[op],
+			(unsigned long long)c.op_cycles[op], op < 255 ? "," : "");
+	} // end for
+
+	fprintf(fp, "  ],\n  \"modes\": [\n");
+	for (int m = 0; m < AM_COUNT; m++)
+		fprintf(fp, "    { \"mode\": \"%s\", \"exec\": %llu, \"cycles\": %llu, \"page_cross\": %llu }%s\n",
+			CPU6502::Mode_Name((u8)m), (unsigned long long)c.mode_exec[m],
+			(unsigned long long)c.mode_cycles[m], (unsigned long long)c.page_cross[m],
+			m < AM_COUNT - 1 ? "," : "");
+
+	fprintf(fp, "  ],\n  \"branches\": { \"exec\": %llu, \"taken\": %llu, \"page_cross\": %llu }\n}\n",
+		(unsigned long long)c.branches, (unsigned long long)c.branches_taken,
+		(unsigned long long)c.branch_page_cross);
+
+	fclose(fp);
+	return true;
+} // end Write_Counters_Json
+
+
+//=========================================================================================================|
+/**
+ * JSON for *.json, CSV for the rest.
+ */
+bool Write_Counters(const CPU6502& cpu, const char* path)
+{
+	size_t len = strlen(path);
+	if (len >= 5 && !strcmp(path + len - 5, ".json"))
+		return Write_Counters_Json(cpu, path);
+	return Write_Counters_Csv(cpu, path);
+} // end Write_Counters
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
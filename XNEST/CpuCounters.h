@@ -0,0 +1,42 @@
+//=========================================================================================================|
+// CpuCounters.h
+//	Dumps the cpu's execution counters (CPU_COUNTERS, see CPU6502.h) as CSV or JSON; per opcode, per
+//	addressing mode, page cross penalties and branches. The counters only exist in builds made with
+//	XNEST_CPU_STATS=1; everywhere else these just say so and return false.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef CPUCOUNTERS_H
+#define CPUCOUNTERS_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include "CPU6502.h"
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+bool Write_Counters_Csv(const CPU6502& cpu, const char* path);
+bool Write_Counters_Json(const CPU6502& cpu, const char* path);
+
+// picks one of the two by the extension; .json or anything else for CSV
+bool Write_Counters(const CPU6502& cpu, const char* path);
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
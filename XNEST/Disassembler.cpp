@@ -0,0 +1,237 @@
+//=========================================================================================================|
+// Disassembler.cpp
+//	Decoding and formatting of 6502 instructions; see Disassembler.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include "Disassembler.h"
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+static const char HEX[] = "0123456789ABCDEF";
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Two hex digits of v at p; returns past them.
+ */
+static inline char* Hex2(char* p, u8 v)
+{
+	p[0] = HEX[v >> 4];
+	p[1] = HEX[v & 0x0F];
+	return p + 2;
+} // end Hex2
+
+
+//=========================================================================================================|
+/**
+ * Four hex digits of v at p.
+ */
+static inline char* Hex4(char* p, u16 v)
+{
+	return Hex2(Hex2(p, v >> 8), v & 0xFF);
+} // end Hex4
+
+
+//=========================================================================================================|
+/**
+ * Copies the nul terminated s to p; returns past it (not past the nul).
+ */
+static inline char* Copy(char* p, const char* s)
+{
+	while (*s)
+		*p++ = *s++;
+	return p;
+} // end Copy
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; copies the cpu's opcode table out once, so decoding is an array index.
+ */
+Disassembler::Disassembler(const Bus& bus)
+	:pbus{ &bus }
+{
+	for (int op = 0; op < 256; op++)
+		bus.cpu6502.Get_Opcode_Info((u8)op, info[op]);
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+Disassembler::~Disassembler()
+{
+
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Decodes the instruction whose bytes are at code (opcode first; up to two more are looked at, and only if
+ *	the instruction has them), as if it sat at addr. For bytes that didn't come out of memory: traces,
+ *	patches. Returns the address of the next instruction.
+ */
+u16 Disassembler::Decode(u16 addr, const u8* code, DISASM_LINE& line) const
+{
+	const OPCODE_INFO& oi = info[code[0]];
+
+	line.addr = addr;
+	line.opcode = code[0];
+	line.bytes = oi.bytes;
+	line.mode = oi.mode;
+	line.name = oi.name;
+	line.operand[0] = oi.bytes > 1 ? code[1] : 0;
+	line.operand[1] = oi.bytes > 2 ? code[2] : 0;
+
+	switch (oi.mode)
+	{
+	case AM_IMP: line.value = 0; break;
+	case AM_REL: line.value = (u16)(addr + 2 + (int8_t)line.operand[0]); break;
+	default: line.value = line.operand[0] | (line.operand[1] << 8); break;
+	} // end switch
+
+	return (u16)(addr + oi.bytes);
+} // end Decode
+
+
+//=========================================================================================================|
+/**
+ * Disassembles count instructions one after the other from addr into out, wrapping from $FFFF to $0000.
+ *	Returns count; out has to have room for that many.
+ */
+size_t Disassembler::Disassemble(u16 addr, size_t count, DISASM_LINE* out) const
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		u8 code[3];
+		pbus->Peek_Copy(addr, code, 3);
+		addr = Decode(addr, code, out[i]);
+	} // end for
+
+	return count;
+} // end Disassemble
+
+
+//=========================================================================================================|
+/**
+ * Disassembles from..to (inclusive) into out, stopping early after max lines. An instruction that starts
+ *	in the range is decoded whole, even if its operand runs past to. Returns the lines written; 64K of
+ *	one byte instructions is the most there can be.
+ */
+size_t Disassembler::Disassemble_Range(u16 from, u16 to, DISASM_LINE* out, size_t max) const
+{
+	size_t n = 0;
+	u32 addr = from;		// kept past $FFFF so the loop ends there rather than wrapping
+
+	while (addr <= to && n < max)
+	{
+		// straight out of the span while a whole instruction fits in it ...
+		PEEK_SPAN span = pbus->Peek_Range((u16)addr, RAM_SIZE - addr);
+		const u8* base = span.data - addr;
+		u32 fast_end = span.size > 2 ? addr + span.size - 2 : addr;
+		if (fast_end > (u32)to + 1)
+			fast_end = (u32)to + 1;
+
+		for (; addr < fast_end && n < max; n++)
+		{
+			Decode((u16)addr, base + addr, out[n]);
+			addr += out[n].bytes;
+		} // end for
+
+		// ... then one at a time across the registers and the top of memory
+		if (addr >= fast_end && addr <= to && n < max)
+		{
+			u8 code[3];
+			pbus->Peek_Copy((u16)addr, code, 3);
+			Decode((u16)addr, code, out[n]);
+			addr += out[n++].bytes;
+		} // end if
+	} // end while
+
+	return n;
+} // end Disassemble_Range
+
+
+//=========================================================================================================|
+/**
+ * The instruction as text, e.g. "LDA $0200,X" or "BNE $C00C", into out (DISASM_TEXT chars). Returns the
+ *	length. The spelling is nestest's, which is also what TraceConv writes.
+ */
+size_t Disassembler::Format(const DISASM_LINE& line, char* out)
+{
+	char* p = Copy(out, line.name);
+	u8 lo = line.operand[0];
+
+	switch (line.mode)
+	{
+	case AM_IMP:
+		// the shifts and rotates on the accumulator spell it out
+		if (line.opcode == 0x0A || line.opcode == 0x2A || line.opcode == 0x4A || line.opcode == 0x6A)
+			p = Copy(p, " A");
+		break;
+
+	case AM_IMM: p = Hex2(Copy(p, " #$"), lo); break;
+	case AM_ZP0: p = Hex2(Copy(p, " $"), lo); break;
+	case AM_ZPX: p = Copy(Hex2(Copy(p, " $"), lo), ",X"); break;
+	case AM_ZPY: p = Copy(Hex2(Copy(p, " $"), lo), ",Y"); break;
+	case AM_REL:
+	case AM_ABS: p = Hex4(Copy(p, " $"), line.value); break;
+	case AM_ABX: p = Copy(Hex4(Copy(p, " $"), line.value), ",X"); break;
+	case AM_ABY: p = Copy(Hex4(Copy(p, " $"), line.value), ",Y"); break;
+	case AM_IND: p = Copy(Hex4(Copy(p, " ($"), line.value), ")"); break;
+	case AM_IZX: p = Copy(Hex2(Copy(p, " ($"), lo), ",X)"); break;
+	case AM_IZY: p = Copy(Hex2(Copy(p, " ($"), lo), "),Y"); break;
+	} // end switch
+
+	*p = 0;
+	return p - out;
+} // end Format
+
+
+//=========================================================================================================|
+/**
+ * The instruction's bytes as hex, e.g. "BD 00 02", into out (at least 9 chars). Returns the length.
+ */
+size_t Disassembler::Format_Bytes(const DISASM_LINE& line, char* out)
+{
+	char* p = Hex2(out, line.opcode);
+	for (int i = 0; i < line.bytes - 1; i++)
+	{
+		*p++ = ' ';
+		p = Hex2(p, line.operand[i]);
+	} // end for
+
+	*p = 0;
+	return p - out;
+} // end Format_Bytes
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
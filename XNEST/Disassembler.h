@@ -0,0 +1,94 @@
+//=========================================================================================================|
+// Disassembler.h
+//	Turns 6502 machine code back into mnemonics, for debugger views, listings and trace post-processing.
+//
+//	Nothing here allocates. Lines go into an array the caller owns (DISASM_LINE, a few bytes each, with the
+//	operand already worked out per addressing mode) and Format() makes text of one into a char buffer
+//	without going near printf, so whole listings can be made and thrown away every frame. Decoding a line
+//	is a table lookup and two byte reads; all 64K disassembles in well under a millisecond.
+//
+//	Memory is looked at through the bus' Peek_Range and Peek; reading it here never touches a register, so
+//	pointing a disassembly at $4016 doesn't shift a controller. The opcode table (names, modes, lengths) is
+//	the cpu's own, so the two can't disagree.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef DISASSEMBLER_H
+#define DISASSEMBLER_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdint>
+#include <cstddef>
+
+#include "CPU6502.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define DISASM_TEXT		16			// room Format() needs, terminator included; "LDA ($12),Y" is 11
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// one decoded instruction
+struct DISASM_LINE
+{
+	u16 addr;
+	u8 opcode;
+	u8 operand[2];		// as many as the instruction has; the rest are 0
+	u8 bytes;			// 1 to 3
+	u8 mode;			// ADDRMODE
+	const char* name;	// mnemonic, out of the cpu's table
+	u16 value;			// operand resolved: the byte for IMM/ZP modes, the word for ABS ones, the branch
+						// destination for REL, 0 for IMP
+};
+
+
+class Bus;
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class Disassembler
+{
+public:
+
+	Disassembler(const Bus& bus);
+	~Disassembler();
+
+	u16 Decode(u16 addr, const u8* code, DISASM_LINE& line) const;
+	size_t Disassemble(u16 addr, size_t count, DISASM_LINE* out) const;
+	size_t Disassemble_Range(u16 from, u16 to, DISASM_LINE* out, size_t max) const;
+
+	static size_t Format(const DISASM_LINE& line, char* out);
+	static size_t Format_Bytes(const DISASM_LINE& line, char* out);
+
+private:
+
+	const Bus* pbus;
+	OPCODE_INFO info[256];
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
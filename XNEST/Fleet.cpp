@@ -0,0 +1,246 @@
+//=========================================================================================================|
+// Fleet.cpp
+//	The worker pool and its jobs; see Fleet.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstring>
+
+#include "Fleet.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FNV_OFFSET		0xCBF29CE484222325ull
+#define FNV_PRIME		0x100000001B3ull
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * FNV-1a over len bytes, continuing from h.
+ */
+static u64 Hash(u64 h, const void* data, size_t len)
+{
+	const u8* p = (const u8*)data;
+	for (size_t i = 0; i < len; i++)
+		h = (h ^ p[i]) * FNV_PRIME;
+	return h;
+} // end Hash
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; makes the workers and their machines, which then wait for a batch.
+ */
+Fleet::Fleet(u32 count)
+	:batch{ 0 }, running{ 0 }, bquit{ false }, jobs{ nullptr }, results{ nullptr }, steals{ 0 }
+{
+	if (!count)
+		count = std::thread::hardware_concurrency();
+	if (!count)
+		count = 1;
+
+	for (u32 i = 0; i < count; i++)
+	{
+		workers.emplace_back(new WORKER);
+		workers.back()->bus.reset(new Bus);
+		workers.back()->head = workers.back()->tail = 0;
+	} // end for
+
+	for (u32 i = 0; i < count; i++)
+		workers[i]->thread = std::thread(&Fleet::Worker, this, i);
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor; tells the workers to quit and waits for them.
+ */
+Fleet::~Fleet()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		bquit = true;
+	}
+	wake.notify_all();
+
+	for (auto& w : workers)
+		w->thread.join();
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Runs count jobs, results[i] for jobs[i], and returns once they're all done. One batch at a time.
+ */
+void Fleet::Run(const FLEET_JOB* jobs, FLEET_RESULT* results, u32 count)
+{
+	if (!count)
+		return;
+
+	// even contiguous shares, the first count % workers one bigger
+	u32 n = Workers();
+	order.resize(count);
+	for (u32 i = 0; i < count; i++)
+		order[i] = i;
+
+	u32 start = 0;
+	for (u32 i = 0; i < n; i++)
+	{
+		u32 share = count / n + (i < count % n ? 1 : 0);
+		std::lock_guard<std::mutex> guard(workers[i]->lock);
+		workers[i]->head = start;
+		workers[i]->tail = start + share;
+		start += share;
+	} // end for
+
+	std::unique_lock<std::mutex> guard(lock);
+	this->jobs = jobs;
+	this->results = results;
+	running = n;
+	batch++;
+	wake.notify_all();
+
+	idle.wait(guard, [this] { return running == 0; });
+} // end Run
+
+
+//=========================================================================================================|
+/**
+ * A worker's life: wait for a batch, run jobs until there are none left anywhere, report in, repeat.
+ */
+void Fleet::Worker(u32 id)
+{
+	u64 seen = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [&] { return bquit || batch != seen; });
+			if (bquit)
+				return;
+			seen = batch;
+		}
+
+		u32 job;
+		bool bstolen;
+		u64 stolen = 0;
+		while (Take(id, job, bstolen))
+		{
+			Run_Job(*workers[id], jobs[job], results[job]);
+			results[job].worker = id;
+			results[job].bstolen = bstolen;
+			stolen += bstolen;
+		} // end while
+
+		std::lock_guard<std::mutex> guard(lock);
+		steals += stolen;
+		if (--running == 0)
+			idle.notify_one();
+	} // end for
+} // end Worker
+
+
+//=========================================================================================================|
+/**
+ * The next job for worker id: the back of its own queue, else the front of the first other queue that
+ *	has any. False when every queue is empty, which is the end of the batch for it.
+ */
+bool Fleet::Take(u32 id, u32& job, bool& bstolen)
+{
+	{
+		WORKER& w = *workers[id];
+		std::lock_guard<std::mutex> guard(w.lock);
+		if (w.head < w.tail)
+		{
+			job = order[--w.tail];
+			bstolen = false;
+			return true;
+		} // end if
+	}
+
+	u32 n = Workers();
+	for (u32 i = 1; i < n; i++)
+	{
+		WORKER& v = *workers[(id + i) % n];
+		std::lock_guard<std::mutex> guard(v.lock);
+		if (v.head < v.tail)
+		{
+			job = order[v.head++];
+			bstolen = true;
+			return true;
+		} // end if
+	} // end for
+
+	return false;
+} // end Take
+
+
+//=========================================================================================================|
+/**
+ * One job on worker w's machine, from a clean slate.
+ */
+void Fleet::Run_Job(WORKER& w, const FLEET_JOB& job, FLEET_RESULT& result)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	Bus& bus = *w.bus;
+	memset(bus.ram, 0, RAM_SIZE);
+	memset(bus.controller, 0, sizeof(bus.controller));
+	job.pcart->Insert(bus);
+	bus.Reset();
+
+	u64 audio_hash = FNV_OFFSET;
+	u64 audio_samples = 0;
+	for (u64 f = 0; f < job.frames; f++)
+	{
+		if (job.pinput)
+		{
+			bus.controller[0] = job.pinput->Buttons(f, 0);
+			bus.controller[1] = job.pinput->Buttons(f, 1);
+		} // end if
+		bus.Run_Frame();
+
+		int n;
+		while ((n = bus.apu.Read_Samples(w.audio, FLEET_AUDIO_CHUNK)) > 0)
+		{
+			audio_hash = Hash(audio_hash, w.audio, n * sizeof(s16));
+			audio_samples += n;
+		} // end while
+	} // end for
+
+	result.ram_hash = Hash(FNV_OFFSET, bus.ram, RAM_SIZE);
+	result.audio_hash = audio_hash;
+	result.audio_samples = audio_samples;
+	result.frames = bus.frame_count;
+	result.cycles = bus.system_clock;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+} // end Run_Job
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,135 @@
+//=========================================================================================================|
+// Fleet.h
+//	Runs batches of "this rom, this input script, this many frames" jobs on every core. It is for
+//	regression replays, where thousands of short runs each only need to report a hash.
+//
+//	Each worker thread owns one machine (a Bus with its cpu and apu) and an audio buffer. Both are
+//	allocated when the fleet is made and reused for every job the worker runs. A job wipes the memory,
+//	inserts the cartridge and resets, which puts the machine in the same state a new one would be in.
+//	Running it allocates nothing. A machine is about 110K with its sound buffer, most of it the 64K
+//	address space, so the working set per core is small and the workers share nothing but the read-only
+//	roms and scripts.
+//
+//	Jobs are handed out by work stealing. Each worker starts with an even, contiguous share and takes
+//	jobs from the back of its own queue. A worker whose queue runs dry takes from the front of another's.
+//	Nothing is added while a batch runs, so a worker that finds every queue empty is done. The queues are
+//	short mutex-guarded index ranges; a job is thousands of frames, so the lock is noise next to it.
+//
+//	The hashes in FLEET_RESULT are the same ones Tools/Headless prints, so a fleet result can be checked
+//	against a single run.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef FLEET_H
+#define FLEET_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Bus.h"
+#include "Cartridge.h"
+#include "InputScript.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FLEET_AUDIO_CHUNK	1024		// samples drained from the apu at a time
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// one run; the cartridge and script are shared between jobs and must outlive the batch
+struct FLEET_JOB
+{
+	const Cartridge* pcart;
+	const InputScript* pinput;		// null for no input
+	u64 frames;
+};
+
+
+// what a job came to
+struct FLEET_RESULT
+{
+	u64 ram_hash;				// FNV-1a of the 64K at the end
+	u64 audio_hash;				// FNV-1a of every sample produced
+	u64 audio_samples;
+	u64 frames;
+	u64 cycles;					// cpu cycles run
+	double seconds;
+	u32 worker;					// which worker ran it
+	bool bstolen;				// taken from another worker's queue
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class Fleet
+{
+public:
+
+	Fleet(u32 workers = 0);			// 0 for one per hardware thread
+	~Fleet();
+
+	u32 Workers() const { return (u32)workers.size(); }
+	void Run(const FLEET_JOB* jobs, FLEET_RESULT* results, u32 count);
+
+	u64 Steals() const { return steals; }		// over every batch so far
+
+private:
+
+	struct WORKER
+	{
+		std::thread thread;
+		std::unique_ptr<Bus> bus;
+		s16 audio[FLEET_AUDIO_CHUNK];
+
+		std::mutex lock;			// guards head and tail
+		u32 head, tail;				// its share of order[]; it works from the tail, thieves from the head
+	};
+
+	std::vector<std::unique_ptr<WORKER>> workers;
+	std::vector<u32> order;			// job indices, each worker's share contiguous
+
+	std::mutex lock;				// guards the rest
+	std::condition_variable wake;	// a batch is up, or it's time to quit
+	std::condition_variable idle;	// the last worker has finished the batch
+	u64 batch;						// bumped per batch; workers wait for it to move
+	u32 running;					// workers still on the batch
+	bool bquit;
+
+	const FLEET_JOB* jobs;
+	FLEET_RESULT* results;
+	u64 steals;
+
+	void Worker(u32 id);
+	bool Take(u32 id, u32& job, bool& bstolen);
+	void Run_Job(WORKER& w, const FLEET_JOB& job, FLEET_RESULT& result);
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,424 @@
+//=========================================================================================================|
+// ForkServer.cpp
+//	The fork server; see ForkServer.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifndef _WIN32
+#include <csignal>
+#include <ctime>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "ForkServer.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FNV_OFFSET			0xCBF29CE484222325ull
+#define FNV_PRIME			0x100000001B3ull
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// ahead of each batch on the command pipe; count * frames bytes of input follow. A count of 0 stops
+// the server.
+struct BATCH_HEADER
+{
+	u32 count;
+	u32 frames;
+};
+
+
+// one result on the result pipe; well under PIPE_BUF, so children's writes never interleave
+struct RESULT_MSG
+{
+	u32 index;
+	u32 bok;
+	u64 ram_hash;
+	u64 cycles;
+	u32 page_faults;
+	u32 reserved;
+};
+
+
+
+#ifndef _WIN32
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * All of len bytes to fd, through short writes and signals; false when the other end has gone.
+ *
+ * SIGPIPE is blocked for this thread while it writes, and one the write raised is taken back before it's
+ *	unblocked. So a reader that has gone is a failed write, and the host's own SIGPIPE handling is left
+ *	as it was. One that was already pending before the write stays pending.
+ */
+static bool Write_All(int fd, const void* data, size_t len)
+{
+	sigset_t pipe_set, old_set, pending;
+	sigemptyset(&pipe_set);
+	sigaddset(&pipe_set, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+	sigpending(&pending);
+	bool balready = sigismember(&pending, SIGPIPE);
+
+	bool bok = true;
+	const u8* p = (const u8*)data;
+	while (len)
+	{
+		ssize_t n = write(fd, p, len);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+		{
+			bok = false;
+			break;
+		} // end if
+		p += n;
+		len -= (size_t)n;
+	} // end while
+
+	if (!bok && errno == EPIPE && !balready)
+	{
+		struct timespec now = { 0, 0 };
+		while (sigtimedwait(&pipe_set, nullptr, &now) < 0 && errno == EINTR)
+			;
+	} // end if
+
+	pthread_sigmask(SIG_SETMASK, &old_set, nullptr);
+	return bok;
+} // end Write_All
+
+
+//=========================================================================================================|
+/**
+ * All of len bytes from fd; false on end of file or an error.
+ */
+static bool Read_All(int fd, void* data, size_t len)
+{
+	u8* p = (u8*)data;
+	while (len)
+	{
+		ssize_t n = read(fd, p, len);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return false;
+		p += n;
+		len -= (size_t)n;
+	} // end while
+
+	return true;
+} // end Read_All
+
+
+//=========================================================================================================|
+/**
+ * Waits for one of the server's children and, if it died without reporting, reports it failed.
+ */
+static void Reap(std::vector<std::pair<pid_t, u32>>& running, int result_fd)
+{
+	int status;
+	pid_t pid;
+	while ((pid = waitpid(-1, &status, 0)) < 0 && errno == EINTR)
+		;
+	if (pid < 0)
+	{
+		running.clear();		// nothing left to wait for
+		return;
+	} // end if
+
+	for (size_t i = 0; i < running.size(); i++)
+	{
+		if (running[i].first != pid)
+			continue;
+
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		{
+			RESULT_MSG m = { running[i].second, 0, 0, 0, 0, 0 };
+			Write_All(result_fd, &m, sizeof(m));
+		} // end if
+		running.erase(running.begin() + i);
+		return;
+	} // end for
+} // end Reap
+#endif
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; no server till Start.
+ */
+ForkServer::ForkServer()
+	:server{ 0 }, cmd_fd{ -1 }, result_fd{ -1 }, stats{}
+{
+
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor; stops the server if there is one.
+ */
+ForkServer::~ForkServer()
+{
+	Stop();
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Forks the server off bus as it is now; parallel is how many cases it runs at once (0 for one per
+ *	core). Later changes to bus don't reach it; Stop and Start again for that.
+ */
+bool ForkServer::Start(Bus& bus, u32 parallel)
+{
+	Stop();
+
+#ifdef _WIN32
+	(void)bus;
+	(void)parallel;
+	error = "the fork server needs a POSIX host";
+	return false;
+#else
+	if (!parallel)
+	{
+		long cores = sysconf(_SC_NPROCESSORS_ONLN);
+		parallel = cores > 0 ? (u32)cores : 1;
+	} // end if
+
+	int cmd[2], result[2];
+	if (pipe(cmd) != 0)
+	{
+		error = std::string("can't make a pipe: ") + strerror(errno);
+		return false;
+	} // end if
+	if (pipe(result) != 0)
+	{
+		error = std::string("can't make a pipe: ") + strerror(errno);
+		close(cmd[0]);
+		close(cmd[1]);
+		return false;
+	} // end if
+
+	fflush(nullptr);		// or the children would each have a copy of what's buffered
+
+	pid_t pid = fork();
+	if (pid < 0)
+	{
+		error = std::string("can't fork: ") + strerror(errno);
+		close(cmd[0]); close(cmd[1]);
+		close(result[0]); close(result[1]);
+		return false;
+	} // end if
+
+	if (pid == 0)
+	{
+		close(cmd[1]);
+		close(result[0]);
+		Serve(bus, parallel, cmd[0], result[1]);
+	} // end if
+
+	close(cmd[0]);
+	close(result[1]);
+	server = pid;
+	cmd_fd = cmd[1];
+	result_fd = result[0];
+	error.clear();
+	return true;
+#endif
+} // end Start
+
+
+//=========================================================================================================|
+/**
+ * Runs count cases of frames frames each; case i's input is input[i * frames ...], its result goes in
+ *	results[i]. False, and the server stopped, when the server has gone.
+ */
+bool ForkServer::Run_Batch(const u8* input, u32 frames, u32 count, FORK_RESULT* results)
+{
+#ifdef _WIN32
+	(void)input; (void)frames; (void)count; (void)results;
+	error = "the fork server needs a POSIX host";
+	return false;
+#else
+	if (!server)
+	{
+		error = "the fork server isn't running";
+		return false;
+	} // end if
+	if (!count)
+		return true;
+
+	auto start = std::chrono::steady_clock::now();
+	BATCH_HEADER h = { count, frames };
+	if (!Write_All(cmd_fd, &h, sizeof(h)) || !Write_All(cmd_fd, input, (size_t)count * frames))
+	{
+		error = "the fork server has gone";
+		Stop();
+		return false;
+	} // end if
+
+	for (u32 got = 0; got < count; got++)
+	{
+		RESULT_MSG m;
+		if (!Read_All(result_fd, &m, sizeof(m)) || m.index >= count)
+		{
+			error = "the fork server has gone";
+			Stop();
+			return false;
+		} // end if
+
+		results[m.index] = { m.ram_hash, m.cycles, m.page_faults, m.bok != 0 };
+		stats.failed += !m.bok;
+		stats.page_faults += m.page_faults;
+	} // end for
+
+	stats.batches++;
+	stats.cases += count;
+	stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return true;
+#endif
+} // end Run_Batch
+
+
+//=========================================================================================================|
+/**
+ * Tells the server to finish and waits for it.
+ */
+void ForkServer::Stop()
+{
+#ifndef _WIN32
+	if (!server)
+		return;
+
+	BATCH_HEADER h = { 0, 0 };
+	Write_All(cmd_fd, &h, sizeof(h));
+	close(cmd_fd);
+	close(result_fd);
+	while (waitpid(server, nullptr, 0) < 0 && errno == EINTR)
+		;
+
+	server = 0;
+	cmd_fd = result_fd = -1;
+#endif
+} // end Stop
+
+
+//=========================================================================================================|
+/**
+ * The server's life: read a batch, fork a child per case, no more than parallel at a time, reap them,
+ *	repeat. It never returns; it exits when told to or when the caller goes away.
+ */
+void ForkServer::Serve(Bus& bus, u32 parallel, int cmd_fd, int result_fd)
+{
+#ifdef _WIN32
+	(void)bus; (void)parallel; (void)cmd_fd; (void)result_fd;
+	exit(1);
+#else
+	std::vector<u8> input;
+	std::vector<std::pair<pid_t, u32>> running;
+
+	for (;;)
+	{
+		BATCH_HEADER h;
+		if (!Read_All(cmd_fd, &h, sizeof(h)) || !h.count)
+			_exit(0);
+
+		input.resize((size_t)h.count * h.frames);
+		if (!Read_All(cmd_fd, input.data(), input.size()))
+			_exit(0);
+
+		for (u32 i = 0; i < h.count; i++)
+		{
+			while (running.size() >= parallel)
+				Reap(running, result_fd);
+
+			pid_t pid = fork();
+			if (pid == 0)
+			{
+				close(cmd_fd);
+				Run_Case(bus, input.data() + (size_t)i * h.frames, h.frames, i, result_fd);
+			} // end if
+
+			if (pid < 0)
+			{
+				RESULT_MSG m = { i, 0, 0, 0, 0, 0 };
+				Write_All(result_fd, &m, sizeof(m));
+			} // end if
+			else
+				running.push_back({ pid, i });
+		} // end for
+
+		while (!running.empty())
+			Reap(running, result_fd);
+	} // end for
+#endif
+} // end Serve
+
+
+//=========================================================================================================|
+/**
+ * A child's life: its case on its copy of the machine, the result down the pipe, and out. _exit, so
+ *	nothing of the parent's (stdio buffers, destructors) runs twice.
+ */
+void ForkServer::Run_Case(Bus& bus, const u8* input, u32 frames, u32 index, int result_fd)
+{
+#ifdef _WIN32
+	(void)bus; (void)input; (void)frames; (void)index; (void)result_fd;
+#else
+	for (u32 f = 0; f < frames; f++)
+	{
+		bus.controller[0] = input[f];
+		bus.controller[1] = 0;
+		bus.Run_Frame();
+	} // end for
+
+	u64 h = FNV_OFFSET;
+	for (u32 i = 0; i < RAM_SIZE; i++)
+		h = (h ^ bus.ram[i]) * FNV_PRIME;
+
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);		// a forked child's counts start at zero
+
+	RESULT_MSG m = { index, 1, h, bus.system_clock, (u32)usage.ru_minflt, 0 };
+	_exit(Write_All(result_fd, &m, sizeof(m)) ? 0 : 1);
+#endif
+} // end Run_Case
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,110 @@
+//=========================================================================================================|
+// ForkServer.h
+//	Resets by fork() rather than by copying a snapshot back, for running great numbers of short test
+//	cases off one warm machine. It is the other way to do what Bus::Load_State does for Fuzzer and
+//	Search.
+//
+//	Start forks a server process. It inherits the caller's machine as it is at that moment: booted, rom
+//	in, warmed up. Then it waits on a pipe for batches. A batch is a number of cases, each a stream of
+//	pad 1 buttons, a byte a frame. For each case the server forks a child. The child gets the warm
+//	machine copy-on-write, runs its frames, writes a FORK_RESULT to the result pipe, and exits. Only the
+//	pages the child writes get copied, and the machine itself is never restored: the next child forks
+//	from the same untouched one. Up to parallel children run at once, so the cores share the batch.
+//	The results come back in whatever order the children finish, tagged with their case. A child that
+//	dies is reported failed by the server. Result messages are under PIPE_BUF, so children sharing the
+//	pipe can't interleave them.
+//
+//	What it costs is a fork, the page faults that copy the touched pages (two dozen or so), and an exit
+//	and a reap, per case. That comes to a couple of hundred microseconds more than a Load_State. So it
+//	only pays when cases run long enough to hide that, when cores would otherwise sit idle, or when a
+//	case must not be able to take the machine down with it. Tools/ForkBench measures where the line is.
+//
+//	POSIX only (fork, pipe, waitpid); on Windows Start fails and says so. A server that has died shows up
+//	as a failed write, not a dead caller: SIGPIPE is blocked only around the writes, on the writing
+//	thread, and swallowed if one raised it. The host's signal dispositions aren't touched.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef FORKSERVER_H
+#define FORKSERVER_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <string>
+
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// what one case came to
+struct FORK_RESULT
+{
+	u64 ram_hash;				// FNV-1a of the 64K at the end
+	u64 cycles;					// system clock at the end
+	u32 page_faults;			// minor faults in the child: about the pages it copied
+	bool bok;					// false when the child died before reporting
+};
+
+
+// what the batches have cost
+struct FORK_STATS
+{
+	u64 batches;
+	u64 cases;
+	u64 failed;
+	u64 page_faults;
+	double seconds;				// in Run_Batch, all told
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class ForkServer
+{
+public:
+
+	ForkServer();
+	~ForkServer();
+
+	bool Start(Bus& bus, u32 parallel);			// bus is what every case starts from
+	bool Run_Batch(const u8* input, u32 frames, u32 count, FORK_RESULT* results);
+	void Stop();
+
+	bool Running() const { return server > 0; }
+	const FORK_STATS& Stats() const { return stats; }
+	const std::string& Error() const { return error; }
+
+private:
+
+	int server;					// the server's pid; 0 when there isn't one
+	int cmd_fd;					// batches to the server
+	int result_fd;				// results from its children
+
+	FORK_STATS stats;
+	std::string error;
+
+	[[noreturn]] static void Serve(Bus& bus, u32 parallel, int cmd_fd, int result_fd);
+	static void Run_Case(Bus& bus, const u8* input, u32 frames, u32 index, int result_fd);
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,404 @@
+//=========================================================================================================|
+// Fuzzer.cpp
+//	The coverage guided fuzzer; see Fuzzer.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "Fuzzer.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define RUN_MAX				32			// longest run of frames a mutation works on
+#define SHIFT_MAX			16			// furthest the tail gets pushed
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Seconds between two points on the steady clock.
+ */
+static double Between(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+{
+	return std::chrono::duration<double>(to - from).count();
+} // end Between
+
+
+//=========================================================================================================|
+/**
+ * AFL's hit count buckets: one bit per range, so a count moving to another range shows as a new bit.
+ */
+static u8 Bucket(u8 hits)
+{
+	if (hits <= 2)
+		return hits;
+	if (hits == 3)
+		return 4;
+	if (hits <= 7)
+		return 8;
+	if (hits <= 15)
+		return 16;
+	if (hits <= 31)
+		return 32;
+	if (hits <= 127)
+		return 64;
+	return 128;
+} // end Bucket
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+// Bucket for every count, worked out once
+static const struct BUCKET_TABLE
+{
+	u8 of[256];
+	BUCKET_TABLE()
+	{
+		for (int i = 0; i < 256; i++)
+			of[i] = Bucket((u8)i);
+	}
+} BUCKETS;
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; starts the cpu counting edges and arms the crash breakpoint on $2000-$5FFF. The pristine
+ *	snapshot is the bus as it is now, till Set_Pristine says otherwise.
+ */
+Fuzzer::Fuzzer(Bus& bus, u32 frames, u64 seed)
+	:bus{ bus }, frames{ frames ? frames : 1 }, rng{ seed ? seed : 1 }, plistener{ nullptr },
+	pristine{ new MACHINE_STATE }, trace{ new u8[COVERAGE_SIZE] }, virgin{ new u8[COVERAGE_SIZE] }, stats{}
+{
+	memset(trace.get(), 0, COVERAGE_SIZE);
+	memset(virgin.get(), 0xFF, COVERAGE_SIZE);
+	scratch.resize(this->frames);
+
+	bus.Save_State(*pristine);
+	bus.cpu6502.Set_Coverage(trace.get());
+
+	BREAKPOINT bp = { BREAK_EXEC, FUZZ_IO_FIRST, FUZZ_IO_LAST, BREAK_ALWAYS, BREAK_EQ, 0, 0, false };
+	io_breakpoint = bus.breakpoints.Add(bp);
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor; the cpu stops counting and the breakpoint comes off.
+ */
+Fuzzer::~Fuzzer()
+{
+	bus.cpu6502.Set_Coverage(nullptr);
+	bus.breakpoints.Remove(io_breakpoint);
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * What every exec starts from; has to come from this bus.
+ */
+void Fuzzer::Set_Pristine(const MACHINE_STATE& state)
+{
+	*pristine = state;
+} // end Set_Pristine
+
+
+//=========================================================================================================|
+/**
+ * Runs a starting input and keeps it in the corpus whatever it covers.
+ */
+void Fuzzer::Add_Seed(const std::vector<u8>& input)
+{
+	std::vector<u8> seed(input);
+	seed.resize(frames, seed.empty() ? 0 : seed.back());
+
+	bool bnew;
+	Exec(seed.data(), bnew);
+	corpus.push_back(seed);
+} // end Add_Seed
+
+
+//=========================================================================================================|
+/**
+ * One exec of frames frames of input. bnew says whether it brought new coverage.
+ */
+u8 Fuzzer::Exec(const u8* input, bool& bnew)
+{
+	CPU6502& cpu = bus.cpu6502;
+
+	auto t0 = std::chrono::steady_clock::now();
+	bus.Load_State(*pristine);
+	bus.breakpoints.Clear_Hits();
+	auto t1 = std::chrono::steady_clock::now();
+	memset(trace.get(), 0, COVERAGE_SIZE);
+	auto t2 = std::chrono::steady_clock::now();
+
+	u32 jams = cpu.Jams();
+	u8 kind = FUZZ_NONE;
+	u16 at = 0;
+	u16 parked_pc = 0;
+	u32 parked = 0;
+	u32 f;
+	for (f = 0; f < frames; f++)
+	{
+		bus.controller[0] = input[f];
+		bus.controller[1] = 0;
+		if (!bus.Run_Frame())
+		{
+			for (const BREAK_HIT& hit : bus.breakpoints.Hits())
+				if (hit.id == io_breakpoint)
+				{
+					kind = FUZZ_CRASH;
+					at = hit.pc;
+				} // end if
+			if (kind)
+				break;
+		} // end if
+
+		if (cpu.Jams() != jams)
+		{
+			kind = FUZZ_CRASH;
+			at = cpu.Jam_Pc();
+			break;
+		} // end if
+
+		u16 pc = cpu.Pc();
+		parked = pc == parked_pc ? parked + 1 : 1;
+		parked_pc = pc;
+		if (parked >= FUZZ_HANG_FRAMES && Is_Trap(pc))
+		{
+			kind = FUZZ_HANG;
+			at = pc;
+			break;
+		} // end if
+	} // end for
+	auto t3 = std::chrono::steady_clock::now();
+
+	u32 new_edges, new_buckets;
+	Classify(new_edges, new_buckets);
+	auto t4 = std::chrono::steady_clock::now();
+
+	stats.execs++;
+	stats.frames += std::min(f + 1, frames);
+	stats.reset_seconds += Between(t0, t1);
+	stats.frame_seconds += Between(t2, t3);
+	stats.map_seconds += Between(t1, t2) + Between(t3, t4);
+
+	bnew = new_edges || new_buckets;
+	if (bnew)
+	{
+		stats.edges += new_edges;
+		stats.coverage_events++;
+		if (plistener)
+			plistener->Coverage(stats, new_edges, new_buckets);
+	} // end if
+
+	if (kind == FUZZ_CRASH)
+		stats.crashes++;
+	else if (kind == FUZZ_HANG)
+		stats.hangs++;
+	if (kind)
+		Found(kind, at, f, input);
+
+	return kind;
+} // end Exec
+
+
+//=========================================================================================================|
+/**
+ * Mutates corpus entries and runs them till execs have run or seconds have gone by, whichever is first.
+ *	Inputs that bring new coverage join the corpus. With an empty corpus it seeds it with no buttons.
+ */
+void Fuzzer::Run(u64 execs, double seconds)
+{
+	if (corpus.empty())
+		Add_Seed(std::vector<u8>(frames, 0));
+
+	auto start = std::chrono::steady_clock::now();
+	for (u64 n = 0; !execs || n < execs; n++)
+	{
+		if (seconds && Between(start, std::chrono::steady_clock::now()) >= seconds)
+			break;
+
+		scratch = corpus[Random((u32)corpus.size())];
+		Mutate(scratch);
+
+		bool bnew;
+		Exec(scratch.data(), bnew);
+		if (bnew)
+			corpus.push_back(scratch);
+	} // end for
+
+	stats.seconds += Between(start, std::chrono::steady_clock::now());
+} // end Run
+
+
+//=========================================================================================================|
+/**
+ * A number from 0 to below - 1; xorshift64*.
+ */
+u32 Fuzzer::Random(u32 below)
+{
+	rng ^= rng >> 12;
+	rng ^= rng << 25;
+	rng ^= rng >> 27;
+	return below ? (u32)((rng * 0x2545F4914F6CDD1Dull) >> 32) % below : 0;
+} // end Random
+
+
+//=========================================================================================================|
+/**
+ * Stacks one to FUZZ_MAX_STACK mutations on input; see Fuzzer.h for which.
+ */
+void Fuzzer::Mutate(std::vector<u8>& input)
+{
+	u32 count = 1 + Random(FUZZ_MAX_STACK);
+	for (u32 i = 0; i < count; i++)
+	{
+		u32 at = Random(frames);
+		u32 len = 1 + Random(std::min<u32>(frames - at, RUN_MAX));
+
+		switch (Random(8))
+		{
+		case 0:
+			input[at] ^= 1 << Random(8);
+			break;
+
+		case 1:
+			input[at] = (u8)Random(256);
+			break;
+
+		case 2:		// hold what's somewhere else, or something random
+			memset(&input[at], Random(2) ? input[Random(frames)] : Random(256), len);
+			break;
+
+		case 3:
+		{
+			u8 bit = (u8)(1 << Random(8));
+			for (u32 k = 0; k < len; k++)
+				input[at + k] |= bit;
+		} break;
+
+		case 4:
+		{
+			u8 bit = (u8)(1 << Random(8));
+			for (u32 k = 0; k < len; k++)
+				input[at + k] &= ~bit;
+		} break;
+
+		case 5:
+		{
+			u32 from = Random(frames - len + 1);
+			memmove(&input[at], &input[from], len);
+		} break;
+
+		case 6:		// the same frames off another entry
+		{
+			const std::vector<u8>& other = corpus[Random((u32)corpus.size())];
+			memcpy(&input[at], &other[at], len);
+		} break;
+
+		default:	// later by a few frames, the first of them held over the gap
+		{
+			u32 by = std::min<u32>(1 + Random(SHIFT_MAX), frames - at);
+			memmove(&input[at + by], &input[at], frames - at - by);
+			memset(&input[at], input[at], by);
+		} break;
+		} // end switch
+	} // end for
+} // end Mutate
+
+
+//=========================================================================================================|
+/**
+ * True when the instruction at pc goes straight back to pc: JMP pc, or a branch of -2.
+ */
+bool Fuzzer::Is_Trap(u16 pc) const
+{
+	const u8* ram = bus.ram;
+	u8 op = ram[pc];
+	if (op == 0x4C)
+		return (ram[(u16)(pc + 1)] | ram[(u16)(pc + 2)] << 8) == pc;
+	return (op & 0x1F) == 0x10 && ram[(u16)(pc + 1)] == 0xFE;
+} // end Is_Trap
+
+
+//=========================================================================================================|
+/**
+ * Buckets the exec's hit counts and takes them off the virgin map: new_edges counts edges hit for the
+ *	first time ever, new_buckets old edges hit a new number of times. Most of the map is zero, so it's
+ *	skipped eight bytes at a time.
+ */
+void Fuzzer::Classify(u32& new_edges, u32& new_buckets)
+{
+	new_edges = new_buckets = 0;
+	const u8* t = trace.get();
+	u8* v = virgin.get();
+	for (u32 i = 0; i < COVERAGE_SIZE; i += 8)
+	{
+		u64 word;
+		memcpy(&word, t + i, sizeof(word));
+		if (!word)
+			continue;
+
+		for (u32 k = i; k < i + 8; k++)
+		{
+			u8 b = BUCKETS.of[t[k]];
+			if (!(b & v[k]))
+				continue;
+
+			if (v[k] == 0xFF)
+				new_edges++;
+			else
+				new_buckets++;
+			v[k] &= ~b;
+		} // end for
+	} // end for
+} // end Classify
+
+
+//=========================================================================================================|
+/**
+ * Keeps a crash or hang the first time its kind and pc come up, and says so.
+ */
+void Fuzzer::Found(u8 kind, u16 pc, u32 frame, const u8* input)
+{
+	for (const FUZZ_FINDING& f : findings)
+		if (f.kind == kind && f.pc == pc)
+			return;
+
+	findings.push_back({ kind, pc, stats.execs, frame, std::vector<u8>(input, input + frames) });
+	if (plistener)
+		plistener->Finding(findings.back());
+} // end Found
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,185 @@
+//=========================================================================================================|
+// Fuzzer.h
+//	Coverage guided fuzzing of a rom through its controller input, after AFL. It is for shaking crashes
+//	and hangs out of homebrew.
+//
+//	An input is a stream of pad 1 buttons, a byte a frame. Each run (an exec) does the following:
+//	- It puts the machine back to a pristine snapshot. That is one Bus::Load_State of the writable
+//	  memory and registers, not a rebuild and reboot.
+//	- It plays the stream.
+//	- It looks at the edges the cpu counted on the way (CPU6502::Set_Coverage).
+//	Hit counts are put in AFL's buckets (1, 2, 3, 4-7, 8-15, 16-31, 32-127, 128+). A stream that brings
+//	up an edge never seen before, or an old edge in a new bucket, is new coverage. It goes into the
+//	corpus, and later inputs are mutated from the corpus.
+//
+//	Mutations are stacked, one to FUZZ_MAX_STACK at a time:
+//	- flip a bit;
+//	- set a frame to random buttons;
+//	- hold a button set over a run of frames;
+//	- press or let go of a button over a run;
+//	- copy a run elsewhere in the stream;
+//	- splice in a run from another corpus entry;
+//	- shift the tail a few frames later.
+//	Holds and runs matter more than single frames. Games act on buttons held, and a one-frame press
+//	rarely reaches anything new.
+//
+//	What counts as found:
+//	- crash: the cpu ran a JAM opcode, which stops a real 6502 dead, or fetched code from $2000-$5FFF,
+//	  which is registers, not memory. The second is caught by an exec breakpoint, so the run stops right
+//	  there.
+//	- hang: for FUZZ_HANG_FRAMES frames in a row the frame ended on the same jump or branch to itself.
+//	  That is the usual trap a program parks in after an error. An NMI driven main loop parks there too,
+//	  and without a picture unit in this tree no NMI comes to free it, so such roms show as hanging.
+//	Findings are told apart by kind and pc; only the first input for each is kept.
+//
+//	A fuzzer drives one machine on one thread. More throughput means more fuzzers, one per core, each
+//	with its own machine, the way AFL runs. Execs a second is what counts, so the stats time the three
+//	parts of an exec: reset, frames, and the coverage map (clear, bucket, compare).
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef FUZZER_H
+#define FUZZER_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <memory>
+#include <vector>
+
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FUZZ_MAX_STACK		8			// mutations stacked on one input, at most
+#define FUZZ_HANG_FRAMES	8			// frames parked on one trap that make a hang
+#define FUZZ_IO_FIRST		0x2000		// code fetched from here to FUZZ_IO_LAST is a crash
+#define FUZZ_IO_LAST		0x5FFF
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+enum FUZZ_KIND
+{
+	FUZZ_NONE,
+	FUZZ_CRASH,
+	FUZZ_HANG
+};
+
+
+// a crash or hang and the input that got there
+struct FUZZ_FINDING
+{
+	u8 kind;					// FUZZ_KIND
+	u16 pc;
+	u64 exec;					// which exec found it
+	u32 frame;					// the frame it happened on
+	std::vector<u8> input;
+};
+
+
+// how it's going
+struct FUZZ_STATS
+{
+	u64 execs;
+	u64 frames;
+	u64 edges;					// distinct edges seen
+	u64 coverage_events;		// execs that brought new coverage, seeds included
+	u64 crashes;				// execs that crashed, found before or not
+	u64 hangs;
+	double reset_seconds;		// Load_State from the pristine snapshot
+	double frame_seconds;
+	double map_seconds;			// clearing, bucketing and comparing the coverage map
+	double seconds;				// in Run, all told
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Told as things are found, from inside Run.
+ */
+class FuzzListener
+{
+public:
+
+	virtual ~FuzzListener() {}
+
+	// an exec brought new_edges edges never seen before and new_buckets new hit counts on old ones
+	virtual void Coverage(const FUZZ_STATS& stats, u32 new_edges, u32 new_buckets) {}
+
+	// the first exec to hit a crash or hang at its pc
+	virtual void Finding(const FUZZ_FINDING& finding) {}
+};
+
+
+/**
+ * The fuzzer; it runs on a bus the caller has set up, cartridge in, and leaves it as the last exec did.
+ */
+class Fuzzer
+{
+public:
+
+	Fuzzer(Bus& bus, u32 frames, u64 seed = 1);
+	~Fuzzer();
+
+	void Set_Pristine(const MACHINE_STATE& state);		// what every exec starts from
+	void Set_Listener(FuzzListener* plistener) { this->plistener = plistener; }
+
+	void Add_Seed(const std::vector<u8>& input);		// cut or padded to the frames per exec
+	u8 Exec(const u8* input, bool& bnew);				// one run; the FUZZ_KIND it ended in
+	void Run(u64 execs, double seconds);				// till either runs out; 0 for no limit
+
+	u32 Frames() const { return frames; }
+	size_t Corpus_Size() const { return corpus.size(); }
+	const std::vector<u8>& Corpus(size_t i) const { return corpus[i]; }
+	const std::vector<FUZZ_FINDING>& Findings() const { return findings; }
+	const FUZZ_STATS& Stats() const { return stats; }
+
+private:
+
+	Bus& bus;
+	u32 frames;
+	u64 rng;
+	FuzzListener* plistener;
+	int io_breakpoint;
+
+	std::unique_ptr<MACHINE_STATE> pristine;
+	std::unique_ptr<u8[]> trace;		// the cpu's edge counts for the exec under way
+	std::unique_ptr<u8[]> virgin;		// bucket bits not yet seen, per edge; starts all ones
+
+	std::vector<std::vector<u8>> corpus;
+	std::vector<FUZZ_FINDING> findings;
+	std::vector<u8> scratch;
+
+	FUZZ_STATS stats;
+
+	u32 Random(u32 below);
+	void Mutate(std::vector<u8>& input);
+	bool Is_Trap(u16 pc) const;
+	void Classify(u32& new_edges, u32& new_buckets);
+	void Found(u8 kind, u16 pc, u32 frame, const u8* input);
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
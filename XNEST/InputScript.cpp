@@ -0,0 +1,189 @@
+//=========================================================================================================|
+// InputScript.cpp
+//	Parsing and lookup for scripted controller input; see InputScript.h for the format.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#include "InputScript.h"
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+static const struct
+{
+	const char* name;
+	u8 bit;
+} BUTTON_NAMES[] =
+{
+	{ "A", BUTTON_A }, { "B", BUTTON_B }, { "SELECT", BUTTON_SELECT }, { "START", BUTTON_START },
+	{ "UP", BUTTON_UP }, { "DOWN", BUTTON_DOWN }, { "LEFT", BUTTON_LEFT }, { "RIGHT", BUTTON_RIGHT }
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; an empty script holds nothing down, ever.
+ */
+InputScript::InputScript()
+{
+
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+InputScript::~InputScript()
+{
+
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Reads a script off disk, replacing whatever was there. On a bad line nothing is kept and Error() says
+ *	where.
+ */
+bool InputScript::Load(const char* path)
+{
+	FILE* fp = fopen(path, "r");
+	if (!fp)
+	{
+		error = std::string("can't open ") + path;
+		return false;
+	} // end if
+
+	events.clear();
+	char line[512];
+	int line_no = 0;
+	while (fgets(line, sizeof(line), fp))
+	{
+		++line_no;
+		if (char* hash = strchr(line, '#'))
+			*hash = 0;
+
+		std::istringstream in(line);
+		u64 frame;
+		int pad = 0;
+		if (!(in >> frame))
+		{
+			in.clear();
+			std::string rest;
+			if (!(in >> rest))
+				continue;		// blank
+		} // end if
+		else
+			in >> pad;
+
+		if (pad < 1 || pad > 2)
+		{
+			error = std::string(path) + ": line " + std::to_string(line_no) + ": expected <frame> <1|2> [buttons]";
+			events.clear();
+			fclose(fp);
+			return false;
+		} // end if
+
+		u8 buttons = 0;
+		std::string tok;
+		while (in >> tok)
+		{
+			for (char& c : tok)
+				c = (char)toupper((unsigned char)c);
+
+			u8 bit = 0;
+			for (const auto& b : BUTTON_NAMES)
+				if (tok == b.name)
+					bit = b.bit;
+
+			if (!bit)
+			{
+				error = std::string(path) + ": line " + std::to_string(line_no) + ": unknown button " + tok;
+				events.clear();
+				fclose(fp);
+				return false;
+			} // end if
+			buttons |= bit;
+		} // end while
+
+		Add(frame, (u8)(pad - 1), buttons);
+	} // end while
+
+	fclose(fp);
+	error.clear();
+	return true;
+} // end Load
+
+
+//=========================================================================================================|
+/**
+ * Adds a change: pad holds buttons from frame on.
+ */
+void InputScript::Add(u64 frame, u8 pad, u8 buttons)
+{
+	INPUT_EVENT e = { frame, pad, buttons };
+	auto at = std::upper_bound(events.begin(), events.end(), e,
+		[](const INPUT_EVENT& l, const INPUT_EVENT& r) { return l.frame < r.frame; });
+	events.insert(at, e);
+} // end Add
+
+
+//=========================================================================================================|
+/**
+ * What pad is holding at frame; the last change at or before it wins.
+ */
+u8 InputScript::Buttons(u64 frame, u8 pad) const
+{
+	auto it = std::upper_bound(events.begin(), events.end(), frame,
+		[](u64 f, const INPUT_EVENT& e) { return f < e.frame; });
+
+	while (it != events.begin())
+	{
+		--it;
+		if (it->pad == pad)
+			return it->buttons;
+	} // end while
+
+	return 0;
+} // end Buttons
+
+
+//=========================================================================================================|
+/**
+ * The frame of the last change; 0 for an empty script.
+ */
+u64 InputScript::Last_Frame() const
+{
+	return events.empty() ? 0 : events.back().frame;
+} // end Last_Frame
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,86 @@
+//=========================================================================================================|
+// InputScript.h
+//	Controller input read out of a text file rather than a keyboard; for headless runs, benchmarks and
+//	anything else that has to press the same buttons at the same frames every time.
+//
+//	One change per line, held until the next change for the same pad:
+//
+//		# frame  pad  buttons...
+//		0        1
+//		120      1    START
+//		122      1
+//		300      1    RIGHT B
+//		300      2    A
+//
+//	Buttons are A B SELECT START UP DOWN LEFT RIGHT, in any case; none at all means let go of everything.
+//	Blank lines and anything after a # are ignored. Lines may come in any order.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef INPUTSCRIPT_H
+#define INPUTSCRIPT_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef uint8_t u8;
+typedef uint64_t u64;
+
+
+struct INPUT_EVENT
+{
+	u64 frame;
+	u8 pad;				// 0 or 1
+	u8 buttons;			// BUTTON_* bits
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class InputScript
+{
+public:
+
+	InputScript();
+	~InputScript();
+
+	bool Load(const char* path);
+	void Add(u64 frame, u8 pad, u8 buttons);
+
+	u8 Buttons(u64 frame, u8 pad) const;
+	u64 Last_Frame() const;
+	size_t Events() const { return events.size(); }
+	const std::string& Error() const { return error; }
+
+private:
+
+	std::vector<INPUT_EVENT> events;		// sorted by frame, file order kept within a frame
+	std::string error;
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
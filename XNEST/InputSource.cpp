@@ -0,0 +1,121 @@
+//=========================================================================================================|
+// InputSource.cpp
+//	The input sources; see InputSource.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#include "InputSource.h"
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+#ifdef _WIN32
+// pad 0's buttons on the keyboard
+static const struct
+{
+	int vkey;
+	u8 button;
+} KEYS[] =
+{
+	{ 'X', BUTTON_A }, { 'Z', BUTTON_B }, { VK_RSHIFT, BUTTON_SELECT }, { VK_RETURN, BUTTON_START },
+	{ VK_UP, BUTTON_UP }, { VK_DOWN, BUTTON_DOWN }, { VK_LEFT, BUTTON_LEFT }, { VK_RIGHT, BUTTON_RIGHT }
+};
+#endif
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Nothing pressed.
+ */
+void NullInput::Sample(u64, INPUT_FRAME& in)
+{
+	in.pads[0] = in.pads[1] = 0;
+	in.hotkeys = 0;
+} // end Sample
+
+
+//=========================================================================================================|
+/**
+ * Constructor
+ */
+ScriptedInput::ScriptedInput(const InputScript& script)
+	:script{ script }
+{
+
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Both pads as the script has them at frame; scripts don't press hotkeys.
+ */
+void ScriptedInput::Sample(u64 frame, INPUT_FRAME& in)
+{
+	in.pads[0] = script.Buttons(frame, 0);
+	in.pads[1] = script.Buttons(frame, 1);
+	in.hotkeys = 0;
+} // end Sample
+
+
+#ifdef _WIN32
+//=========================================================================================================|
+/**
+ * Constructor
+ */
+KeyboardInput::KeyboardInput()
+	:held_hotkeys{ 0 }
+{
+
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Reads the keyboard, once per key, for the frame about to run; pad 1 is left alone.
+ */
+void KeyboardInput::Sample(u64, INPUT_FRAME& in)
+{
+	in.pads[0] = in.pads[1] = 0;
+	for (const auto& k : KEYS)
+		if (GetAsyncKeyState(k.vkey) & 0x8000)
+			in.pads[0] |= k.button;
+
+	u8 held = 0;
+	if (GetAsyncKeyState(VK_ESCAPE) & 0x8000)
+		held |= HOTKEY_QUIT;
+	if (GetAsyncKeyState('F') & 0x8000)
+		held |= HOTKEY_FULLSCREEN;
+
+	in.hotkeys = held & ~held_hotkeys;
+	held_hotkeys = held;
+} // end Sample
+#endif
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
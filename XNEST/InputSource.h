@@ -0,0 +1,127 @@
+//=========================================================================================================|
+// InputSource.h
+//	Where the pads' buttons come from. The front end asks its source once per frame, before running the frame,
+//	for an INPUT_FRAME: both pads and the emulator's own hotkeys. It then hands the pads to the bus, whose
+//	$4016/$4017 strobe and shift registers give them to the game. Nothing looks at the host's keyboard while
+//	the frame runs, so what the game sees is fixed for the whole frame. That is what a real console does too:
+//	the pad is latched when the game strobes it, and games strobe once a frame.
+//
+//	Sources:
+//		NullInput		: nothing pressed, ever
+//		ScriptedInput	: plays an InputScript back; for headless runs, tests and benchmarks
+//		KeyboardInput	: the host keyboard (Windows; GetAsyncKeyState once per key per frame)
+//
+//	Anything else (a gamepad API, a network peer, a recorder in front of another source) is a class with a
+//	Sample method.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef INPUTSOURCE_H
+#define INPUTSOURCE_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdint>
+
+#include "InputScript.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+// the emulator's own keys; set on the frame the key goes down, not while it's held
+#define HOTKEY_QUIT			(1 << 0)
+#define HOTKEY_FULLSCREEN	(1 << 1)
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// one frame's worth of input
+struct INPUT_FRAME
+{
+	u8 pads[2];			// BUTTON_* bits, per pad
+	u8 hotkeys;			// HOTKEY_* bits
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class InputSource
+{
+public:
+
+	virtual ~InputSource() {}
+
+	// the input for frame, which is about to run
+	virtual void Sample(u64 frame, INPUT_FRAME& in) = 0;
+};
+
+
+/**
+ * Nothing pressed.
+ */
+class NullInput : public InputSource
+{
+public:
+
+	void Sample(u64 frame, INPUT_FRAME& in) override;
+};
+
+
+/**
+ * Plays a script back; the script has to outlive the source.
+ */
+class ScriptedInput : public InputSource
+{
+public:
+
+	ScriptedInput(const InputScript& script);
+
+	void Sample(u64 frame, INPUT_FRAME& in) override;
+
+private:
+
+	const InputScript& script;
+};
+
+
+#ifdef _WIN32
+/**
+ * The keyboard: arrows, X (A), Z (B), right shift (select), enter (start); escape quits and F toggles full
+ *	screen.
+ */
+class KeyboardInput : public InputSource
+{
+public:
+
+	KeyboardInput();
+
+	void Sample(u64 frame, INPUT_FRAME& in) override;
+
+private:
+
+	u8 held_hotkeys;		// hotkeys down last frame, so holding one doesn't repeat it
+};
+#endif
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
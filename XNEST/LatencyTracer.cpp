@@ -0,0 +1,236 @@
+//=========================================================================================================|
+// LatencyTracer.cpp
+//	Following input changes through to the frame that shows them; see LatencyTracer.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <algorithm>
+
+#include "LatencyTracer.h"
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FNV_OFFSET		0xCBF29CE484222325ull
+#define FNV_PRIME		0x100000001B3ull
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; lo..hi is the memory hashed as each frame's output.
+ */
+LatencyTracer::LatencyTracer(u16 lo, u16 hi)
+	:pbus{ nullptr }, lo{ lo < hi ? lo : hi }, hi{ lo < hi ? hi : lo }, first{ 0 }, count{ 0 },
+	last_signature{ 0 }, bhave_signature{ false }, shown{ 0 }, changed{ 0 }, changes{ 0 }, reads{ 0 }, dropped{ 0 }
+{
+	read_frames.reserve(4096);
+	frames.reserve(4096);
+	host_ms.reserve(4096);
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+LatencyTracer::~LatencyTracer()
+{
+	Detach();
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Starts following bus; its controller reads come to Read from now on.
+ */
+void LatencyTracer::Attach(Bus& bus)
+{
+	Detach();
+	pbus = &bus;
+	pbus->platency = this;
+	bhave_signature = false;
+} // end Attach
+
+
+//=========================================================================================================|
+/**
+ * Stops following the bus; what was measured stays.
+ */
+void LatencyTracer::Detach()
+{
+	if (pbus && pbus->platency == this)
+		pbus->platency = nullptr;
+	pbus = nullptr;
+} // end Detach
+
+
+//=========================================================================================================|
+/**
+ * The host has just sampled a change on port and handed it to the bus, to be applied from the frame about
+ *	to run. Call it with the change, not every frame; buttons is there for the caller's benefit (and a
+ *	debugger's), the tracer only cares that something changed.
+ */
+void LatencyTracer::Input(u8 port, u8 buttons)
+{
+	(void)buttons;
+	if (!pbus)
+		return;
+
+	changes++;
+	if (count == LATENCY_PENDING)
+	{
+		first = (first + 1) % LATENCY_PENDING;
+		count--;
+		dropped++;
+	} // end if
+
+	PENDING& p = pending[(first + count++) % LATENCY_PENDING];
+	p.frame = shown;
+	p.sampled = CLOCK::now();
+	p.port = port & 1;
+	p.bread = false;
+} // end Input
+
+
+//=========================================================================================================|
+/**
+ * The game has read port; changes on it that were waiting on a read have now been seen.
+ */
+void LatencyTracer::Read(u8 port)
+{
+	for (u32 i = 0; i < count; i++)
+	{
+		PENDING& p = pending[(first + i) % LATENCY_PENDING];
+		if (p.port != port || p.bread)
+			continue;
+
+		p.bread = true;
+		reads++;
+		read_frames.push_back((u32)(shown - p.frame));
+	} // end for
+} // end Read
+
+
+//=========================================================================================================|
+/**
+ * A frame is being shown; call it once per shown frame, with the bus holding that frame. If its output
+ *	differs from the frame before, every change read so far is answered by it.
+ */
+void LatencyTracer::Frame_End()
+{
+	if (!pbus)
+		return;
+
+	shown++;
+	u64 signature = Signature();
+	bool bchanged = bhave_signature && signature != last_signature;
+	last_signature = signature;
+	bhave_signature = true;
+	if (!bchanged)
+		return;
+	changed++;
+
+	// answered ones come off the front; a read change behind an unread one waits its turn, which it only
+	// does when the ports are read in a different order than they changed
+	CLOCK::time_point now = CLOCK::now();
+	while (count && pending[first].bread)
+	{
+		const PENDING& p = pending[first];
+		frames.push_back((u32)(shown - p.frame));
+		host_ms.push_back(std::chrono::duration<double, std::milli>(now - p.sampled).count());
+
+		first = (first + 1) % LATENCY_PENDING;
+		count--;
+	} // end while
+} // end Frame_End
+
+
+//=========================================================================================================|
+/**
+ * Counts and percentiles of everything measured so far.
+ */
+void LatencyTracer::Get_Stats(LATENCY_STATS& stats) const
+{
+	stats.changes = changes;
+	stats.read = reads;
+	stats.answered = frames.size();
+	stats.dropped = dropped;
+	stats.shown = shown;
+	stats.changed = changed;
+
+	stats.read_frames = Percentiles(std::vector<double>(read_frames.begin(), read_frames.end()));
+	stats.frames = Percentiles(std::vector<double>(frames.begin(), frames.end()));
+	stats.host_ms = Percentiles(host_ms);
+
+	stats.emulated_ms.p50 = stats.frames.p50 * 1000 / NTSC_FRAME_RATE;
+	stats.emulated_ms.p99 = stats.frames.p99 * 1000 / NTSC_FRAME_RATE;
+} // end Get_Stats
+
+
+//=========================================================================================================|
+/**
+ * FNV-1a of the output range, peeked so nothing is disturbed.
+ */
+u64 LatencyTracer::Signature() const
+{
+	u64 h = FNV_OFFSET;
+	u32 addr = lo;
+	while (addr <= hi)
+	{
+		PEEK_SPAN span = pbus->Peek_Range((u16)addr, hi - addr + 1);
+		if (!span.size)
+		{
+			h = (h ^ pbus->Peek((u16)addr)) * FNV_PRIME;
+			addr++;
+			continue;
+		} // end if
+
+		for (u32 i = 0; i < span.size; i++)
+			h = (h ^ span.data[i]) * FNV_PRIME;
+		addr += span.size;
+	} // end while
+
+	return h;
+} // end Signature
+
+
+//=========================================================================================================|
+/**
+ * Nearest rank p50 and p99 of v; 0's when empty.
+ */
+LATENCY_PERCENTILES LatencyTracer::Percentiles(std::vector<double> v)
+{
+	LATENCY_PERCENTILES p = { 0, 0 };
+	if (v.empty())
+		return p;
+
+	std::sort(v.begin(), v.end());
+	p.p50 = v[(v.size() - 1) * 50 / 100];
+	p.p99 = v[(v.size() - 1) * 99 / 100];
+	return p;
+} // end Percentiles
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
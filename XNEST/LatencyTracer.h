@@ -0,0 +1,155 @@
+//=========================================================================================================|
+// LatencyTracer.h
+//	Measures input latency the way a player feels it: from the moment the host sampled a button change, to
+//	the game reading it through $4016/$4017, to the first frame whose output is different because of it.
+//
+//	Every change the front end hands over (Input) is stamped with the frame it was applied on and the host
+//	time. Frames are counted by Frame_End calls, i.e. frames shown, not by the bus; with run-ahead
+//	(RunAhead.h) the bus runs several per shown frame, and what a player feels is the shown ones. The bus tells us about controller reads (Read), which marks pending changes on that port as seen
+//	by the game. At the end of every frame (Frame_End) the frame's output signature is worked out. When it
+//	differs from the previous frame's, every seen-but-unanswered change is answered by that frame.
+//
+//	There is no PPU yet, so there is no picture to compare. The output signature is a hash of a stretch of
+//	memory standing in for what would be drawn: by default $0200-$02FF, the page most games DMA into sprite
+//	memory. Any range can be given instead, e.g. the player's position. Once there is a framebuffer, its
+//	hash goes in here and nothing else changes.
+//
+//	Latency is reported in frames and in milliseconds, at p50 and p99:
+//		to read		frames from the one the change was applied on to the first read; 0 is the same frame
+//		frames		frames completed from the one the change was applied on; 1 means the same frame showed it
+//		emulated ms	frames at the NTSC rate, i.e. what it would be on hardware
+//		host ms		host time between the sample and the answering frame; only meaningful when the run is
+//					paced to real time, headless runs go as fast as they can
+//
+//	Changes the game never reads, or never answers, are counted but left out of the percentiles.
+//
+//	Any change to the output answers everything read so far; the tracer can't tell a change the input
+//	caused from one the game makes anyway. A range the game rewrites every frame (animated sprites, a
+//	timer) answers every change a frame later whatever the input did. The stats say how many shown frames
+//	differed from the one before; when that's most of them, pick a range only the input moves.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef LATENCYTRACER_H
+#define LATENCYTRACER_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define LATENCY_PENDING		64			// changes waiting on a read or an answer; more and the oldest go
+#define NTSC_FRAME_RATE		60.0988
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+
+// p50 and p99 of one measure
+struct LATENCY_PERCENTILES
+{
+	double p50;
+	double p99;
+};
+
+
+// what Get_Stats reports
+struct LATENCY_STATS
+{
+	u64 changes;				// input changes handed in
+	u64 read;					// of those, read by the game
+	u64 answered;				// of those, followed by a frame that differed
+	u64 dropped;				// pushed out of the pending list before being answered
+	u64 shown;					// frames shown
+	u64 changed;				// of those, whose output differed from the frame before
+
+	LATENCY_PERCENTILES read_frames;	// change to first read
+	LATENCY_PERCENTILES frames;			// change to answering frame
+	LATENCY_PERCENTILES emulated_ms;
+	LATENCY_PERCENTILES host_ms;
+};
+
+
+class Bus;
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class LatencyTracer
+{
+public:
+
+	LatencyTracer(u16 lo = 0x0200, u16 hi = 0x02FF);
+	~LatencyTracer();
+
+	void Attach(Bus& bus);
+	void Detach();
+
+	void Input(u8 port, u8 buttons);
+	void Read(u8 port);
+	void Frame_End();
+
+	void Get_Stats(LATENCY_STATS& stats) const;
+
+private:
+
+	typedef std::chrono::steady_clock CLOCK;
+
+	struct PENDING
+	{
+		u64 frame;				// shown frames when the change was applied
+		CLOCK::time_point sampled;
+		u8 port;
+		bool bread;
+	};
+
+	Bus* pbus;
+	u16 lo, hi;					// the output signature's range
+
+	PENDING pending[LATENCY_PENDING];
+	u32 first, count;			// ring of pending changes, oldest first
+	u64 last_signature;
+	bool bhave_signature;
+	u64 shown;					// Frame_End calls
+	u64 changed;				// of those, with a different signature from the one before
+
+	u64 changes, reads, dropped;
+	std::vector<u32> read_frames;		// one per change read
+	std::vector<u32> frames;			// one per change answered
+	std::vector<double> host_ms;
+
+	u64 Signature() const;
+	static LATENCY_PERCENTILES Percentiles(std::vector<double> v);
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
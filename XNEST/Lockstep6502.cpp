@@ -0,0 +1,1266 @@
+//=========================================================================================================|
+// Lockstep6502.cpp
+//	The lanes, the vector path and the scalar path; see Lockstep6502.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstring>
+
+#include "Lockstep6502.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define LOCKSTEP_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+// the vector path is built for AVX2 whatever the rest of the build targets, and only run if the cpu has it
+#if defined(LOCKSTEP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define LOCKSTEP_AVX2		__attribute__((target("avx2")))
+#else
+#define LOCKSTEP_AVX2
+#endif
+
+#define ROW(addr)			((u32)(u16)(addr) * LOCKSTEP_LANES)		// where address addr's row starts
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// the instructions, in the order of KIND_NAMES
+enum LOCKSTEP_KIND
+{
+	LK_ADC, LK_AND, LK_ASL, LK_BCC, LK_BCS, LK_BEQ, LK_BIT, LK_BMI, LK_BNE, LK_BPL, LK_BRK, LK_BVC,
+	LK_BVS, LK_CLC, LK_CLD, LK_CLI, LK_CLV, LK_CMP, LK_CPX, LK_CPY, LK_DEC, LK_DEX, LK_DEY, LK_EOR,
+	LK_INC, LK_INX, LK_INY, LK_JMP, LK_JSR, LK_LDA, LK_LDX, LK_LDY, LK_LSR, LK_NOP, LK_ORA, LK_PHA,
+	LK_PHP, LK_PLA, LK_PLP, LK_ROL, LK_ROR, LK_RTI, LK_RTS, LK_SBC, LK_SEC, LK_SED, LK_SEI, LK_STA,
+	LK_STX, LK_STY, LK_TAX, LK_TAY, LK_TSX, LK_TXA, LK_TXS, LK_TYA,
+	LK_COUNT
+};
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+static const char* KIND_NAMES[LK_COUNT] =
+{
+	"ADC", "AND", "ASL", "BCC", "BCS", "BEQ", "BIT", "BMI", "BNE", "BPL", "BRK", "BVC",
+	"BVS", "CLC", "CLD", "CLI", "CLV", "CMP", "CPX", "CPY", "DEC", "DEX", "DEY", "EOR",
+	"INC", "INX", "INY", "JMP", "JSR", "LDA", "LDX", "LDY", "LSR", "NOP", "ORA", "PHA",
+	"PHP", "PLA", "PLP", "ROL", "ROR", "RTI", "RTS", "SBC", "SEC", "SED", "SEI", "STA",
+	"STX", "STY", "TAX", "TAY", "TSX", "TXA", "TXS", "TYA"
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * The lowest lane in a mask; the mask mustn't be empty.
+ */
+static inline u32 Lowest(u32 mask)
+{
+#if defined(_MSC_VER)
+	unsigned long i;
+	_BitScanForward(&i, mask);
+	return i;
+#else
+	return __builtin_ctz(mask);
+#endif
+} // end Lowest
+
+
+//=========================================================================================================|
+/**
+ * How many lanes in a mask.
+ */
+static inline u32 Count(u32 mask)
+{
+	u32 n = 0;
+	for (; mask; mask &= mask - 1)
+		n++;
+	return n;
+} // end Count
+
+
+//=========================================================================================================|
+/**
+ * The accesses Bus::Read and Bus::Write hand to the apu or the pads rather than the memory.
+ */
+static inline bool Is_Io_Read(u16 addr)
+{
+	return addr >= 0x4015 && addr <= 0x4017;
+} // end Is_Io_Read
+
+static inline bool Is_Io_Write(u16 addr)
+{
+	return addr >= 0x4000 && addr <= 0x4017 && addr != 0x4014;
+} // end Is_Io_Write
+
+// either; what the vector path keeps clear of
+static inline bool Is_Io(u16 addr)
+{
+	return addr >= LOCKSTEP_IO_FIRST && addr <= LOCKSTEP_IO_LAST;
+} // end Is_Io
+
+
+//=========================================================================================================|
+/**
+ * True when the cpu running us has AVX2 (and the OS saves the registers it needs).
+ */
+static bool Has_Avx2()
+{
+#if defined(LOCKSTEP_X86) && (defined(__GNUC__) || defined(__clang__))
+	return __builtin_cpu_supports("avx2");
+#elif defined(LOCKSTEP_X86) && defined(_MSC_VER)
+	int r[4];
+	__cpuid(r, 1);
+	if (!(r[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6)
+		return false;		// no OSXSAVE, or the ymm state isn't saved
+	__cpuidex(r, 7, 0);
+	return (r[1] & (1 << 5)) != 0;
+#else
+	return false;
+#endif
+} // end Has_Avx2
+
+
+#ifdef LOCKSTEP_X86
+//=========================================================================================================|
+/**
+ * 0xFF in the byte of each lane in mask, 0 in the others.
+ */
+static inline __m128i Lane_Bytes(u32 mask)
+{
+	const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+	__m128i m = _mm_set_epi64x((long long)(0x0101010101010101ull * ((mask >> 8) & 0xFF)),
+		(long long)(0x0101010101010101ull * (mask & 0xFF)));
+	return _mm_cmpeq_epi8(_mm_and_si128(m, bits), bits);
+} // end Lane_Bytes
+
+
+//=========================================================================================================|
+/**
+ * v where lanes is set, old elsewhere.
+ */
+static inline __m128i Blend(__m128i old, __m128i v, __m128i lanes)
+{
+	return _mm_or_si128(_mm_and_si128(lanes, v), _mm_andnot_si128(lanes, old));
+} // end Blend
+
+
+//=========================================================================================================|
+/**
+ * flag in the lanes where bset is all ones.
+ */
+static inline __m128i Flag_If(__m128i bset, u8 flag)
+{
+	return _mm_and_si128(bset, _mm_set1_epi8((char)flag));
+} // end Flag_If
+
+
+//=========================================================================================================|
+/**
+ * The status bytes p with Z and N set from r, the way every load and transfer does.
+ */
+static inline __m128i Zn(__m128i p, __m128i r)
+{
+	p = _mm_and_si128(p, _mm_set1_epi8((char)~(Z | N)));
+	p = _mm_or_si128(p, Flag_If(_mm_cmpeq_epi8(r, _mm_setzero_si128()), Z));
+	return _mm_or_si128(p, _mm_and_si128(r, _mm_set1_epi8((char)N)));
+} // end Zn
+
+
+//=========================================================================================================|
+/**
+ * True when every lane in group has the same byte in v as the lead lane.
+ */
+static inline bool Same_Bytes(__m128i v, u32 lead, u32 group)
+{
+	alignas(16) u8 b[LOCKSTEP_LANES];
+	_mm_store_si128((__m128i*)b, v);
+	u32 eq = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8((char)b[lead])));
+	return (eq & group) == group;
+} // end Same_Bytes
+
+
+//=========================================================================================================|
+/**
+ * True when every lane in group has the same address in where[] as the lead lane.
+ */
+static inline LOCKSTEP_AVX2 bool Same_Words(const u16* where, u32 lead, u32 group)
+{
+	__m256i eq = _mm256_cmpeq_epi16(_mm256_load_si256((const __m256i*)where), _mm256_set1_epi16((short)where[lead]));
+	u32 mask = (u32)_mm_movemask_epi8(_mm_packs_epi16(_mm256_castsi256_si128(eq), _mm256_extracti128_si256(eq, 1)));
+	return (mask & group) == group;
+} // end Same_Words
+
+
+//=========================================================================================================|
+/**
+ * Each lane's stack slot sp + delta, into where[].
+ */
+static inline LOCKSTEP_AVX2 void Stack_Where(__m128i vs, int delta, u16* where)
+{
+	__m128i slot = _mm_add_epi8(vs, _mm_set1_epi8((char)delta));
+	__m256i w = _mm256_or_si256(_mm256_cvtepu8_epi16(slot), _mm256_set1_epi16(0x0100));
+	_mm256_store_si256((__m256i*)where, w);
+} // end Stack_Where
+
+
+//=========================================================================================================|
+/**
+ * Address addr of every lane.
+ */
+static inline __m128i Load_Row(const u8* mem, u32 addr)
+{
+	return _mm_loadu_si128((const __m128i*)(mem + ROW(addr)));
+} // end Load_Row
+
+
+//=========================================================================================================|
+/**
+ * v into address addr of the lanes in lanes; the others keep theirs.
+ */
+static inline void Store_Row(u8* mem, u32 addr, __m128i v, __m128i lanes)
+{
+	__m128i* p = (__m128i*)(mem + ROW(addr));
+	_mm_storeu_si128(p, Blend(_mm_loadu_si128(p), v, lanes));
+} // end Store_Row
+
+
+//=========================================================================================================|
+/**
+ * Each lane in group's own address where[lane].
+ */
+static inline __m128i Gather(const u8* mem, const u16* where, u32 group)
+{
+	alignas(16) u8 v[LOCKSTEP_LANES] = {};
+	for (; group; group &= group - 1)
+	{
+		u32 l = Lowest(group);
+		v[l] = mem[ROW(where[l]) + l];
+	} // end for
+	return _mm_load_si128((const __m128i*)v);
+} // end Gather
+
+
+//=========================================================================================================|
+/**
+ * The reverse of Gather, leaving out whatever is write protected.
+ */
+static inline void Scatter(u8* mem, const u16* where, u32 group, __m128i v, u32 rom_start)
+{
+	alignas(16) u8 b[LOCKSTEP_LANES];
+	_mm_store_si128((__m128i*)b, v);
+	for (; group; group &= group - 1)
+	{
+		u32 l = Lowest(group);
+		if (where[l] < rom_start)
+			mem[ROW(where[l]) + l] = b[l];
+	} // end for
+} // end Scatter
+
+
+//=========================================================================================================|
+/**
+ * The operand of the lanes in group: address addr for all of them when bsame, else where[lane] each.
+ */
+static inline __m128i Pull(const u8* mem, bool bsame, u32 addr, const u16* where, u32 group)
+{
+	return bsame ? Load_Row(mem, addr) : Gather(mem, where, group);
+} // end Pull
+
+
+//=========================================================================================================|
+/**
+ * The reverse of Pull.
+ */
+static inline void Push(u8* mem, bool bsame, u32 addr, const u16* where, u32 group, __m128i v, __m128i lanes,
+	u32 rom_start)
+{
+	if (!bsame)
+		Scatter(mem, where, group, v, rom_start);
+	else if (addr < rom_start)
+		Store_Row(mem, addr, v, lanes);
+} // end Push
+#endif
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; lanes from 1 to LOCKSTEP_LANES, each with zeroed memory and registers until loaded.
+ */
+Lockstep6502::Lockstep6502(u32 lanes)
+	:lanes{ lanes < 1 ? 1 : lanes > LOCKSTEP_LANES ? LOCKSTEP_LANES : lanes }, running{ 0 }, stopped{ 0 },
+	rom_start{ RAM_SIZE }, bvector{ Has_Avx2() }, pio{ nullptr }, mem{ new u8[(size_t)RAM_SIZE * LOCKSTEP_LANES]() },
+	stats{}
+{
+	memset(pc, 0, sizeof(pc));
+	memset(a, 0, sizeof(a));
+	memset(x, 0, sizeof(x));
+	memset(y, 0, sizeof(y));
+	memset(sp, 0, sizeof(sp));
+	memset(status, 0, sizeof(status));
+	memset(cycles, 0, sizeof(cycles));
+
+	// the mnemonic says which instruction, bar $EB: CPU6502 runs that "???" as SBC
+	CPU6502 cpu;
+	for (int op = 0; op < 256; op++)
+	{
+		OPCODE_INFO info;
+		cpu.Get_Opcode_Info((u8)op, info);
+
+		kind[op] = LK_NOP;
+		for (u8 k = 0; k < LK_COUNT; k++)
+			if (!strcmp(info.name, KIND_NAMES[k]))
+				kind[op] = k;
+		if (op == 0xEB)
+			kind[op] = LK_SBC;
+
+		mode[op] = info.mode;
+		bytes[op] = info.bytes;
+		base_cycles[op] = info.cycles;
+	} // end for
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+Lockstep6502::~Lockstep6502()
+{
+
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Turns the vector path on or off; it stays off on a cpu without AVX2.
+ */
+void Lockstep6502::Set_Vector(bool benable)
+{
+	bvector = benable && Has_Avx2();
+} // end Set_Vector
+
+
+//=========================================================================================================|
+/**
+ * Copies a machine's registers and all 64K of its memory into lane, and sets the lane running. The
+ *	write protection (rom_start) is the bus's; it's shared by every lane, so load them all from the same
+ *	sort of cartridge.
+ */
+void Lockstep6502::Load_Lane(u32 lane, const Bus& bus)
+{
+	if (lane >= lanes)
+		return;
+
+	CPU_STATE s;
+	bus.cpu6502.Save_State(s);
+	a[lane] = s.a;
+	x[lane] = s.x;
+	y[lane] = s.y;
+	sp[lane] = s.sp;
+	status[lane] = s.status;
+	pc[lane] = s.pc;
+
+	u8* column = mem.get() + lane;
+	for (u32 addr = 0; addr < RAM_SIZE; addr++)
+		column[addr * LOCKSTEP_LANES] = bus.ram[addr];
+
+	rom_start = bus.rom_start;
+	running |= 1u << lane;
+	stopped &= ~(1u << lane);
+} // end Load_Lane
+
+
+//=========================================================================================================|
+/**
+ * The reverse of Load_Lane, as far as the memory below rom_start goes; the rest of the bus is untouched.
+ */
+void Lockstep6502::Store_Lane(u32 lane, Bus& bus) const
+{
+	if (lane >= lanes)
+		return;
+
+	CPU_STATE s;
+	bus.cpu6502.Save_State(s);
+	s.a = a[lane];
+	s.x = x[lane];
+	s.y = y[lane];
+	s.sp = sp[lane];
+	s.status = status[lane];
+	s.pc = pc[lane];
+	s.cycles = 0;
+	bus.cpu6502.Load_State(s);
+
+	const u8* column = mem.get() + lane;
+	for (u32 addr = 0; addr < bus.rom_start; addr++)
+		bus.ram[addr] = column[addr * LOCKSTEP_LANES];
+} // end Store_Lane
+
+
+//=========================================================================================================|
+/**
+ * A lane's registers, between instructions; the rest of the state is zero.
+ */
+void Lockstep6502::Get_State(u32 lane, CPU_STATE& state) const
+{
+	state = {};
+	state.a = a[lane];
+	state.x = x[lane];
+	state.y = y[lane];
+	state.sp = sp[lane];
+	state.status = status[lane];
+	state.pc = pc[lane];
+} // end Get_State
+
+
+//=========================================================================================================|
+/**
+ * Runs one instruction on every running lane, steps times over, or till none is left running. Returns the
+ *	stopped lanes.
+ */
+u32 Lockstep6502::Run(u64 steps)
+{
+	for (u64 s = 0; s < steps; s++)
+	{
+		u32 pending = running & ~stopped;
+		if (!pending)
+			break;
+		stats.steps++;
+
+		while (pending)
+		{
+			u32 lead = Lowest(pending);
+			u16 at = pc[lead];
+			u32 group = 1u << lead;
+			if (bvector)
+			{
+				group = Same_Pc(at) & pending;
+				if (group != 1u << lead)
+					group = Same_Code(lead, at, group);
+			} // end if
+			pending &= ~group;
+			stats.groups++;
+
+			u32 done = 0;
+			if (group & (group - 1))
+				done = Step_Group(group, at);
+			if (done)
+			{
+				stats.vector_groups++;
+				stats.vector_lanes += Count(done);
+			} // end if
+
+			for (u32 left = group & ~done; left; left &= left - 1)
+			{
+				u32 l = Lowest(left);
+				if (Step_Lane(l))
+					stats.scalar_lanes++;
+				else
+				{
+					stopped |= 1u << l;
+					stats.io_stops++;
+				} // end else
+			} // end for
+		} // end while
+	} // end for
+
+	return stopped;
+} // end Run
+
+
+//=========================================================================================================|
+/**
+ * The running lanes whose pc is at.
+ */
+LOCKSTEP_AVX2 u32 Lockstep6502::Same_Pc(u16 at) const
+{
+#ifdef LOCKSTEP_X86
+	__m256i eq = _mm256_cmpeq_epi16(_mm256_load_si256((const __m256i*)pc), _mm256_set1_epi16((short)at));
+	__m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(eq), _mm256_extracti128_si256(eq, 1));
+	return (u32)_mm_movemask_epi8(packed) & running;
+#else
+	u32 same = 0;
+	for (u32 l = 0; l < lanes; l++)
+		if (pc[l] == at)
+			same |= 1u << l;
+	return same & running;
+#endif
+} // end Same_Pc
+
+
+//=========================================================================================================|
+/**
+ * The lanes in group whose instruction at at is byte for byte the lead's. Code in ram can differ lane to
+ *	lane, and so can code from different cartridges.
+ */
+u32 Lockstep6502::Same_Code(u32 lead, u16 at, u32 group) const
+{
+	const u8* m = mem.get();
+	u32 n = bytes[m[ROW(at) + lead]];
+	for (u32 i = 0; i < n; i++)
+	{
+		u32 row = ROW(at + i);
+#ifdef LOCKSTEP_X86
+		__m128i v = _mm_loadu_si128((const __m128i*)(m + row));
+		group &= (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8((char)m[row + lead])));
+#else
+		for (u32 left = group; left; left &= left - 1)
+		{
+			u32 l = Lowest(left);
+			if (m[row + l] != m[row + lead])
+				group &= ~(1u << l);
+		} // end for
+#endif
+	} // end for
+
+	return group;
+} // end Same_Code
+
+
+//=========================================================================================================|
+/**
+ * One instruction on a group of lanes at the same pc with the same code, all at once. Lanes whose
+ *	operand is an apu or pad register drop out. Returns the lanes it ran, none when the instruction or
+ *	addressing mode is one for the scalar path.
+ */
+LOCKSTEP_AVX2 u32 Lockstep6502::Step_Group(u32 group, u16 at)
+{
+#ifdef LOCKSTEP_X86
+	u8* m = mem.get();
+	u32 lead = Lowest(group);
+	u8 op = m[ROW(at) + lead];
+	u8 k = kind[op];
+	u8 am = mode[op];
+	u8 o1 = m[ROW(at + 1) + lead];
+	u8 o2 = m[ROW(at + 2) + lead];
+
+	if (am == AM_IND || k == LK_BRK || k == LK_RTI)
+		return 0;
+	for (u32 i = 0; i < bytes[op]; i++)
+		if (Is_Io((u16)(at + i)))
+			return 0;
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i ones = _mm_set1_epi8(-1);
+	const __m128i one = _mm_set1_epi8(1);
+
+	__m128i va = _mm_load_si128((const __m128i*)a);
+	__m128i vx = _mm_load_si128((const __m128i*)x);
+	__m128i vy = _mm_load_si128((const __m128i*)y);
+	__m128i vs = _mm_load_si128((const __m128i*)sp);
+	__m128i vp = _mm_load_si128((const __m128i*)status);
+
+	u16 next = (u16)(at + bytes[op]);
+	__m256i vpc = _mm256_set1_epi16((short)next);
+	__m128i extra = zero;			// cycles past the base count, per lane
+
+	// the operand's address: one for every lane (bsame), or one each in where[]
+	alignas(32) u16 where[LOCKSTEP_LANES];
+	bool bsame = true;
+	u16 uaddr = 0;
+	__m128i cross = zero;			// lanes whose index carried into the next page
+
+	switch (am)
+	{
+	case AM_IMM: uaddr = (u16)(at + 1); break;
+	case AM_ZP0: uaddr = o1; break;
+	case AM_ABS: uaddr = (u16)(o1 | (o2 << 8)); break;
+
+	case AM_ZPX:
+	case AM_ZPY:
+	{
+		__m128i index = am == AM_ZPX ? vx : vy;
+		__m128i zp = _mm_add_epi8(_mm_set1_epi8((char)o1), index);
+		_mm256_store_si256((__m256i*)where, _mm256_cvtepu8_epi16(zp));
+		bsame = Same_Bytes(index, lead, group);
+		uaddr = where[lead];
+		break;
+	} // end ZPX/ZPY
+
+	case AM_ABX:
+	case AM_ABY:
+	{
+		__m128i index = am == AM_ABX ? vx : vy;
+		__m256i ea = _mm256_add_epi16(_mm256_set1_epi16((short)(o1 | (o2 << 8))), _mm256_cvtepu8_epi16(index));
+		_mm256_store_si256((__m256i*)where, ea);
+
+		// the low byte carries when index > 0xFF - lo
+		__m128i room = _mm_set1_epi8((char)(0xFF - o1));
+		cross = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_max_epu8(index, room), room), ones);
+		bsame = Same_Bytes(index, lead, group);
+		uaddr = where[lead];
+		break;
+	} // end ABX/ABY
+
+	case AM_IZX:
+	{
+		// every lane has its own pointer, even when they all read it from the same place
+		__m128i lo, hi;
+		if (Same_Bytes(vx, lead, group))
+		{
+			lo = Load_Row(m, (u8)(o1 + x[lead]));
+			hi = Load_Row(m, (u8)(o1 + x[lead] + 1));
+		} // end if
+		else
+		{
+			__m128i zp = _mm_add_epi8(_mm_set1_epi8((char)o1), vx);
+			_mm256_store_si256((__m256i*)where, _mm256_cvtepu8_epi16(zp));
+			lo = Gather(m, where, group);
+			_mm256_store_si256((__m256i*)where, _mm256_cvtepu8_epi16(_mm_add_epi8(zp, one)));
+			hi = Gather(m, where, group);
+		} // end else
+
+		__m256i ea = _mm256_or_si256(_mm256_cvtepu8_epi16(lo), _mm256_slli_epi16(_mm256_cvtepu8_epi16(hi), 8));
+		_mm256_store_si256((__m256i*)where, ea);
+		bsame = Same_Words(where, lead, group);
+		uaddr = where[lead];
+		break;
+	} // end IZX
+
+	case AM_IZY:
+	{
+		__m128i lo = Load_Row(m, o1);
+		__m128i hi = Load_Row(m, (o1 + 1) & 0x00FF);
+		__m256i page = _mm256_slli_epi16(_mm256_cvtepu8_epi16(hi), 8);
+		__m256i ea = _mm256_add_epi16(_mm256_or_si256(_mm256_cvtepu8_epi16(lo), page), _mm256_cvtepu8_epi16(vy));
+		_mm256_store_si256((__m256i*)where, ea);
+
+		__m256i same_page = _mm256_cmpeq_epi16(_mm256_and_si256(ea, _mm256_set1_epi16((short)0xFF00)), page);
+		cross = _mm_andnot_si128(_mm_packs_epi16(_mm256_castsi256_si128(same_page),
+			_mm256_extracti128_si256(same_page, 1)), ones);
+		bsame = Same_Words(where, lead, group);
+		uaddr = where[lead];
+		break;
+	} // end IZY
+	} // end switch
+
+	// lanes about to touch the apu or the pads do it the slow way
+	bool bmemory = am != AM_IMP && am != AM_REL && k != LK_JMP && k != LK_JSR;
+	if (bmemory)
+	{
+		if (bsame && Is_Io(uaddr))
+			return 0;
+		if (!bsame)
+		{
+			for (u32 left = group; left; left &= left - 1)
+				if (Is_Io(where[Lowest(left)]))
+					group &= ~(1u << Lowest(left));
+			if (!group)
+				return 0;
+		} // end if
+	} // end if
+
+	// the stack: rows when every lane has the same stack pointer, a slot each in pushed[]/pulled[] if not
+	bool bstack = k == LK_JSR || k == LK_RTS || k == LK_PHA || k == LK_PHP || k == LK_PLA || k == LK_PLP;
+	u8 s = sp[lead];
+	bool bsame_sp = true;
+	alignas(32) u16 pushed[LOCKSTEP_LANES], pulled[LOCKSTEP_LANES];
+	if (bstack && !(bsame_sp = Same_Bytes(vs, lead, group)))
+	{
+		Stack_Where(vs, 0, pushed);
+		Stack_Where(vs, 1, pulled);
+	} // end if
+
+	__m128i lanes = Lane_Bytes(group);
+	__m128i f = va;					// the operand
+	if (bmemory && k != LK_STA && k != LK_STX && k != LK_STY)
+		f = Pull(m, bsame, uaddr, where, group);
+
+	__m128i result = zero;			// what gets written back, when bwrite
+	bool bwrite = false;
+	__m128i pays = zero;			// ones for the instructions that pay for a page crossing
+
+	switch (k)
+	{
+	case LK_LDA: va = f; vp = Zn(vp, f); pays = ones; break;
+	case LK_LDX: vx = f; vp = Zn(vp, f); pays = ones; break;
+	case LK_LDY: vy = f; vp = Zn(vp, f); pays = ones; break;
+	case LK_STA: result = va; bwrite = true; break;
+	case LK_STX: result = vx; bwrite = true; break;
+	case LK_STY: result = vy; bwrite = true; break;
+
+	case LK_ADC:
+	case LK_SBC:
+	{
+		// subtraction is addition of the ones' complement
+		__m128i value = k == LK_ADC ? f : _mm_xor_si128(f, ones);
+		__m128i c = _mm_and_si128(vp, _mm_set1_epi8(C));
+		__m128i sum = _mm_add_epi8(va, value);
+		__m128i t = _mm_add_epi8(sum, c);
+
+		// a carry out of either add: the first wrapped below a, or the carry in took $FF round to 0
+		__m128i carry = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_max_epu8(va, sum), sum), ones);
+		carry = _mm_or_si128(carry, _mm_and_si128(_mm_cmpeq_epi8(t, zero), _mm_cmpeq_epi8(c, one)));
+		__m128i v = _mm_andnot_si128(_mm_xor_si128(va, value), _mm_xor_si128(va, t));
+
+		vp = _mm_and_si128(vp, _mm_set1_epi8((char)~(C | V)));
+		vp = _mm_or_si128(vp, Flag_If(carry, C));
+		vp = _mm_or_si128(vp, Flag_If(_mm_cmplt_epi8(v, zero), V));
+		vp = Zn(vp, t);
+		va = t;
+		pays = ones;
+		break;
+	} // end ADC/SBC
+
+	case LK_AND: va = _mm_and_si128(va, f); vp = Zn(vp, va); pays = ones; break;
+	case LK_ORA: va = _mm_or_si128(va, f); vp = Zn(vp, va); pays = ones; break;
+	case LK_EOR: va = _mm_xor_si128(va, f); vp = Zn(vp, va); pays = ones; break;
+
+	case LK_CMP:
+	case LK_CPX:
+	case LK_CPY:
+	{
+		__m128i r = k == LK_CMP ? va : k == LK_CPX ? vx : vy;
+		vp = _mm_and_si128(vp, _mm_set1_epi8((char)~(C | Z | N)));
+		vp = _mm_or_si128(vp, Flag_If(_mm_cmpeq_epi8(_mm_max_epu8(r, f), r), C));
+		vp = _mm_or_si128(vp, Flag_If(_mm_cmpeq_epi8(r, f), Z));
+		vp = _mm_or_si128(vp, _mm_and_si128(_mm_sub_epi8(r, f), _mm_set1_epi8((char)N)));
+		if (k == LK_CMP)
+			pays = ones;
+		break;
+	} // end CMP/CPX/CPY
+
+	case LK_BIT:
+		vp = _mm_and_si128(vp, _mm_set1_epi8((char)~(Z | V | N)));
+		vp = _mm_or_si128(vp, Flag_If(_mm_cmpeq_epi8(_mm_and_si128(va, f), zero), Z));
+		vp = _mm_or_si128(vp, _mm_and_si128(f, _mm_set1_epi8((char)(V | N))));
+		break;
+
+	case LK_INC: result = _mm_add_epi8(f, one); vp = Zn(vp, result); bwrite = true; break;
+	case LK_DEC: result = _mm_sub_epi8(f, one); vp = Zn(vp, result); bwrite = true; break;
+	case LK_INX: vx = _mm_add_epi8(vx, one); vp = Zn(vp, vx); break;
+	case LK_INY: vy = _mm_add_epi8(vy, one); vp = Zn(vp, vy); break;
+	case LK_DEX: vx = _mm_sub_epi8(vx, one); vp = Zn(vp, vx); break;
+	case LK_DEY: vy = _mm_sub_epi8(vy, one); vp = Zn(vp, vy); break;
+
+	case LK_TAX: vx = va; vp = Zn(vp, vx); break;
+	case LK_TAY: vy = va; vp = Zn(vp, vy); break;
+	case LK_TXA: va = vx; vp = Zn(vp, va); break;
+	case LK_TYA: va = vy; vp = Zn(vp, va); break;
+	case LK_TSX: vx = vs; vp = Zn(vp, vx); break;
+	case LK_TXS: vs = vx; break;
+
+	case LK_CLC: vp = _mm_and_si128(vp, _mm_set1_epi8((char)~C)); break;
+	case LK_CLD: vp = _mm_and_si128(vp, _mm_set1_epi8((char)~D)); break;
+	case LK_CLI: vp = _mm_and_si128(vp, _mm_set1_epi8((char)~I)); break;
+	case LK_CLV: vp = _mm_and_si128(vp, _mm_set1_epi8((char)~V)); break;
+	case LK_SEC: vp = _mm_or_si128(vp, _mm_set1_epi8(C)); break;
+	case LK_SED: vp = _mm_or_si128(vp, _mm_set1_epi8(D)); break;
+	case LK_SEI: vp = _mm_or_si128(vp, _mm_set1_epi8(I)); break;
+	case LK_NOP: break;
+
+	case LK_ASL:
+	case LK_LSR:
+	case LK_ROL:
+	case LK_ROR:
+	{
+		__m128i c = _mm_and_si128(vp, _mm_set1_epi8(C));
+		__m128i half = _mm_and_si128(_mm_srli_epi16(f, 1), _mm_set1_epi8(0x7F));
+		__m128i t, carry;
+		if (k == LK_ASL)
+		{
+			t = _mm_add_epi8(f, f);
+			carry = _mm_cmplt_epi8(f, zero);
+		} // end if
+		else if (k == LK_LSR)
+		{
+			t = half;
+			carry = _mm_cmpeq_epi8(_mm_and_si128(f, one), one);
+		} // end else if
+		else if (k == LK_ROL)
+		{
+			t = _mm_or_si128(_mm_add_epi8(f, f), c);
+			carry = _mm_cmplt_epi8(f, zero);
+		} // end else if
+		else
+		{
+			t = _mm_or_si128(half, _mm_and_si128(_mm_cmpeq_epi8(c, one), _mm_set1_epi8((char)0x80)));
+			carry = _mm_cmpeq_epi8(_mm_and_si128(f, one), one);
+		} // end else
+
+		vp = _mm_and_si128(vp, _mm_set1_epi8((char)~C));
+		vp = _mm_or_si128(Zn(vp, t), Flag_If(carry, C));
+		if (am == AM_IMP)
+			va = t;
+		else
+		{
+			result = t;
+			bwrite = true;
+		} // end else
+		break;
+	} // end shifts
+
+	case LK_JMP:
+		vpc = _mm256_set1_epi16((short)uaddr);
+		break;
+
+	case LK_BPL: case LK_BMI: case LK_BVC: case LK_BVS:
+	case LK_BCC: case LK_BCS: case LK_BNE: case LK_BEQ:
+	{
+		u8 flag = (k == LK_BPL || k == LK_BMI) ? N : (k == LK_BVC || k == LK_BVS) ? V :
+			(k == LK_BCC || k == LK_BCS) ? C : Z;
+		bool bwhen_set = k == LK_BMI || k == LK_BVS || k == LK_BCS || k == LK_BEQ;
+
+		__m128i set = _mm_cmpeq_epi8(_mm_and_si128(vp, _mm_set1_epi8((char)flag)), _mm_set1_epi8((char)flag));
+		__m128i taken = bwhen_set ? set : _mm_andnot_si128(set, ones);
+		u16 to = (u16)(next + (u16)(o1 & 0x80 ? o1 | 0xFF00 : o1));
+		extra = _mm_and_si128(taken, _mm_set1_epi8((to & 0xFF00) != (next & 0xFF00) ? 2 : 1));
+		vpc = _mm256_blendv_epi8(vpc, _mm256_set1_epi16((short)to), _mm256_cvtepi8_epi16(taken));
+		break;
+	} // end branches
+
+	case LK_JSR:
+	{
+		u16 back = (u16)(at + 2);
+		Push(m, bsame_sp, 0x0100 + s, pushed, group, _mm_set1_epi8((char)(back >> 8)), lanes, rom_start);
+		if (!bsame_sp)
+			Stack_Where(vs, -1, pushed);
+		Push(m, bsame_sp, 0x0100 + (u8)(s - 1), pushed, group, _mm_set1_epi8((char)(back & 0xFF)), lanes,
+			rom_start);
+		vs = _mm_sub_epi8(vs, _mm_set1_epi8(2));
+		vpc = _mm256_set1_epi16((short)uaddr);
+		break;
+	} // end JSR
+
+	case LK_RTS:
+	{
+		__m256i lo = _mm256_cvtepu8_epi16(Pull(m, bsame_sp, 0x0100 + (u8)(s + 1), pulled, group));
+		if (!bsame_sp)
+			Stack_Where(vs, 2, pulled);
+		__m256i hi = _mm256_cvtepu8_epi16(Pull(m, bsame_sp, 0x0100 + (u8)(s + 2), pulled, group));
+		vpc = _mm256_add_epi16(_mm256_or_si256(lo, _mm256_slli_epi16(hi, 8)), _mm256_set1_epi16(1));
+		vs = _mm_add_epi8(vs, _mm_set1_epi8(2));
+		break;
+	} // end RTS
+
+	case LK_PHA:
+		Push(m, bsame_sp, 0x0100 + s, pushed, group, va, lanes, rom_start);
+		vs = _mm_sub_epi8(vs, one);
+		break;
+
+	case LK_PHP:
+		Push(m, bsame_sp, 0x0100 + s, pushed, group, _mm_or_si128(vp, _mm_set1_epi8(B | U)), lanes, rom_start);
+		vp = _mm_and_si128(vp, _mm_set1_epi8((char)~(B | U)));
+		vs = _mm_sub_epi8(vs, one);
+		break;
+
+	case LK_PLA:
+		va = Pull(m, bsame_sp, 0x0100 + (u8)(s + 1), pulled, group);
+		vp = Zn(vp, va);
+		vs = _mm_add_epi8(vs, one);
+		break;
+
+	case LK_PLP:
+		vp = _mm_or_si128(Pull(m, bsame_sp, 0x0100 + (u8)(s + 1), pulled, group), _mm_set1_epi8(U));
+		vs = _mm_add_epi8(vs, one);
+		break;
+
+	default:
+		return 0;
+	} // end switch
+
+	if (bwrite)
+		Push(m, bsame, uaddr, where, group, result, lanes, rom_start);
+
+	// registers, pc and cycle counts back, for the group's lanes only
+	_mm_store_si128((__m128i*)a, Blend(_mm_load_si128((const __m128i*)a), va, lanes));
+	_mm_store_si128((__m128i*)x, Blend(_mm_load_si128((const __m128i*)x), vx, lanes));
+	_mm_store_si128((__m128i*)y, Blend(_mm_load_si128((const __m128i*)y), vy, lanes));
+	_mm_store_si128((__m128i*)sp, Blend(_mm_load_si128((const __m128i*)sp), vs, lanes));
+	_mm_store_si128((__m128i*)status, Blend(_mm_load_si128((const __m128i*)status), vp, lanes));
+
+	__m256i wide = _mm256_cvtepi8_epi16(lanes);
+	_mm256_store_si256((__m256i*)pc, _mm256_blendv_epi8(_mm256_load_si256((const __m256i*)pc), vpc, wide));
+
+	extra = _mm_add_epi8(extra, _mm_and_si128(_mm_and_si128(cross, pays), one));
+	__m128i ticks = _mm_and_si128(lanes, _mm_add_epi8(_mm_set1_epi8((char)base_cycles[op]), extra));
+	__m256i* pcycles = (__m256i*)cycles;
+	_mm256_store_si256(pcycles + 0, _mm256_add_epi64(_mm256_load_si256(pcycles + 0), _mm256_cvtepu8_epi64(ticks)));
+	_mm256_store_si256(pcycles + 1, _mm256_add_epi64(_mm256_load_si256(pcycles + 1),
+		_mm256_cvtepu8_epi64(_mm_srli_si128(ticks, 4))));
+	_mm256_store_si256(pcycles + 2, _mm256_add_epi64(_mm256_load_si256(pcycles + 2),
+		_mm256_cvtepu8_epi64(_mm_srli_si128(ticks, 8))));
+	_mm256_store_si256(pcycles + 3, _mm256_add_epi64(_mm256_load_si256(pcycles + 3),
+		_mm256_cvtepu8_epi64(_mm_srli_si128(ticks, 12))));
+
+	return group;
+#else
+	(void)group;
+	(void)at;
+	return 0;
+#endif
+} // end Step_Group
+
+
+//=========================================================================================================|
+/**
+ * One instruction on one lane, the way CPU6502 runs it. Without a LockstepIo an apu or pad access
+ *	leaves the lane as it was and returns false; writes are held back till the end for that.
+ */
+bool Lockstep6502::Step_Lane(u32 lane)
+{
+	u8* column = mem.get() + lane;
+	u8 ra = a[lane], rx = x[lane], ry = y[lane], rs = sp[lane], rp = status[lane];
+	u16 rpc = pc[lane];
+
+	bool bstop = false;
+	u16 held_addr[3];
+	u8 held_data[3];
+	u32 held = 0;
+
+	auto Read = [&](u16 addr) -> u8
+	{
+		if (Is_Io_Read(addr))
+		{
+			if (!pio)
+			{
+				bstop = true;
+				return 0;
+			} // end if
+			stats.io_accesses++;
+			return pio->Read(lane, addr);
+		} // end if
+		return column[ROW(addr)];
+	};
+
+	auto Write = [&](u16 addr, u8 data)
+	{
+		if (Is_Io_Write(addr))
+		{
+			if (!pio)
+				bstop = true;
+			else
+			{
+				stats.io_accesses++;
+				pio->Write(lane, addr, data);
+			} // end else
+			return;
+		} // end if
+		held_addr[held] = addr;
+		held_data[held++] = data;
+	};
+
+	auto Flag = [&](u8 flag, bool bset) { rp = bset ? rp | flag : rp & ~flag; };
+	auto Set_Zn = [&](u8 r) { Flag(Z, r == 0); Flag(N, r & 0x80); };
+
+	u8 op = Read(rpc++);
+	u8 am = mode[op];
+	u8 k = kind[op];
+	u32 ticks = base_cycles[op];
+	u16 addr = 0, rel = 0;
+	u8 f = 0;
+	u8 cross = 0;
+
+	switch (am)
+	{
+	case AM_IMP: f = ra; break;
+	case AM_IMM: addr = rpc++; break;
+	case AM_ZP0: addr = Read(rpc++); break;
+	case AM_ZPX: addr = (Read(rpc++) + rx) & 0x00FF; break;
+	case AM_ZPY: addr = (Read(rpc++) + ry) & 0x00FF; break;
+
+	case AM_REL:
+		rel = Read(rpc++);
+		if (rel & 0x80)
+			rel |= 0xFF00;
+		break;
+
+	case AM_ABS:
+	{
+		u16 lo = Read(rpc++);
+		u16 hi = Read(rpc++);
+		addr = (hi << 8) | lo;
+		break;
+	} // end ABS
+
+	case AM_ABX:
+	case AM_ABY:
+	{
+		u16 lo = Read(rpc++);
+		u16 hi = Read(rpc++);
+		addr = ((hi << 8) | lo) + (am == AM_ABX ? rx : ry);
+		cross = (addr & 0xFF00) != (hi << 8);
+		break;
+	} // end ABX/ABY
+
+	case AM_IND:
+	{
+		// with the page wrap of the real thing
+		u16 lo = Read(rpc++);
+		u16 hi = Read(rpc++);
+		u16 ptr = (hi << 8) | lo;
+		if (lo == 0x00FF)
+			addr = (Read(ptr & 0xFF00) << 8) | Read(ptr);
+		else
+			addr = (Read(ptr + 1) << 8) | Read(ptr);
+		break;
+	} // end IND
+
+	case AM_IZX:
+	{
+		u16 t = Read(rpc++);
+		u16 lo = Read((t + rx) & 0x00FF);
+		u16 hi = Read((t + rx + 1) & 0x00FF);
+		addr = (hi << 8) | lo;
+		break;
+	} // end IZX
+
+	case AM_IZY:
+	{
+		u16 t = Read(rpc++);
+		u16 lo = Read(t);
+		u16 hi = Read((t + 1) & 0x00FF);
+		addr = ((hi << 8) | lo) + ry;
+		cross = (addr & 0xFF00) != (hi << 8);
+		break;
+	} // end IZY
+	} // end switch
+
+	auto Fetch = [&]() -> u8
+	{
+		if (am != AM_IMP)
+			f = Read(addr);
+		return f;
+	};
+
+	auto Put = [&](u8 t)
+	{
+		if (am == AM_IMP)
+			ra = t;
+		else
+			Write(addr, t);
+	};
+
+	auto Branch = [&](bool btaken)
+	{
+		if (!btaken)
+			return;
+		ticks++;
+		u16 to = rpc + rel;
+		if ((to & 0xFF00) != (rpc & 0xFF00))
+			ticks++;
+		rpc = to;
+	};
+
+	u8 pays = 0;		// 1 for the instructions that pay for a page crossing
+	switch (k)
+	{
+	case LK_ADC:
+	case LK_SBC:
+	{
+		// subtraction is addition of the ones' complement
+		u8 value = k == LK_ADC ? Fetch() : Fetch() ^ 0xFF;
+		u16 sum = (u16)(ra + value + (rp & C));
+		u8 t = (u8)sum;
+		Flag(C, sum > 0xFF);
+		Flag(V, (~(ra ^ value) & (ra ^ t)) & 0x80);
+		Set_Zn(t);
+		ra = t;
+		pays = 1;
+		break;
+	} // end ADC/SBC
+
+	case LK_AND:
+		ra &= Fetch();
+		Set_Zn(ra);
+		pays = 1;
+		break;
+
+	case LK_ORA:
+	case LK_EOR:
+		ra = k == LK_ORA ? ra | Fetch() : ra ^ Fetch();
+		Set_Zn(ra);
+		pays = 1;
+		break;
+
+	case LK_ASL:
+	{
+		Fetch();
+		u8 t = (u8)(f << 1);
+		Flag(C, f & 0x80);
+		Set_Zn(t);
+		Put(t);
+		break;
+	} // end ASL
+
+	case LK_LSR:
+	{
+		Fetch();
+		u8 t = f >> 1;
+		Flag(C, f & 0x01);
+		Set_Zn(t);
+		Put(t);
+		break;
+	} // end LSR
+
+	case LK_ROL:
+	{
+		Fetch();
+		u8 t = (u8)((f << 1) | (rp & C));
+		Flag(C, f & 0x80);
+		Set_Zn(t);
+		Put(t);
+		break;
+	} // end ROL
+
+	case LK_ROR:
+	{
+		Fetch();
+		u8 t = (u8)((rp & C) << 7 | (f >> 1));
+		Flag(C, f & 0x01);
+		Set_Zn(t);
+		Put(t);
+		break;
+	} // end ROR
+
+	case LK_BIT:
+		Fetch();
+		Flag(Z, (ra & f) == 0);
+		Flag(N, f & 0x80);
+		Flag(V, f & 0x40);
+		break;
+
+	case LK_CMP:
+	case LK_CPX:
+	case LK_CPY:
+	{
+		u8 r = k == LK_CMP ? ra : k == LK_CPX ? rx : ry;
+		Fetch();
+		Flag(C, r >= f);
+		Flag(Z, r == f);
+		Flag(N, (u8)(r - f) & 0x80);
+		pays = k == LK_CMP;
+		break;
+	} // end CMP/CPX/CPY
+
+	case LK_BPL: Branch(!(rp & N)); break;
+	case LK_BMI: Branch(rp & N); break;
+	case LK_BVC: Branch(!(rp & V)); break;
+	case LK_BVS: Branch(rp & V); break;
+	case LK_BCC: Branch(!(rp & C)); break;
+	case LK_BCS: Branch(rp & C); break;
+	case LK_BNE: Branch(!(rp & Z)); break;
+	case LK_BEQ: Branch(rp & Z); break;
+
+	case LK_BRK:
+		Flag(I, true);
+		rpc++;
+		Write(0x0100 + rs--, rpc >> 8);
+		Write(0x0100 + rs--, rpc & 0x00FF);
+		rp |= B;
+		Write(0x0100 + rs--, rp);
+		rp &= ~B;
+		rpc = Read(0xFFFE) | ((u16)Read(0xFFFF) << 8);
+		break;
+
+	case LK_CLC: Flag(C, false); break;
+	case LK_CLD: Flag(D, false); break;
+	case LK_CLI: Flag(I, false); break;
+	case LK_CLV: Flag(V, false); break;
+	case LK_SEC: Flag(C, true); break;
+	case LK_SED: Flag(D, true); break;
+	case LK_SEI: Flag(I, true); break;
+
+	case LK_DEC: { u8 t = Fetch() - 1; Write(addr, t); Set_Zn(t); break; }
+	case LK_INC: { u8 t = Fetch() + 1; Write(addr, t); Set_Zn(t); break; }
+	case LK_DEX: Set_Zn(--rx); break;
+	case LK_DEY: Set_Zn(--ry); break;
+	case LK_INX: Set_Zn(++rx); break;
+	case LK_INY: Set_Zn(++ry); break;
+
+	case LK_JMP: rpc = addr; break;
+
+	case LK_JSR:
+		--rpc;
+		Write(0x0100 + rs--, rpc >> 8);
+		Write(0x0100 + rs--, rpc & 0x00FF);
+		rpc = addr;
+		break;
+
+	case LK_RTS:
+		rpc = Read(0x0100 + ++rs);
+		rpc |= (u16)Read(0x0100 + ++rs) << 8;
+		rpc++;
+		break;
+
+	case LK_RTI:
+		rp = Read(0x0100 + ++rs);
+		rp &= ~(B | U);
+		rpc = Read(0x0100 + ++rs);
+		rpc |= (u16)Read(0x0100 + ++rs) << 8;
+		break;
+
+	case LK_LDA: ra = Fetch(); Set_Zn(ra); pays = 1; break;
+	case LK_LDX: rx = Fetch(); Set_Zn(rx); pays = 1; break;
+	case LK_LDY: ry = Fetch(); Set_Zn(ry); pays = 1; break;
+	case LK_STA: Write(addr, ra); break;
+	case LK_STX: Write(addr, rx); break;
+	case LK_STY: Write(addr, ry); break;
+
+	case LK_PHA: Write(0x0100 + rs--, ra); break;
+	case LK_PHP: Write(0x0100 + rs--, rp | B | U); rp &= ~(B | U); break;
+	case LK_PLA: ra = Read(0x0100 + ++rs); Set_Zn(ra); break;
+	case LK_PLP: rp = Read(0x0100 + ++rs) | U; break;
+
+	case LK_TAX: rx = ra; Set_Zn(rx); break;
+	case LK_TAY: ry = ra; Set_Zn(ry); break;
+	case LK_TSX: rx = rs; Set_Zn(rx); break;
+	case LK_TXA: ra = rx; Set_Zn(ra); break;
+	case LK_TXS: rs = rx; break;
+	case LK_TYA: ra = ry; Set_Zn(ra); break;
+
+	case LK_NOP: break;
+	} // end switch
+
+	if (bstop)
+		return false;
+
+	for (u32 i = 0; i < held; i++)
+		if (held_addr[i] < rom_start)
+			column[ROW(held_addr[i])] = held_data[i];
+
+	a[lane] = ra;
+	x[lane] = rx;
+	y[lane] = ry;
+	sp[lane] = rs;
+	status[lane] = rp;
+	pc[lane] = rpc;
+	cycles[lane] += ticks + (cross & pays);
+	return true;
+} // end Step_Lane
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
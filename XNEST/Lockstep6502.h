@@ -0,0 +1,162 @@
+//=========================================================================================================|
+// Lockstep6502.h
+//	Up to 16 independent 6502s run side by side, for search and training work where the same program
+//	runs over many starting points: same code, different data.
+//
+//	The registers are stored structure-of-arrays, one byte (pc: one word) per lane. Each lane's memory
+//	is interleaved with the others': a row of 16 bytes per address, so address a of every lane is
+//	mem[a * 16 .. a * 16 + 15]. Lanes at the same pc mostly also touch the same addresses. For them a
+//	load is one 16-byte load, a store a blend into the row, and the register work is a handful of
+//	byte-vector operations across all lanes at once. With AVX2 the pc's and cycle counts go through
+//	256-bit vectors too.
+//
+//	Each step runs one instruction on every lane. Lanes are grouped by pc, and lanes whose code at that
+//	pc differs (it can, in ram) are split off. A group of two or more runs through the vector path
+//	(Step_Group), masked to its lanes. Where the lanes' operand addresses differ (indexed or indirect
+//	modes, stacks at different depths) the loads and stores go lane by lane; the rest stays vector. That
+//	covers every instruction but BRK, RTI and JMP (ind). Those, a lane on its own, and hosts without AVX2
+//	take the scalar path (Step_Lane), one lane at a time.
+//
+//	Both paths do what CPU6502 does, instruction for instruction, and the opcode table (mnemonic,
+//	addressing mode, cycles) comes from CPU6502 itself. Tools/Lockstep checks the engine
+//	against the scalar core, step by step, and times the two.
+//
+//	This is a cpu and its memory, nothing else: no apu, no pads, no interrupts. The registers the Bus
+//	gives to the apu and pads ($4000-$4013 and $4015-$4017 written, $4015-$4017 read) go to a
+//	LockstepIo when one is set; one machine per lane behind it will do. Without one, a lane stops just
+//	before such an access (Stopped()). The caller can then run that instruction on a real Bus and carry
+//	on: Store_Lane, cpu6502.Step, Load_Lane.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef LOCKSTEP6502_H
+#define LOCKSTEP6502_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <memory>
+
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define LOCKSTEP_LANES		16
+#define LOCKSTEP_IO_FIRST	0x4000		// apu and pad registers somewhere in here; see Is_Io_Read/Write
+#define LOCKSTEP_IO_LAST	0x4017
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// what Run has done so far
+struct LOCKSTEP_STATS
+{
+	u64 steps;					// Run steps; an instruction on every running lane
+	u64 groups;					// lanes grouped by pc, per step
+	u64 vector_groups;			// groups the vector path took
+	u64 vector_lanes;			// instructions run by it
+	u64 scalar_lanes;			// instructions run one lane at a time
+	u64 io_accesses;			// apu and pad registers read or written through the LockstepIo
+	u64 io_stops;				// lanes stopped at one for want of a LockstepIo
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Where the lanes' apu and pad accesses go; lane says whose it is.
+ */
+class LockstepIo
+{
+public:
+
+	virtual ~LockstepIo() {}
+
+	virtual u8 Read(u32 lane, u16 addr) = 0;
+	virtual void Write(u32 lane, u16 addr, u8 data) = 0;
+};
+
+
+/**
+ * The lanes themselves.
+ */
+class Lockstep6502
+{
+public:
+
+	Lockstep6502(u32 lanes = LOCKSTEP_LANES);
+	~Lockstep6502();
+
+	u32 Lanes() const { return lanes; }
+	bool Vector() const { return bvector; }
+	void Set_Vector(bool benable);			// off runs every lane through the scalar path
+	void Set_Io(LockstepIo* pio) { this->pio = pio; }
+
+	// a lane from or to a machine; the cpu should be between instructions
+	void Load_Lane(u32 lane, const Bus& bus);
+	void Store_Lane(u32 lane, Bus& bus) const;
+
+	void Get_State(u32 lane, CPU_STATE& state) const;
+	u64 Cycles(u32 lane) const { return cycles[lane]; }		// run by the lane, all told
+	u8 Peek(u32 lane, u16 addr) const { return mem[(u32)addr * LOCKSTEP_LANES + lane]; }
+
+	u32 Run(u64 steps);
+	u32 Stopped() const { return stopped; }	// lanes waiting on a Load_Lane, one bit each
+	const LOCKSTEP_STATS& Stats() const { return stats; }
+
+private:
+
+	u32 lanes;
+	u32 running;				// lanes in use, one bit each
+	u32 stopped;
+	u32 rom_start;				// as the bus had it; writes from here up are dropped
+	bool bvector;
+	LockstepIo* pio;
+
+	// registers, one per lane
+	alignas(32) u16 pc[LOCKSTEP_LANES];
+	alignas(16) u8 a[LOCKSTEP_LANES];
+	alignas(16) u8 x[LOCKSTEP_LANES];
+	alignas(16) u8 y[LOCKSTEP_LANES];
+	alignas(16) u8 sp[LOCKSTEP_LANES];
+	alignas(16) u8 status[LOCKSTEP_LANES];
+	alignas(32) u64 cycles[LOCKSTEP_LANES];
+
+	std::unique_ptr<u8[]> mem;	// RAM_SIZE rows of LOCKSTEP_LANES bytes
+
+	// the opcode table, from CPU6502
+	u8 kind[256];				// which instruction; LK_* in the .cpp
+	u8 mode[256];				// ADDRMODE
+	u8 bytes[256];
+	u8 base_cycles[256];
+
+	LOCKSTEP_STATS stats;
+
+	u32 Same_Pc(u16 at) const;
+	u32 Same_Code(u32 lead, u16 at, u32 group) const;
+	u32 Step_Group(u32 group, u16 at);
+	bool Step_Lane(u32 lane);
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -13,7 +13,7 @@
 //	14th of November 2022, Monday
 //
 // Last Update:
-//	15th of Novemeber 2022, Tuesday
+//	19th of October 2026, Monday
 //
 // Compiled On:
 //	HP Pavallion (Areselaliyur) running on Intel Core I7 16GB RAM on Microsoft's Windows 11. 
@@ -40,6 +40,9 @@
 
 #include "OldX.h"
 #include "Bus.h"
+#include "InputSource.h"
+#include "LatencyTracer.h"
+#include "RunAhead.h"
 
 //=========================================================================================================|
 // MACROS
@@ -53,13 +56,6 @@
 						 MessageBoxA(NULL, text, "Err Box", MB_ICONERROR);}
 
 
-// read keyboard in async mode; pull me a fast one on Windows
-#define KEY_DOWN(vkcode)	(GetAsyncKeyState(vkcode) & 0x80) ? 1 : 0
-
-
-// virtual key code constants
-#define VK_F	0x46
-
 
 
 //=========================================================================================================|
@@ -71,6 +67,21 @@ HWND main_window_handle = NULL;
 char text[MAX_PATH];		// gen text buffer
 bool bfullscreen = true;	// tracks the state of screen
 Bus bus;
+KeyboardInput keyboard;		// where the pads come from; any InputSource does
+InputSource* pinput = &keyboard;
+RunAhead ahead(bus, 0);		// frames shown ahead to hide the game's own lag; 0 is off, up to RUNAHEAD_MAX
+LatencyTracer latency;		// sample to read to shown frame, for every pad change; reported on shutdown
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// what's shown; until there's a picture, only the latency tracer looks at it
+class TracedPresenter : public FramePresenter
+{
+public:
+	void Present(const Bus&) override { latency.Frame_End(); }
+} presenter;
 
 
 
@@ -191,7 +202,9 @@ int Init()
 	if (Init_DDraw(WINDOW_WIDTH, WINDOW_HEIGHT) < 0)
 		return -1;
 
-	bus.cpu6502.Reset();
+	bus.Reset();
+	latency.Attach(bus);
+	ahead.Set_Presenter(&presenter);
 	return 0;
 } // end Init
 
@@ -201,25 +214,31 @@ int Init()
 //	too many times, however, I had a fake console that is pretty much NES rip-off in a cheap way, it was
 //	called Terminator 2 yah, just like the terminator, had six buttons that I never got to figure why since
 //	only two were used on these games ...).
+//
+//	One call is one frame: the input is sampled once, up front, and the game sees it through the pads'
+//	shift registers for the rest of the frame.
 int Run()
 {
-	// test user key's first at every iteration
-	if (KEY_DOWN(VK_ESCAPE))
+	INPUT_FRAME in;
+	pinput->Sample(bus.frame_count, in);
+	for (u8 port = 0; port < 2; port++)
+		if (in.pads[port] != bus.controller[port])
+			latency.Input(port, in.pads[port]);		// stamped right after GetAsyncKeyState
+
+	if (in.hotkeys & HOTKEY_QUIT)
 	{
 		PostQuitMessage(0);
-		return;
+		return 0;
 	} // end if
 
-
-	if (KEY_DOWN(VK_F))
+	if (in.hotkeys & HOTKEY_FULLSCREEN)
 	{
 		Shutdown_DDraw();
 		bfullscreen = !bfullscreen;
 		Init_DDraw(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_BPP, bfullscreen);
 	} // en if toggle fullscreen
 
-
-	bus.cpu6502.Clock();
+	ahead.Run_Frame(in);
 	return 0;
 } // end Run
 
@@ -230,6 +249,14 @@ int Run()
 int Shutdown()
 {
 	Shutdown_DDraw();
+
+	LATENCY_STATS ls;
+	latency.Get_Stats(ls);
+	snprintf(text, MAX_PATH, "latency: %llu changes, %llu answered; p50 %.0f p99 %.0f frames, "
+		"%.1f / %.1f ms host; output changed on %llu of %llu frames\n", (unsigned long long)ls.changes,
+		(unsigned long long)ls.answered, ls.frames.p50, ls.frames.p99, ls.host_ms.p50, ls.host_ms.p99,
+		(unsigned long long)ls.changed, (unsigned long long)ls.shown);
+	OutputDebugStringA(text);
 	return 0;
 } // end shutdown
 
@@ -0,0 +1,68 @@
+//=========================================================================================================|
+// MemHeat.cpp
+//	Snapshot writing for the memory heat counters; see MemHeat.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstring>
+
+#include "MemHeat.h"
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Starts a heat file; level 2 files carry per byte rows, level 1 per page.
+ */
+bool Write_Heat_Header(FILE* fp, int level)
+{
+	HEAT_HEADER h;
+	memcpy(h.magic, HEAT_MAGIC, sizeof(h.magic));
+	h.level = level;
+	h.rows = level >= 2 ? HEAT_BYTES : HEAT_PAGES;
+	return fwrite(&h, sizeof(h), 1, fp) == 1;
+} // end Write_Heat_Header
+
+
+//=========================================================================================================|
+/**
+ * Appends the counts as they stand, in the file's granularity. frames is how many frames they cover.
+ */
+bool Write_Heat_Snapshot(FILE* fp, const MEM_HEAT& heat, u64 frame, u64 frames)
+{
+	HEAT_SNAPSHOT s = { frame, frames };
+	if (fwrite(&s, sizeof(s), 1, fp) != 1)
+		return false;
+
+	for (int k = 0; k < HEAT_KINDS; k++)
+	{
+		bool bok = heat.level >= 2 ?
+			fwrite(heat.byte[k].data(), sizeof(u64), HEAT_BYTES, fp) == HEAT_BYTES :
+			fwrite(heat.page[k], sizeof(u64), HEAT_PAGES, fp) == HEAT_PAGES;
+		if (!bok)
+			return false;
+	} // end for
+
+	return true;
+} // end Write_Heat_Snapshot
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,180 @@
+//=========================================================================================================|
+// MemHeat.h
+//	Memory access heat: how often each page (and optionally each byte) of the 64K gets read, written and
+//	executed, plus how often code that has already run gets written over (self-modifying code, or a
+//	buffer that doubles as code).
+//
+//	Like the cpu's counters this is chosen at compile time; XNEST_HEATMAP picks the policy Bus carries:
+//		0 : nothing; every hook is an empty inline and the build is the same as without them
+//		1 : per page counts
+//		2 : per page and per byte counts (2 MB of counters)
+//
+//	Snapshots go to a flat binary file (HEAT_HEADER then HEAT_SNAPSHOT + counts, over and over) that
+//	Tools/HeatmapPng renders.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef MEMHEAT_H
+#define MEMHEAT_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#ifndef XNEST_HEATMAP
+#define XNEST_HEATMAP		0
+#endif
+
+#define HEAT_MAGIC			"XNHEAT01"
+#define HEAT_PAGES			256
+#define HEAT_BYTES			65536
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+
+enum HEAT_KIND
+{
+	HEAT_READ,
+	HEAT_WRITE,
+	HEAT_EXEC,			// opcode fetches
+	HEAT_SMC,			// writes to something that has been executed
+	HEAT_KINDS
+};
+
+
+/**
+ * The counters proper. byte[] is empty unless level is 2. For level 1 HEAT_SMC can only go by page, so it
+ *	counts writes to any page that has had code run in it.
+ */
+struct MEM_HEAT
+{
+	int level;
+	u64 page[HEAT_KINDS][HEAT_PAGES];
+	std::vector<u64> byte[HEAT_KINDS];
+};
+
+
+// file header; rows is HEAT_PAGES or HEAT_BYTES
+struct HEAT_HEADER
+{
+	char magic[8];
+	u32 level;
+	u32 rows;
+};
+
+
+// in front of each snapshot's counts, which are u64[HEAT_KINDS][rows]
+struct HEAT_SNAPSHOT
+{
+	u64 frame;			// frame count at the time of the snapshot
+	u64 frames;			// how many frames the counts cover
+};
+
+
+/**
+ * The policy. Level 0 is what normal builds get; empty inlines and nothing to hold.
+ */
+template <int level>
+struct MemHeat
+{
+	static constexpr int LEVEL = 0;
+
+	void Read(u16) {}
+	void Write(u16) {}
+	void Execute(u16) {}
+	void Clear() {}
+	const MEM_HEAT* Get() const { return nullptr; }
+};
+
+
+template <>
+struct MemHeat<1>
+{
+	static constexpr int LEVEL = 1;
+
+	MEM_HEAT h = { 1 };
+
+	void Read(u16 addr) { h.page[HEAT_READ][addr >> 8]++; }
+	void Execute(u16 addr) { h.page[HEAT_EXEC][addr >> 8]++; }
+	void Write(u16 addr)
+	{
+		h.page[HEAT_WRITE][addr >> 8]++;
+		if (h.page[HEAT_EXEC][addr >> 8])
+			h.page[HEAT_SMC][addr >> 8]++;
+	}
+
+	void Clear() { h = MEM_HEAT{ 1 }; }
+	const MEM_HEAT* Get() const { return &h; }
+};
+
+
+template <>
+struct MemHeat<2>
+{
+	static constexpr int LEVEL = 2;
+
+	MEM_HEAT h;
+	MemHeat() { Clear(); }
+
+	void Read(u16 addr) { h.page[HEAT_READ][addr >> 8]++; h.byte[HEAT_READ][addr]++; }
+	void Execute(u16 addr) { h.page[HEAT_EXEC][addr >> 8]++; h.byte[HEAT_EXEC][addr]++; }
+	void Write(u16 addr)
+	{
+		h.page[HEAT_WRITE][addr >> 8]++;
+		h.byte[HEAT_WRITE][addr]++;
+		if (h.byte[HEAT_EXEC][addr])
+		{
+			h.page[HEAT_SMC][addr >> 8]++;
+			h.byte[HEAT_SMC][addr]++;
+		} // end if
+	}
+
+	void Clear()
+	{
+		h = MEM_HEAT{ 2 };
+		for (auto& b : h.byte)
+			b.assign(HEAT_BYTES, 0);
+	}
+
+	const MEM_HEAT* Get() const { return &h; }
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+bool Write_Heat_Header(FILE* fp, int level);
+bool Write_Heat_Snapshot(FILE* fp, const MEM_HEAT& heat, u64 frame, u64 frames);
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,296 @@
+//=========================================================================================================|
+// Metrics.cpp
+//	The shared memory block and the sequence lock around it; see Metrics.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Metrics.h"
+#include "AudioRing.h"
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define METRICS_READ_TRIES	1000		// a reader gives up after this many torn copies in a row
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; not publishing anything until Open.
+ */
+Metrics::Metrics()
+	:pblock{ nullptr }, paudio{ nullptr }, window_frame{ 0 }, window_clock{ 0 }, window_cpu{ 0 }
+{
+
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+Metrics::~Metrics()
+{
+	Close();
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Creates (or takes over) the shared memory called name, e.g. "/xnest", and starts a fresh block in it.
+ */
+bool Metrics::Open(const char* shm_name)
+{
+	Close();
+
+#ifdef _WIN32
+	error = "shared memory metrics need a POSIX host";
+	(void)shm_name;
+	return false;
+#else
+	int fd = shm_open(shm_name, O_CREAT | O_RDWR, 0644);
+	if (fd < 0)
+	{
+		error = std::string("can't open shared memory ") + shm_name + ": " + strerror(errno);
+		return false;
+	} // end if
+
+	void* p = MAP_FAILED;
+	if (ftruncate(fd, sizeof(METRICS_BLOCK)) == 0)
+		p = mmap(nullptr, sizeof(METRICS_BLOCK), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	int err = errno;
+	close(fd);
+
+	if (p == MAP_FAILED)
+	{
+		error = std::string("can't map shared memory ") + shm_name + ": " + strerror(err);
+		shm_unlink(shm_name);
+		return false;
+	} // end if
+
+	// readers go by the magic; it's written last so nobody takes a half made block for a good one
+	pblock = new (p) METRICS_BLOCK;
+	memset(pblock->magic, 0, sizeof(pblock->magic));
+	pblock->version = METRICS_VERSION;
+	pblock->size = sizeof(METRICS_BLOCK);
+	pblock->seq.store(0, std::memory_order_relaxed);
+	pblock->pid = (u32)getpid();
+	memset(&pblock->data, 0, sizeof(pblock->data));
+	std::atomic_thread_fence(std::memory_order_release);
+	memcpy(pblock->magic, METRICS_MAGIC, sizeof(pblock->magic));
+
+	name = shm_name;
+	opened = last_frame = window_start = CLOCK::now();
+	window_frame = window_clock = 0;
+	double user, system;
+	Cpu_Times(user, system);
+	window_cpu = user + system;
+	return true;
+#endif
+} // end Open
+
+
+//=========================================================================================================|
+/**
+ * Stops publishing and removes the shared memory; readers that still have it mapped keep the last numbers.
+ */
+void Metrics::Close()
+{
+#ifndef _WIN32
+	if (!pblock)
+		return;
+
+	munmap(pblock, sizeof(METRICS_BLOCK));
+	shm_unlink(name.c_str());
+	pblock = nullptr;
+#endif
+} // end Close
+
+
+//=========================================================================================================|
+/**
+ * Publishes the frame the bus has just finished. Call once per frame; the time between calls is what goes
+ *	into the histogram.
+ */
+void Metrics::Frame(const Bus& bus)
+{
+	if (!pblock)
+		return;
+
+	CLOCK::time_point now = CLOCK::now();
+	u64 us = (u64)std::chrono::duration_cast<std::chrono::microseconds>(now - last_frame).count();
+	last_frame = now;
+
+	int bucket = 0;
+	while (bucket < METRICS_BUCKETS - 1 && (us >> (bucket + 1)))
+		bucket++;
+
+	pblock->seq.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	METRICS_DATA& d = pblock->data;
+	d.frame = bus.frame_count;
+	d.system_clock = bus.system_clock;
+	d.wall_seconds = std::chrono::duration<double>(now - opened).count();
+	d.frame_ms = us / 1000.0;
+	d.frame_hist[bucket]++;
+	if (paudio)
+	{
+		d.audio_fill = paudio->Fill();
+		d.audio_capacity = paudio->Capacity();
+	} // end if
+
+	double window = std::chrono::duration<double>(now - window_start).count();
+	if (window * 1000 >= METRICS_WINDOW_MS)
+	{
+		double user, system;
+		Cpu_Times(user, system);
+		d.cpu_user_seconds = user;
+		d.cpu_system_seconds = system;
+		d.cpu_load = (user + system - window_cpu) / window;
+		d.mhz = (bus.system_clock - window_clock) / window / 1e6;
+		d.fps = (bus.frame_count - window_frame) / window;
+
+		window_start = now;
+		window_frame = bus.frame_count;
+		window_clock = bus.system_clock;
+		window_cpu = user + system;
+	} // end if
+
+	pblock->seq.fetch_add(1, std::memory_order_release);
+} // end Frame
+
+
+//=========================================================================================================|
+/**
+ * Maps someone else's block read only, checking it's one this build understands. Null with error set if not.
+ */
+const METRICS_BLOCK* Metrics::Map(const char* shm_name, std::string& error)
+{
+#ifdef _WIN32
+	error = "shared memory metrics need a POSIX host";
+	(void)shm_name;
+	return nullptr;
+#else
+	int fd = shm_open(shm_name, O_RDONLY, 0);
+	if (fd < 0)
+	{
+		error = std::string("can't open shared memory ") + shm_name + ": " + strerror(errno);
+		return nullptr;
+	} // end if
+
+	struct stat st;
+	void* p = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(METRICS_BLOCK))
+		p = mmap(nullptr, sizeof(METRICS_BLOCK), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (p == MAP_FAILED)
+	{
+		error = std::string(shm_name) + " is not a metrics block";
+		return nullptr;
+	} // end if
+
+	const METRICS_BLOCK* pb = (const METRICS_BLOCK*)p;
+	if (memcmp(pb->magic, METRICS_MAGIC, sizeof(pb->magic)) || pb->version != METRICS_VERSION ||
+		pb->size != sizeof(METRICS_BLOCK))
+	{
+		error = std::string(shm_name) + " is not a metrics block this build understands";
+		munmap(p, sizeof(METRICS_BLOCK));
+		return nullptr;
+	} // end if
+
+	return pb;
+#endif
+} // end Map
+
+
+//=========================================================================================================|
+/**
+ * Lets go of a block from Map.
+ */
+void Metrics::Unmap(const METRICS_BLOCK* pb)
+{
+#ifndef _WIN32
+	if (pb)
+		munmap((void*)pb, sizeof(METRICS_BLOCK));
+#endif
+} // end Unmap
+
+
+//=========================================================================================================|
+/**
+ * Takes a consistent copy of the numbers in block: copies them out between two reads of seq and tries
+ *	again if the writer was in there meanwhile. False only if every try was torn, i.e. the writer is going
+ *	flat out and the reader keeps losing the race.
+ */
+bool Metrics::Read(const METRICS_BLOCK& block, METRICS_DATA& copy)
+{
+	for (int i = 0; i < METRICS_READ_TRIES; i++)
+	{
+		u32 before = block.seq.load(std::memory_order_acquire);
+		if (before & 1)
+			continue;
+
+		memcpy(&copy, (const void*)&block.data, sizeof(copy));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (block.seq.load(std::memory_order_relaxed) == before)
+			return true;
+	} // end for
+
+	return false;
+} // end Read
+
+
+//=========================================================================================================|
+/**
+ * User and system cpu time of this process so far, in seconds.
+ */
+void Metrics::Cpu_Times(double& user, double& system)
+{
+	user = system = 0;
+#ifndef _WIN32
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru) == 0)
+	{
+		user = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6;
+		system = ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+	} // end if
+#endif
+} // end Cpu_Times
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,146 @@
+//=========================================================================================================|
+// Metrics.h
+//	Live performance numbers published in shared memory, for dashboards and other processes to watch while
+//	the emulator runs. No socket, no file, no calls on the reader's behalf: the emulator fills in a fixed
+//	layout block (METRICS_BLOCK) once a frame and anybody who maps the same name reads it whenever they like.
+//
+//	The block is guarded by a sequence lock. The writer bumps seq to odd, writes, and bumps it back to even.
+//	A reader copies the block out and keeps the copy only if seq was the same even number before and after.
+//	The writer never waits on a reader, so watching costs the emulator nothing.
+//
+//	Most of what's in the block is cheap to keep up per frame (two clock reads and a few adds). The rates and
+//	the host cpu time are worked out over windows of METRICS_WINDOW_MS, so the getrusage call happens a few
+//	times a second rather than every frame.
+//
+//	The shared memory is POSIX (shm_open; the name shows up under /dev/shm on Linux). Tools/MetricsView is
+//	the reader for trying it out.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef METRICS_H
+#define METRICS_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define METRICS_MAGIC		"XNMETRIC"
+#define METRICS_VERSION		1
+#define METRICS_BUCKETS		24			// frame time histogram; bucket i is [2^i, 2^(i+1)) microseconds
+#define METRICS_WINDOW_MS	250			// how often the rates are worked out again
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+
+// the numbers; plain data, so a reader can take a copy of them in one go
+struct METRICS_DATA
+{
+	u64 frame;					// frames run
+	u64 system_clock;			// cpu cycles run
+	double wall_seconds;		// since the block was opened
+
+	double mhz;					// emulated cpu speed over the last window
+	double fps;					// frames per second over the last window
+	double frame_ms;			// host time of the latest frame
+	u64 frame_hist[METRICS_BUCKETS];	// host time of every frame so far, log2 microsecond buckets
+
+	u32 audio_fill;				// samples waiting in the audio ring; 0 with no ring attached
+	u32 audio_capacity;			// its size; 0 with no ring attached
+
+	u64 cache_lookups;			// decode/translation cache; the interpreter has none yet, so these stay 0
+	u64 cache_hits;
+
+	double cpu_user_seconds;	// host cpu time of the whole process, all threads
+	double cpu_system_seconds;
+	double cpu_load;			// host cpu seconds per wall second over the last window; >1 with threads
+};
+
+
+// what sits in the shared memory; all fixed size, naturally aligned and the same for every build
+struct METRICS_BLOCK
+{
+	char magic[8];				// METRICS_MAGIC, no terminator
+	u32 version;				// METRICS_VERSION
+	u32 size;					// sizeof(METRICS_BLOCK)
+	std::atomic<u32> seq;		// odd while the writer is in the middle of an update
+	u32 pid;					// of the writer
+	METRICS_DATA data;
+};
+
+
+class Bus;
+class AudioRing;
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class Metrics
+{
+public:
+
+	Metrics();
+	~Metrics();
+
+	// writer side
+	bool Open(const char* name);
+	void Close();
+	void Set_Audio(const AudioRing* pring) { paudio = pring; }
+	void Frame(const Bus& bus);
+
+	// reader side
+	static const METRICS_BLOCK* Map(const char* name, std::string& error);
+	static void Unmap(const METRICS_BLOCK* pblock);
+	static bool Read(const METRICS_BLOCK& block, METRICS_DATA& copy);
+
+	const std::string& Error() const { return error; }
+
+private:
+
+	METRICS_BLOCK* pblock;		// in the shared memory; null when not open
+	std::string name;
+	std::string error;
+	const AudioRing* paudio;
+
+	typedef std::chrono::steady_clock CLOCK;
+	CLOCK::time_point opened;
+	CLOCK::time_point last_frame;
+	CLOCK::time_point window_start;
+	u64 window_frame;			// frame and clock count at window_start
+	u64 window_clock;
+	double window_cpu;			// host cpu seconds at window_start
+
+	static void Cpu_Times(double& user, double& system);
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
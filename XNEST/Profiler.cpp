@@ -0,0 +1,315 @@
+//=========================================================================================================|
+// Profiler.cpp
+//	Sampled pc histogram and call tree for the guest program; see Profiler.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+
+#include "Profiler.h"
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+static const char* KIND_PREFIX[5] = { "reset", "sub", "brk", "nmi", "irq" };
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; sample_period is in cpu cycles.
+ */
+Profiler::Profiler(u32 period)
+	:pcpu{ nullptr }, histogram(65536, 0), sample_period{ period ? period : 1 }
+{
+	Clear();
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor; lets go of the cpu if still attached.
+ */
+Profiler::~Profiler()
+{
+	Detach();
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Starts profiling cpu; cycles from here on are charged to the root till the first call.
+ */
+void Profiler::Attach(CPU6502& cpu)
+{
+	Detach();
+
+	pcpu = &cpu;
+	cpu.Set_Sample_Period(sample_period);
+	cpu.Attach(this, OBSERVE_FLOW | OBSERVE_SAMPLES);
+	last_cycles = cpu.Observed_Cycles();
+} // end Attach
+
+
+//=========================================================================================================|
+/**
+ * Stops profiling, charging whatever ran since the last call or return to the frame it ran in. The
+ *	results stay put till Clear.
+ */
+void Profiler::Detach()
+{
+	if (!pcpu)
+		return;
+
+	Charge(*pcpu);
+	pcpu->Detach(this);
+	pcpu = nullptr;
+} // end Detach
+
+
+//=========================================================================================================|
+/**
+ * Forgets everything; the shadow stack starts over at the root.
+ */
+void Profiler::Clear()
+{
+	std::fill(histogram.begin(), histogram.end(), 0);
+	samples = total_cycles = dropped_calls = 0;
+	last_cycles = pcpu ? pcpu->Observed_Cycles() : 0;
+
+	nodes.clear();
+	nodes.push_back({ 0, PROFILE_ROOT, PROFILER_NO_NODE, PROFILER_NO_NODE, PROFILER_NO_NODE, 1, 0 });
+
+	stack[0].node = 0;
+	stack[0].sp_at_call = 0xFFFF;
+	depth = 1;
+} // end Clear
+
+
+//=========================================================================================================|
+/**
+ * Gives the frame on top everything that ran since it was last charged.
+ */
+void Profiler::Charge(const CPU6502& cpu)
+{
+	u64 now = cpu.Observed_Cycles();
+	nodes[stack[depth - 1].node].self_cycles += now - last_cycles;
+	total_cycles += now - last_cycles;
+	last_cycles = now;
+} // end Charge
+
+
+//=========================================================================================================|
+/**
+ * Keeps the shadow stack in step with calls and returns. The call/return instruction itself (and the
+ *	interrupt sequence) is charged to the frame we're leaving.
+ */
+void Profiler::Flow(const CPU6502& cpu, CPU_FLOW kind, u16 pc)
+{
+	Charge(cpu);
+
+	switch (kind)
+	{
+	case FLOW_JSR:	Push(cpu.Pc(), PROFILE_JSR, cpu.Sp() + 2); break;		// JSR pushed two bytes
+	case FLOW_BRK:	Push(cpu.Pc(), PROFILE_BRK, cpu.Sp() + 3); break;		// the rest pushed three
+	case FLOW_NMI:	Push(cpu.Pc(), PROFILE_NMI, cpu.Sp() + 3); break;
+	case FLOW_IRQ:	Push(cpu.Pc(), PROFILE_IRQ, cpu.Sp() + 3); break;
+	case FLOW_RTS:
+	case FLOW_RTI:	Pop_To(cpu.Sp()); break;
+	} // end switch
+} // end Flow
+
+
+//=========================================================================================================|
+/**
+ * One more hit for pc.
+ */
+void Profiler::Sample(const CPU6502& cpu, u16 pc)
+{
+	histogram[pc]++;
+	samples++;
+} // end Sample
+
+
+//=========================================================================================================|
+/**
+ * Finds (or makes) the child of parent for entry reached as kind.
+ */
+u32 Profiler::Child(u32 parent, u16 entry, u8 kind)
+{
+	u32 n = nodes[parent].first_child;
+	for (; n != PROFILER_NO_NODE; n = nodes[n].next_sibling)
+		if (nodes[n].entry == entry && nodes[n].kind == kind)
+			return n;
+
+	n = (u32)nodes.size();
+	nodes.push_back({ entry, kind, parent, PROFILER_NO_NODE, nodes[parent].first_child, 0, 0 });
+	nodes[parent].first_child = n;
+	return n;
+} // end Child
+
+
+//=========================================================================================================|
+/**
+ * Enters a subroutine/handler. Past PROFILER_MAX_DEPTH the call is only counted as dropped and its
+ *	cycles stay with the deepest frame we have.
+ */
+void Profiler::Push(u16 entry, u8 kind, u16 sp_at_call)
+{
+	if (depth == PROFILER_MAX_DEPTH)
+	{
+		dropped_calls++;
+		return;
+	} // end if
+
+	u32 n = Child(stack[depth - 1].node, entry, kind);
+	nodes[n].calls++;
+	stack[depth].node = n;
+	stack[depth].sp_at_call = sp_at_call;
+	depth++;
+} // end Push
+
+
+//=========================================================================================================|
+/**
+ * After a return with the stack pointer at sp, drops every frame whose call sat at or below it.
+ */
+void Profiler::Pop_To(u8 sp)
+{
+	while (depth > 1 && stack[depth - 1].sp_at_call <= sp)
+		depth--;
+} // end Pop_To
+
+
+//=========================================================================================================|
+/**
+ * Writes a frame's name into buf: reset, sub_C0DE, nmi_C0DE and so on.
+ */
+void Profiler::Name(u16 entry, u8 kind, char* buf, size_t len)
+{
+	if (kind == PROFILE_ROOT)
+		snprintf(buf, len, "%s", KIND_PREFIX[kind]);
+	else
+		snprintf(buf, len, "%s_%04X", KIND_PREFIX[kind], entry);
+} // end Name
+
+
+//=========================================================================================================|
+/**
+ * Sums the call tree up per subroutine, sorted by exclusive cycles, biggest first. A subroutine that is
+ *	already on the path (recursion) doesn't get its inclusive cycles counted a second time.
+ */
+void Profiler::Get_Functions(std::vector<PROFILE_FUNCTION>& out) const
+{
+	// subtree totals, children always come after their parents in nodes
+	std::vector<u64> subtree(nodes.size());
+	for (size_t i = nodes.size(); i-- > 0; )
+	{
+		subtree[i] += nodes[i].self_cycles;
+		if (nodes[i].parent != PROFILER_NO_NODE)
+			subtree[nodes[i].parent] += subtree[i];
+	} // end for
+
+	std::map<u32, PROFILE_FUNCTION> funcs;
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		const PROFILE_NODE& n = nodes[i];
+		u32 key = ((u32)n.kind << 16) | n.entry;
+
+		PROFILE_FUNCTION& f = funcs[key];
+		f.entry = n.entry;
+		f.kind = n.kind;
+		f.calls += n.calls;
+		f.exclusive += n.self_cycles;
+
+		bool brecursive = false;
+		for (u32 p = n.parent; p != PROFILER_NO_NODE && !brecursive; p = nodes[p].parent)
+			brecursive = nodes[p].entry == n.entry && nodes[p].kind == n.kind;
+		if (!brecursive)
+			f.inclusive += subtree[i];
+	} // end for
+
+	out.clear();
+	for (const auto& kv : funcs)
+		out.push_back(kv.second);
+
+	std::sort(out.begin(), out.end(),
+		[](const PROFILE_FUNCTION& l, const PROFILE_FUNCTION& r) { return l.exclusive > r.exclusive; });
+} // end Get_Functions
+
+
+//=========================================================================================================|
+/**
+ * One line per call path that ran any cycles of its own: "reset;sub_C000;sub_C123 4242".
+ */
+bool Profiler::Write_Collapsed(const char* path) const
+{
+	FILE* fp = fopen(path, "w");
+	if (!fp)
+		return false;
+
+	std::vector<std::string> paths(nodes.size());
+	char name[32];
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		Name(nodes[i].entry, nodes[i].kind, name, sizeof(name));
+		paths[i] = i ? paths[nodes[i].parent] + ";" + name : std::string(name);
+
+		if (nodes[i].self_cycles)
+			fprintf(fp, "%s %llu\n", paths[i].c_str(), (unsigned long long)nodes[i].self_cycles);
+	} // end for
+
+	fclose(fp);
+	return true;
+} // end Write_Collapsed
+
+
+//=========================================================================================================|
+/**
+ * The sampled addresses, hottest first: "$C123 1234 5.67%".
+ */
+bool Profiler::Write_Histogram(const char* path) const
+{
+	FILE* fp = fopen(path, "w");
+	if (!fp)
+		return false;
+
+	std::vector<u32> hot;
+	for (u32 addr = 0; addr < 65536; addr++)
+		if (histogram[addr])
+			hot.push_back(addr);
+
+	std::sort(hot.begin(), hot.end(), [this](u32 l, u32 r) { return histogram[l] > histogram[r]; });
+
+	for (u32 addr : hot)
+		fprintf(fp, "$%04X %u %.2f%%\n", addr, histogram[addr], 100.0 * histogram[addr] / samples);
+
+	fclose(fp);
+	return true;
+} // end Write_Histogram
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
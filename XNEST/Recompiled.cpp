@@ -0,0 +1,146 @@
+//=========================================================================================================|
+// Recompiled.cpp
+//	Runs the blocks of a recompiled rom; see Recompiled.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstring>
+
+#include "Recompiled.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FNV_OFFSET			0xCBF29CE484222325ull
+#define FNV_PRIME			0x100000001B3ull
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; module has to outlive this.
+ */
+Recompiled::Recompiled(const RECOMP_MODULE& module)
+	:module{ module }, pbus{ nullptr }, stats{}
+{
+
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor; the bus goes back to the interpreter.
+ */
+Recompiled::~Recompiled()
+{
+	Detach();
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Has bus run frames through the module from now on, if its rom is the module's.
+ */
+bool Recompiled::Attach(Bus& bus)
+{
+	Detach();
+
+	if (CpuCounters<XNEST_CPU_STATS != 0>::ENABLED || MemHeat<XNEST_HEATMAP>::LEVEL)
+	{
+		error = "recompiled code doesn't count instructions or memory heat; use a build without them";
+		return false;
+	} // end if
+
+	u64 h = FNV_OFFSET;
+	for (u32 i = bus.rom_start; i < RAM_SIZE; i++)
+		h = (h ^ bus.ram[i]) * FNV_PRIME;
+	if (bus.rom_start != module.rom_start || h != module.rom_hash)
+	{
+		error = std::string("the rom in isn't the one recompiled (") + module.rom + ")";
+		return false;
+	} // end if
+
+	table.reset(new RECOMP_BLOCK[RAM_SIZE]);
+	memset(table.get(), 0, RAM_SIZE * sizeof(RECOMP_BLOCK));
+	for (u32 i = 0; i < module.count; i++)
+		table[module.entries[i].pc] = module.entries[i].block;
+
+	pbus = &bus;
+	pbus->precompiled = this;
+	error.clear();
+	return true;
+} // end Attach
+
+
+//=========================================================================================================|
+/**
+ * Back to the interpreter alone.
+ */
+void Recompiled::Detach()
+{
+	if (pbus && pbus->precompiled == this)
+		pbus->precompiled = nullptr;
+	pbus = nullptr;
+} // end Detach
+
+
+//=========================================================================================================|
+/**
+ * Runs till the bus' run_until: blocks wherever the cpu is between instructions at a pc that has one,
+ *	the interpreter a cycle at a time everywhere else.
+ */
+void Recompiled::Run()
+{
+	Bus& bus = *pbus;
+	CPU6502& cpu = bus.cpu6502;
+
+	while (bus.system_clock < bus.run_until)
+	{
+		RECOMP_BLOCK block = nullptr;
+		if (cpu.Complete() && !bus.breakpoints.Armed() && !cpu.Observed())
+		{
+			block = table[cpu.Pc()];
+			stats.misses += !block;
+		} // end if
+
+		u64 from = bus.system_clock;
+		if (!block)
+		{
+			bus.Clock();
+			stats.interpreted_cycles++;
+			continue;
+		} // end if
+
+		CPU_STATE s;
+		cpu.Save_State(s);
+		do
+			stats.blocks++;
+		while (block(bus, s) && (block = table[s.pc]));
+		cpu.Load_State(s);
+
+		stats.compiled_cycles += bus.system_clock - from;
+	} // end while
+} // end Run
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,197 @@
+//=========================================================================================================|
+// Recompiled.h
+//	Runs a rom's code as C++ compiled ahead of time, with the interpreter for everything else.
+//
+//	Tools/Recompile starts from the reset, NMI and IRQ vectors. It follows every branch, jump and call
+//	through the cartridge rom, using the cpu's own opcode table, and writes each basic block out as a C++
+//	function. That file is a RECOMP_MODULE. It gets compiled into a build of its own (make
+//	bin/Headless-recomp RECOMP_ROM=game.nes), and Recompiled runs it:
+//
+//		Recompiled recompiled(RECOMPILED_MODULE);
+//		recompiled.Attach(bus);		// after the cartridge is in; from now on Bus::Run_Frame uses it
+//
+//	Attach refuses a bus whose rom isn't the one the module was made from (a hash of everything from
+//	rom_start up). It also refuses a build with the cpu counters or memory heat compiled in; the blocks
+//	count neither.
+//
+//	A block is straight line code ending in a branch, jump, call, return, BRK, or the start of another
+//	block. Each instruction in it is the interpreter's instruction spelled out for its operands:
+//	- Operand bytes, zero page and absolute addresses, branch and jump targets, and vectors are
+//	  constants.
+//	- Memory that can only be ram or rom is an array access. Only addresses that may be registers go
+//	  through Bus::Read/Write.
+//	- What each instruction does to the registers and flags is what CPU6502 does.
+//	Where control goes is looked up in a table by pc after each block, except that a block jumping to
+//	its own start just loops. Returns, RTI and JMP (ind) are resolved there at run time. A pc with no
+//	block (code in ram, code reached only through a table, an unofficial opcode) goes to the
+//	interpreter, an instruction at a time, till it gets back to one that has a block. Tools/Recompile
+//	--entry adds entry points the walk can't see.
+//
+//	Timing is the interpreter's to the cycle. An instruction still does all its work on its first cycle
+//	and the rest are waited out. After each one, the block checks the cycles it took:
+//	- If the apu has no catching up due in them, the frame doesn't end in them, and no irq is waiting to
+//	  be taken, the clock moves on by that many and the block carries on.
+//	- Otherwise the block stops there. The interpreter waits out the cycles, so catch-up, frame end and
+//	  irq all happen on the same cycle as ever.
+//	The registers, memory, clock and audio come out as the interpreter's would. The bits of an
+//	instruction in flight (CPU_STATE's fetched, addr_abs, addr_rel, opcode) aren't kept up; they only
+//	matter in the middle of one.
+//
+//	Nothing is compiled for memory below rom_start; it may change. Breakpoints armed, observers
+//	attached or coverage on send the run back to the interpreter till they're gone; they are what
+//	watch it instruction by instruction.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef RECOMPILED_H
+#define RECOMPILED_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <memory>
+#include <string>
+
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// one basic block; true when it ended cleanly with s.pc where to go next, false when it stopped with
+// s.cycles of its last instruction for the interpreter to wait out
+typedef bool (*RECOMP_BLOCK)(Bus& bus, CPU_STATE& s);
+
+
+struct RECOMP_ENTRY
+{
+	u16 pc;
+	RECOMP_BLOCK block;
+};
+
+
+// what Tools/Recompile writes out
+struct RECOMP_MODULE
+{
+	const char* rom;			// the file it was made from, for messages
+	u32 rom_start;				// the bus' rom_start with the cartridge in
+	u64 rom_hash;				// FNV-1a of ram[rom_start .. $FFFF]
+	u32 instructions;			// compiled, over all the blocks
+	u32 count;					// blocks
+	const RECOMP_ENTRY* entries;
+};
+
+
+struct RECOMP_STATS
+{
+	u64 blocks;					// block calls
+	u64 compiled_cycles;		// cycles run in blocks
+	u64 interpreted_cycles;		// cycles run by the interpreter while attached
+	u64 misses;					// instructions the interpreter started for want of a block
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class Recompiled
+{
+public:
+
+	Recompiled(const RECOMP_MODULE& module);
+	~Recompiled();
+
+	bool Attach(Bus& bus);
+	void Detach();
+	void Run();					// Bus::Run_Frame's loop: up to the bus' run_until
+
+	const RECOMP_MODULE& Module() const { return module; }
+	const RECOMP_STATS& Stats() const { return stats; }
+	const std::string& Error() const { return error; }
+
+private:
+
+	const RECOMP_MODULE& module;
+	Bus* pbus;
+	std::unique_ptr<RECOMP_BLOCK[]> table;		// by pc; null where there's no block
+
+	RECOMP_STATS stats;
+	std::string error;
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+// what the generated blocks are made of; Bus::Read and Bus::Write less the heat, which Attach made sure
+// isn't compiled in
+
+/**
+ * A read of an address only known at run time.
+ */
+inline u8 Recomp_Read(Bus& bus, u16 addr)
+{
+	if ((u16)(addr - IO_READ_FIRST) <= IO_READ_LAST - IO_READ_FIRST)
+		return bus.Read(addr);
+	return bus.ram[addr];
+} // end Recomp_Read
+
+
+/**
+ * A write to an address only known at run time; the apu and pad registers go to the bus.
+ */
+inline void Recomp_Write(Bus& bus, u16 addr, u8 data)
+{
+	if ((u16)(addr - 0x4000) <= 0x0017)
+		bus.Write(addr, data);
+	else if (addr < bus.rom_start)
+		bus.ram[addr] = data;
+} // end Recomp_Write
+
+
+/**
+ * Z and N off the result r.
+ */
+inline void Recomp_Zn(u8& status, u8 r)
+{
+	status = (status & ~(Z | N)) | (r ? 0 : Z) | (r & N);
+} // end Recomp_Zn
+
+
+/**
+ * After an instruction of cycles cycles that the block would go on from at next: the clock moves on
+ *	and true, or, when something is due in those cycles, the block has to stop and hand them to the
+ *	interpreter.
+ */
+inline bool Recomp_Tick(Bus& bus, CPU_STATE& s, u8 cycles, u16 next)
+{
+	u64 end = bus.system_clock + cycles;
+	if (end < bus.apu_sync_clock && end < bus.run_until && !(bus.apu.Irq_Asserted() && !(s.status & I)))
+	{
+		bus.system_clock = end;
+		return true;
+	} // end if
+
+	s.pc = next;
+	s.cycles = cycles;
+	return false;
+} // end Recomp_Tick
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
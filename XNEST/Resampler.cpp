@@ -0,0 +1,382 @@
+//=========================================================================================================|
+// Resampler.cpp
+//	Implementation of the polyphase resampler; filter design plus the scalar and AVX2 dot products.
+//
+//	Phase p of the bank holds the filter sampled at distances (k - center - p / RESAMPLER_PHASES) for tap
+//	k, so an output that falls a fraction f past input sample i is just the dot product of the row nearest
+//	to f (or a blend of the rows either side of f) with the inputs starting at i. Every row is normalized
+//	to unity dc gain.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cmath>
+
+#include "Resampler.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define RESAMPLER_X86	1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define RESAMPLER_PI	3.14159265358979323846
+
+// gcc/clang only emit avx2 code in functions that ask for it; msvc emits whatever intrinsics it's given
+#if defined(RESAMPLER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2		__attribute__((target("avx2,fma")))
+#else
+#define TARGET_AVX2
+#endif
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+/**
+ * Per tier: zero crossings on each side of the sinc, kaiser beta, how close to nyquist the pass band
+ *	reaches and whether phases get interpolated (nearest phase alone tops out around 65 dB, which is
+ *	where the fast tier sits).
+ */
+static const struct
+{
+	int zero_crossings;
+	double beta;
+	double rolloff;
+	bool binterpolate;
+} QUALITY_TABLE[3] =
+{
+	{  8,  6.0, 0.85, false },		// RESAMPLE_FAST
+	{ 16,  8.0, 0.90, true },		// RESAMPLE_MEDIUM
+	{ 32, 10.0, 0.94, true }		// RESAMPLE_BEST
+};
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Zeroth order modified bessel function of the first kind; the power series converges fast enough for
+ *	the betas we use.
+ */
+static double Bessel_I0(double x)
+{
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 50; k++)
+	{
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+		if (term < sum * 1e-12)
+			break;
+	} // end for
+
+	return sum;
+} // end Bessel_I0
+
+
+//=========================================================================================================|
+/**
+ * Plain C dot product; four partial sums so the compiler has something to pipeline.
+ */
+static float Dot_Scalar(const float* x, const float* c, int n)
+{
+	float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	for (int i = 0; i < n; i += 4)
+	{
+		s0 += x[i] * c[i];
+		s1 += x[i + 1] * c[i + 1];
+		s2 += x[i + 2] * c[i + 2];
+		s3 += x[i + 3] * c[i + 3];
+	} // end for
+
+	return (s0 + s1) + (s2 + s3);
+} // end Dot_Scalar
+
+
+//=========================================================================================================|
+/**
+ * Two dot products of the same input against neighbouring phases, in one pass.
+ */
+static void Dot2_Scalar(const float* x, const float* c0, const float* c1, int n, float* s0, float* s1)
+{
+	float a0 = 0, a1 = 0, b0 = 0, b1 = 0;
+	for (int i = 0; i < n; i += 2)
+	{
+		a0 += x[i] * c0[i];
+		a1 += x[i + 1] * c0[i + 1];
+		b0 += x[i] * c1[i];
+		b1 += x[i + 1] * c1[i + 1];
+	} // end for
+
+	*s0 = a0 + a1;
+	*s1 = b0 + b1;
+} // end Dot2_Scalar
+
+
+#ifdef RESAMPLER_X86
+//=========================================================================================================|
+/**
+ * Adds up the 8 lanes of v.
+ */
+TARGET_AVX2 static inline float Horizontal_Sum(__m256 v)
+{
+	__m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+	lo = _mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+	return _mm_cvtss_f32(lo);
+} // end Horizontal_Sum
+
+
+//=========================================================================================================|
+/**
+ * AVX2/FMA dot product; two accumulators of 8 floats each. n is always a multiple of RESAMPLER_ALIGN.
+ */
+TARGET_AVX2 static float Dot_AVX2(const float* x, const float* c, int n)
+{
+	__m256 acc0 = _mm256_setzero_ps();
+	__m256 acc1 = _mm256_setzero_ps();
+
+	int i = 0;
+	for (; i + 16 <= n; i += 16)
+	{
+		acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(c + i), acc0);
+		acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(c + i + 8), acc1);
+	} // end for
+
+	if (i < n)
+		acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(c + i), acc0);
+
+	return Horizontal_Sum(_mm256_add_ps(acc0, acc1));
+} // end Dot_AVX2
+
+
+//=========================================================================================================|
+/**
+ * AVX2 flavour of Dot2; each input vector is loaded once and used twice.
+ */
+TARGET_AVX2 static void Dot2_AVX2(const float* x, const float* c0, const float* c1, int n, float* s0, float* s1)
+{
+	__m256 acc0 = _mm256_setzero_ps();
+	__m256 acc1 = _mm256_setzero_ps();
+
+	for (int i = 0; i < n; i += 8)
+	{
+		__m256 v = _mm256_loadu_ps(x + i);
+		acc0 = _mm256_fmadd_ps(v, _mm256_loadu_ps(c0 + i), acc0);
+		acc1 = _mm256_fmadd_ps(v, _mm256_loadu_ps(c1 + i), acc1);
+	} // end for
+
+	*s0 = Horizontal_Sum(acc0);
+	*s1 = Horizontal_Sum(acc1);
+} // end Dot2_AVX2
+#endif
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; call Init before use.
+ */
+Resampler::Resampler()
+	:ratio{ 1.0 }, taps{ 0 }, kernel{ KERNEL_SCALAR }, binterpolate{ false }, step{ 0 }, pos{ 0 },
+	dot{ Dot_Scalar }, dot2{ Dot2_Scalar }
+{} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+Resampler::~Resampler()
+{} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Designs the filter bank for going from in_rate to out_rate. Asking for KERNEL_AVX2 on a cpu that can't
+ *	do it fails.
+ */
+bool Resampler::Init(double in_rate, double out_rate, RESAMPLER_QUALITY quality, RESAMPLER_KERNEL k)
+{
+	if (in_rate <= 0 || out_rate <= 0 || quality < RESAMPLE_FAST || quality > RESAMPLE_BEST)
+		return false;
+
+	if (k == KERNEL_AUTO)
+		k = Has_AVX2() ? KERNEL_AVX2 : KERNEL_SCALAR;
+	else if (k == KERNEL_AVX2 && !Has_AVX2())
+		return false;
+
+	kernel = k;
+	dot = Dot_Scalar;
+	dot2 = Dot2_Scalar;
+#ifdef RESAMPLER_X86
+	if (kernel == KERNEL_AVX2)
+	{
+		dot = Dot_AVX2;
+		dot2 = Dot2_AVX2;
+	} // end if
+#endif
+
+	binterpolate = QUALITY_TABLE[quality].binterpolate;
+
+	ratio = in_rate / out_rate;
+	step = (u64)llround(ratio * ((u64)1 << RESAMPLER_FRAC_BITS));
+
+	// cutoff in cycles per input sample; when decimating the output's nyquist is the limit
+	double cutoff = 0.5 * (ratio > 1.0 ? 1.0 / ratio : 1.0) * QUALITY_TABLE[quality].rolloff;
+	double half = QUALITY_TABLE[quality].zero_crossings / (2.0 * cutoff);
+
+	taps = (int)ceil(2.0 * half);
+	taps = (taps + RESAMPLER_ALIGN - 1) / RESAMPLER_ALIGN * RESAMPLER_ALIGN;
+
+	double center = taps / 2 - 1;
+	double beta = QUALITY_TABLE[quality].beta;
+	double i0_beta = Bessel_I0(beta);
+
+	coeffs.assign((size_t)(RESAMPLER_PHASES + 1) * taps, 0.0f);
+	for (int p = 0; p <= RESAMPLER_PHASES; p++)
+	{
+		float* row = &coeffs[(size_t)p * taps];
+		double frac = (double)p / RESAMPLER_PHASES;
+		double sum = 0;
+		std::vector<double> h(taps);
+
+		for (int i = 0; i < taps; i++)
+		{
+			double d = i - center - frac;
+			double r = d / half;
+			if (r <= -1.0 || r >= 1.0)
+				continue;
+
+			double x = 2.0 * cutoff * d;
+			double sinc = x == 0 ? 1.0 : sin(RESAMPLER_PI * x) / (RESAMPLER_PI * x);
+			h[i] = sinc * Bessel_I0(beta * sqrt(1.0 - r * r)) / i0_beta;
+			sum += h[i];
+		} // end for taps
+
+		for (int i = 0; i < taps; i++)
+			row[i] = (float)(h[i] / sum);
+	} // end for phases
+
+	Reset();
+	return true;
+} // end Init
+
+
+//=========================================================================================================|
+/**
+ * Forgets all input; the history is primed with silence so the first output lines up with input 0.
+ */
+void Resampler::Reset()
+{
+	history.assign(taps / 2 - 1, 0.0f);
+	history.reserve((size_t)taps * 4 + 65536);
+	pos = 0;
+} // end Reset
+
+
+//=========================================================================================================|
+/**
+ * Appends in_count input samples and produces as many outputs as the history allows (up to out_max).
+ *	Inputs that didn't make it into an output yet are kept for the next call.
+ */
+int Resampler::Process(const float* in, int in_count, float* out, int out_max)
+{
+	if (in_count > 0)
+		history.insert(history.end(), in, in + in_count);
+
+	const int phase_shift = RESAMPLER_FRAC_BITS - RESAMPLER_PHASE_BITS;
+	const u64 frac_mask = ((u64)1 << RESAMPLER_FRAC_BITS) - 1;
+	const u64 blend_mask = ((u64)1 << phase_shift) - 1;
+	const u64 round = (u64)1 << (phase_shift - 1);
+	const size_t size = history.size();
+	const float* x = history.data();
+
+	int n = 0;
+	while (n < out_max)
+	{
+		size_t ip = (size_t)(pos >> RESAMPLER_FRAC_BITS);
+		if (ip + taps > size)
+			break;
+
+		if (binterpolate)
+		{
+			u32 phase = (u32)((pos & frac_mask) >> phase_shift);
+			float t = (float)(pos & blend_mask) / (float)((u64)1 << phase_shift);
+			float s0, s1;
+
+			dot2(x + ip, &coeffs[(size_t)phase * taps], &coeffs[(size_t)(phase + 1) * taps], taps, &s0, &s1);
+			out[n++] = s0 + (s1 - s0) * t;
+		} // end if
+		else
+		{
+			// nearest phase; RESAMPLER_PHASES itself is the row for "one whole sample later"
+			u32 phase = (u32)(((pos & frac_mask) + round) >> phase_shift);
+			out[n++] = dot(x + ip, &coeffs[(size_t)phase * taps], taps);
+		} // end else
+
+		pos += step;
+	} // end while
+
+	// drop whatever the next output no longer needs
+	size_t drop = (size_t)(pos >> RESAMPLER_FRAC_BITS);
+	if (drop > size)
+		drop = size;
+
+	history.erase(history.begin(), history.begin() + drop);
+	pos -= (u64)drop << RESAMPLER_FRAC_BITS;
+	return n;
+} // end Process
+
+
+//=========================================================================================================|
+/**
+ * True when the cpu (and the os, for the ymm state) can run the AVX2/FMA kernel.
+ */
+bool Resampler::Has_AVX2()
+{
+#if defined(RESAMPLER_X86) && defined(_MSC_VER)
+	int regs[4];
+	__cpuid(regs, 1);
+	bool bfma = (regs[2] & (1 << 12)) != 0;
+	bool bosxsave = (regs[2] & (1 << 27)) != 0;
+	if (!bfma || !bosxsave || (_xgetbv(0) & 6) != 6)
+		return false;
+
+	__cpuidex(regs, 7, 0);
+	return (regs[1] & (1 << 5)) != 0;
+#elif defined(RESAMPLER_X86)
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+	return false;
+#endif
+} // end Has_AVX2
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,124 @@
+//=========================================================================================================|
+// Resampler.h
+//	A windowed-sinc polyphase resampler for taking an emulated audio stream (anything from the APU's raw
+//	1.79 MHz clock down to some intermediate rate) to whatever the host runs at; 44.1, 48 or 96 kHz.
+//
+//	The filter is a Kaiser windowed sinc, cut just below the lower of the two nyquists, pre-computed at
+//	RESAMPLER_PHASES fractional positions. Each output sample is a dot product of the input history with
+//	the nearest phase, or for the better tiers, a blend of the two neighbouring phases (both sums come out
+//	of the same pass over the input). Those dot products are the whole cost, so they come in a scalar and
+//	an AVX2/FMA flavour picked at run time.
+//
+//	Quality tiers trade filter length (i.e. stop band attenuation and transition width) for speed. The
+//	dB figure is the worse of the tone error and the alias floor that ResamplerBench --verify measures.
+//	That check compares against analytic sines, the exact answer for a pure tone, not against a
+//	reference resampler. The cost is per 16.6 ms frame, straight from the APU's 1.79 MHz to 44.1 or
+//	48 kHz, scalar / AVX2, as Tools/ResamplerBench measures it over repeated runs:
+//		RESAMPLE_FAST	: 16 zero crossings, ~65 dB;  0.6-1.2% / 0.3-0.4%
+//		RESAMPLE_MEDIUM	: 32 zero crossings, ~85 dB;  3.5-6% / 1.0-1.8%
+//		RESAMPLE_BEST	: 64 zero crossings, ~105 dB; 6.6-12% / 2.5-3.8%
+//	On a slower host medium went as high as 9.1% and best to 22.9% scalar. Only the fast tier stays a
+//	rounding error in the frame everywhere, so it's the default. The others are for when the frame has
+//	room to spare, or for audio taken down to a lower rate first.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstdint>
+#include <vector>
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define RESAMPLER_PHASE_BITS	8
+#define RESAMPLER_PHASES		(1 << RESAMPLER_PHASE_BITS)
+#define RESAMPLER_FRAC_BITS		32
+#define RESAMPLER_ALIGN			8			// taps are padded to a multiple of one AVX register of floats
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+
+enum RESAMPLER_QUALITY
+{
+	RESAMPLE_FAST,
+	RESAMPLE_MEDIUM,
+	RESAMPLE_BEST
+};
+
+
+enum RESAMPLER_KERNEL
+{
+	KERNEL_AUTO,		// best one the cpu supports
+	KERNEL_SCALAR,
+	KERNEL_AVX2
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class Resampler
+{
+public:
+
+	Resampler();
+	~Resampler();
+
+	bool Init(double in_rate, double out_rate, RESAMPLER_QUALITY quality = RESAMPLE_FAST,
+		RESAMPLER_KERNEL kernel = KERNEL_AUTO);
+	void Reset();
+
+	// streams in_count samples through; returns the number of output samples written (at most out_max)
+	int Process(const float* in, int in_count, float* out, int out_max);
+
+	int Taps() const { return taps; }
+	double Ratio() const { return ratio; }
+	RESAMPLER_KERNEL Kernel() const { return kernel; }
+
+	static bool Has_AVX2();
+
+private:
+
+	double ratio;					// input samples per output sample
+	int taps;						// per phase, padded to RESAMPLER_ALIGN
+	RESAMPLER_KERNEL kernel;
+	bool binterpolate;				// blend neighbouring phases rather than taking the nearest
+
+	std::vector<float> coeffs;		// RESAMPLER_PHASES + 1 rows of taps; row stride == taps
+	std::vector<float> history;		// input not yet consumed, including the filter's look back
+	u64 step;						// ratio in RESAMPLER_FRAC_BITS fixed point
+	u64 pos;						// position of the next output within history; same fixed point
+
+	float (*dot)(const float* x, const float* c, int n);
+	void (*dot2)(const float* x, const float* c0, const float* c1, int n, float* s0, float* s1);
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
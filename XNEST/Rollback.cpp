@@ -0,0 +1,297 @@
+//=========================================================================================================|
+// Rollback.cpp
+//	Guessing the remote player's input and correcting the guesses; see Rollback.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+
+#include "Rollback.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FRAME_SECONDS		(1 / 60.0988)		// the time budget of one frame, at the NTSC rate
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; messages take delay ticks plus up to jitter more, picked at random from seed.
+ */
+LoopbackLink::LoopbackLink(u32 delay, u32 jitter, u32 seed)
+	:delay{ delay }, jitter{ jitter }, random{ seed ? seed : 1 }, now{ 0 }
+{
+	for (int i = 0; i < 2; i++)
+	{
+		ends[i].plink = this;
+		ends[i].ppeer = &ends[i ^ 1];
+	} // end for
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Puts the input in the other end's inbox, due some ticks from now.
+ */
+void LoopbackLink::Endpoint::Send(u64 frame, u8 buttons)
+{
+	u64 due = plink->now + plink->delay;
+	if (plink->jitter)
+	{
+		// xorshift32; plenty for spreading arrivals
+		u32& r = plink->random;
+		r ^= r << 13;
+		r ^= r >> 17;
+		r ^= r << 5;
+		due += r % (plink->jitter + 1);
+	} // end if
+
+	ppeer->inbox.push_back({ due, frame, buttons });
+} // end Send
+
+
+//=========================================================================================================|
+/**
+ * The first message in the inbox that's due, if any; with jitter that needn't be the oldest sent.
+ */
+bool LoopbackLink::Endpoint::Receive(u64& frame, u8& buttons)
+{
+	for (auto it = inbox.begin(); it != inbox.end(); ++it)
+	{
+		if (it->due > plink->now)
+			continue;
+
+		frame = it->frame;
+		buttons = it->buttons;
+		inbox.erase(it);
+		return true;
+	} // end for
+
+	return false;
+} // end Receive
+
+
+//=========================================================================================================|
+/**
+ * Constructor; local_port is the pad this side's player is on, the remote's is the other one. The bus
+ *	should be freshly reset, same as the remote's.
+ */
+Rollback::Rollback(Bus& bus, RollbackTransport& transport, int local_port)
+	:bus{ bus }, transport{ transport }, local_port{ local_port & 1 }, ppresenter{ nullptr },
+	states{ new MACHINE_STATE[ROLLBACK_STATES] }, frame{ 0 }, confirmed{ 0 }, rollback_from{ 0 },
+	last_remote{ 0 }, sent{ 0 }, cut{ UINT64_MAX }, cut_remote{ 0 }, stats{}
+{
+	for (INPUT_SLOT& s : inputs)
+		s = { UINT64_MAX, 0, 0, false };
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+Rollback::~Rollback()
+{
+
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Runs the next frame with the local player's buttons, after rolling back for any wrong guesses the
+ *	remote's input has shown up. ROLLBACK_STALLED means this side is as far ahead as it may go; call
+ *	again next host frame with the same frame's buttons (Frame() hasn't moved).
+ *
+ * ROLLBACK_STOPPED means a breakpoint stopped the bus, in a re-run frame or the shown one; Frame() hasn't
+ *	moved either. The next call carries on from the stop, as Bus::Run_Frame would, unless the remote's
+ *	input for the frame stopped in has since turned out different; then that frame starts over from its
+ *	snapshot like any other wrong guess. Buttons are only taken the first time a frame is asked for.
+ */
+int Rollback::Run_Frame(u8 buttons)
+{
+	typedef std::chrono::steady_clock CLOCK;
+	CLOCK::time_point t0 = CLOCK::now();
+
+	Receive();
+	if (frame >= confirmed + ROLLBACK_MAX)
+	{
+		stats.stalls++;
+		return ROLLBACK_STALLED;
+	} // end if
+
+	if (sent == frame)
+	{
+		Slot(frame).local = buttons;
+		transport.Send(frame, buttons);
+		sent++;
+	} // end if
+
+	bool bwas_cut = cut != UINT64_MAX;
+	bool bresume = cut == rollback_from && Slot(cut).remote == cut_remote;
+	cut = UINT64_MAX;
+
+	bool brollback = rollback_from < frame;
+	if (!bresume && (brollback || bwas_cut))
+	{
+		u32 depth = (u32)(frame - rollback_from);
+		bus.Load_State(states[rollback_from % ROLLBACK_STATES]);
+		if (brollback)
+		{
+			stats.rollbacks++;
+			stats.resimulated += depth;
+			if (depth > stats.max_depth)
+				stats.max_depth = depth;
+		} // end if
+	} // end if
+
+	bus.apu.Set_Output(false);
+	for (; rollback_from < frame; rollback_from++, bresume = false)
+	{
+		if (!Simulate(rollback_from, false, bresume))
+		{
+			bus.apu.Set_Output(true);
+			return ROLLBACK_STOPPED;
+		} // end if
+	} // end for
+	bus.apu.Set_Output(true);
+
+	if (brollback)
+	{
+		double secs = std::chrono::duration<double>(CLOCK::now() - t0).count();
+		if (secs > stats.max_seconds)
+			stats.max_seconds = secs;
+	} // end if
+
+	if (!Simulate(frame, true, bresume))
+		return ROLLBACK_STOPPED;
+	if (!Slot(frame).bconfirmed)
+		stats.predicted++;
+	rollback_from = ++frame;
+	stats.frames++;
+
+	double secs = std::chrono::duration<double>(CLOCK::now() - t0).count();
+	if (secs > stats.max_frame_seconds)
+		stats.max_frame_seconds = secs;
+	if (secs > FRAME_SECONDS)
+		stats.over_budget++;
+
+	return ROLLBACK_RAN;
+} // end Run_Frame
+
+
+//=========================================================================================================|
+/**
+ * The snapshot from the start of frame at; null once it's out of the ring, or before it's been run. It
+ *	is the state both sides agree on when at <= Confirmed().
+ */
+const MACHINE_STATE* Rollback::State_At(u64 at) const
+{
+	if (at >= frame || frame - at > ROLLBACK_STATES)
+		return nullptr;
+	return &states[at % ROLLBACK_STATES];
+} // end State_At
+
+
+//=========================================================================================================|
+/**
+ * The input slot for frame at, emptied first if it was holding an older frame.
+ */
+Rollback::INPUT_SLOT& Rollback::Slot(u64 at)
+{
+	INPUT_SLOT& s = inputs[at % ROLLBACK_INPUTS];
+	if (s.frame != at)
+		s = { at, 0, 0, false };
+	return s;
+} // end Slot
+
+
+//=========================================================================================================|
+/**
+ * Takes in whatever the remote has sent. A frame already run on a guess that turns out wrong is where
+ *	the next rollback has to start from, if it's the earliest such.
+ */
+void Rollback::Receive()
+{
+	u64 at;
+	u8 buttons;
+	while (transport.Receive(at, buttons))
+	{
+		if (at < confirmed || at >= confirmed + ROLLBACK_INPUTS)
+			continue;		// a repeat, or nonsense
+
+		INPUT_SLOT& s = Slot(at);
+		if (s.bconfirmed)
+			continue;
+
+		if (at < frame && s.remote != buttons && at < rollback_from)
+			rollback_from = at;
+		s.remote = buttons;
+		s.bconfirmed = true;
+	} // end while
+
+	for (;;)
+	{
+		const INPUT_SLOT& s = inputs[confirmed % ROLLBACK_INPUTS];
+		if (s.frame != confirmed || !s.bconfirmed)
+			break;
+
+		last_remote = s.remote;
+		confirmed++;
+	} // end for
+} // end Receive
+
+
+//=========================================================================================================|
+/**
+ * Snapshots the start of frame at and runs it, guessing the remote's input if it hasn't come; or, with
+ *	bresume, carries on with it from where a breakpoint stopped it. Only a shown frame goes to the
+ *	presenter, and only once it's whole. False when a breakpoint stopped it again.
+ */
+bool Rollback::Simulate(u64 at, bool bshown, bool bresume)
+{
+	INPUT_SLOT& s = Slot(at);
+	if (!bresume)
+	{
+		if (!s.bconfirmed)
+			s.remote = last_remote;
+
+		bus.Save_State(states[at % ROLLBACK_STATES]);
+		bus.controller[local_port] = s.local;
+		bus.controller[local_port ^ 1] = s.remote;
+	} // end if
+
+	if (!bus.Run_Frame())
+	{
+		cut = at;
+		cut_remote = s.remote;
+		return false;
+	} // end if
+
+	if (bshown && ppresenter)
+		ppresenter->Present(bus);
+	return true;
+} // end Simulate
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
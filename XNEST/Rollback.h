@@ -0,0 +1,197 @@
+//=========================================================================================================|
+// Rollback.h
+//	Two players on two machines, without making either wait for the other's input to cross the wire.
+//	Each side runs its own copy of the game. Every frame it runs at once with its own player's input and
+//	a guess at the remote one: the remote's last known input, held. Its own input goes out over a
+//	RollbackTransport. When the remote's real input for a frame comes in and differs from the guess, the
+//	machine rolls back. It loads the snapshot from the start of that frame and runs the frames since
+//	again with the real input, then carries on. Players only notice when a guess was wrong, and then as
+//	the remote player's sprite jumping a little.
+//
+//	A snapshot (Bus::Save_State) is taken at the start of every frame into a ring of the last
+//	ROLLBACK_MAX + 1. Re-run frames have the apu's output off and nothing presented; only the frame being
+//	shown goes to the FramePresenter. The sound from a wrong guess has already been played; it isn't
+//	taken back.
+//
+//	A side never gets more than ROLLBACK_MAX frames past the remote's last confirmed input; it stalls
+//	(Run_Frame says so) until more arrives. So a rollback re-runs at most ROLLBACK_MAX frames, and on top
+//	of the frame itself that has to fit in one frame's time. Get_Stats keeps the worst case.
+//
+//	Transports only have to deliver every message, in any order. LoopbackLink is one in-process, with
+//	delay and jitter (in frames) to test against; a socket transport is another class with Send and
+//	Receive.
+//
+//	Both sides have to start from the same machine (same rom, same reset) and run no debugging that
+//	changes it; everything else follows from the emulator being deterministic.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef ROLLBACK_H
+#define ROLLBACK_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <deque>
+#include <memory>
+
+#include "Bus.h"
+#include "RunAhead.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define ROLLBACK_MAX		8			// frames a side may run on guesses; the most a rollback re-runs
+#define ROLLBACK_STATES		(ROLLBACK_MAX + 1)
+#define ROLLBACK_INPUTS		64			// frames of input kept; well past anything in flight
+
+// what Run_Frame did
+#define ROLLBACK_RAN		0			// ran the frame
+#define ROLLBACK_STALLED	1			// too far ahead of the remote; nothing ran, try the frame again
+#define ROLLBACK_STOPPED	2			// a breakpoint stopped the bus; the next call carries on from there
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// what Get_Stats reports
+struct ROLLBACK_STATS
+{
+	u64 frames;					// frames run and shown
+	u64 stalls;					// Run_Frame calls that waited on the remote
+	u64 predicted;				// frames first run on a guess
+	u64 rollbacks;				// guesses that were wrong
+	u64 resimulated;			// frames run again for them
+	u32 max_depth;				// most frames one rollback ran again
+	double max_seconds;			// longest rollback, load and re-run, not counting the shown frame
+	double max_frame_seconds;	// longest Run_Frame, rollback and shown frame together
+	u64 over_budget;			// Run_Frame calls longer than a frame at the NTSC rate
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Carries each side's input to the other; every message has to get there, order doesn't matter.
+ */
+class RollbackTransport
+{
+public:
+
+	virtual ~RollbackTransport() {}
+
+	virtual void Send(u64 frame, u8 buttons) = 0;
+	virtual bool Receive(u64& frame, u8& buttons) = 0;		// false when nothing has arrived
+};
+
+
+/**
+ * Two transports joined back to back in one process. Messages take delay frames, give or take up to
+ *	jitter more; time moves when Tick is called, once per host frame.
+ */
+class LoopbackLink
+{
+public:
+
+	LoopbackLink(u32 delay = 0, u32 jitter = 0, u32 seed = 1);
+
+	RollbackTransport& End(int side) { return ends[side & 1]; }
+	void Tick() { now++; }
+
+private:
+
+	struct MESSAGE
+	{
+		u64 due;				// tick it can be received on
+		u64 frame;
+		u8 buttons;
+	};
+
+	class Endpoint : public RollbackTransport
+	{
+	public:
+
+		void Send(u64 frame, u8 buttons) override;
+		bool Receive(u64& frame, u8& buttons) override;
+
+		LoopbackLink* plink;
+		Endpoint* ppeer;
+		std::deque<MESSAGE> inbox;
+	};
+
+	Endpoint ends[2];
+	u32 delay, jitter;
+	u32 random;
+	u64 now;
+};
+
+
+class Rollback
+{
+public:
+
+	Rollback(Bus& bus, RollbackTransport& transport, int local_port);
+	~Rollback();
+
+	void Set_Presenter(FramePresenter* pp) { ppresenter = pp; }
+
+	int Run_Frame(u8 buttons);
+	u64 Frame() const { return frame; }			// the frame the next Run_Frame runs
+	u64 Confirmed() const { return confirmed; }	// frames before this have the remote's real input
+
+	const MACHINE_STATE* State_At(u64 at) const;
+	const ROLLBACK_STATS& Get_Stats() const { return stats; }
+
+private:
+
+	struct INPUT_SLOT
+	{
+		u64 frame;				// which frame the slot holds now; slots are reused ROLLBACK_INPUTS apart
+		u8 local;
+		u8 remote;				// the real one once bconfirmed, the guess it was last run with before
+		bool bconfirmed;
+	};
+
+	Bus& bus;
+	RollbackTransport& transport;
+	int local_port;
+	FramePresenter* ppresenter;
+
+	INPUT_SLOT inputs[ROLLBACK_INPUTS];
+	std::unique_ptr<MACHINE_STATE[]> states;	// the start of each of the last ROLLBACK_STATES frames
+
+	u64 frame;
+	u64 confirmed;
+	u64 rollback_from;			// earliest frame run on a wrong guess, or left to re-run; frame when there's none
+	u8 last_remote;				// the remote's input on frame confirmed - 1; the guess from there on
+	u64 sent;					// frames whose local input has gone out
+	u64 cut;					// frame a breakpoint stopped the bus partway through; UINT64_MAX when none
+	u8 cut_remote;				// the remote input cut was started with
+
+	ROLLBACK_STATS stats;
+
+	INPUT_SLOT& Slot(u64 at);
+	void Receive();
+	bool Simulate(u64 at, bool bshown, bool bresume);
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,122 @@
+//=========================================================================================================|
+// RunAhead.cpp
+//	Running frames ahead and rolling them back; see RunAhead.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+
+#include "RunAhead.h"
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; frames ahead is clamped to 0 (off) .. RUNAHEAD_MAX.
+ */
+RunAhead::RunAhead(Bus& bus, int frames)
+	:bus{ bus }, frames{ 0 }, ppresenter{ nullptr }, state{ new MACHINE_STATE }, host_frames{ 0 },
+	speculative_frames{ 0 }, save_seconds{ 0 }, load_seconds{ 0 }
+{
+	Set_Frames(frames);
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor
+ */
+RunAhead::~RunAhead()
+{
+
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * How far ahead to show; 0 turns it off. False (and nothing changed) out of 0..RUNAHEAD_MAX.
+ */
+bool RunAhead::Set_Frames(int n)
+{
+	if (n < 0 || n > RUNAHEAD_MAX)
+		return false;
+
+	frames = n;
+	return true;
+} // end Set_Frames
+
+
+//=========================================================================================================|
+/**
+ * One host frame with input in. Returns false when a breakpoint stopped the real frame; nothing is run
+ *	ahead then, so the debugger sees the machine where it stopped.
+ *
+ * Nothing is run ahead either while breakpoints are armed or anything watches the cpu (tracer, profiler,
+ *	coverage): their hit counts, temporary breakpoints and samples would go on frames that are then
+ *	thrown away, and a stop would leave a speculative frame half run. The real frame is shown instead.
+ */
+bool RunAhead::Run_Frame(const INPUT_FRAME& in)
+{
+	typedef std::chrono::steady_clock CLOCK;
+
+	bus.controller[0] = in.pads[0];
+	bus.controller[1] = in.pads[1];
+	if (!bus.Run_Frame())
+		return false;
+	host_frames++;
+
+	if (!frames || bus.breakpoints.Armed() || bus.cpu6502.Observed())
+	{
+		if (ppresenter)
+			ppresenter->Present(bus);
+		return true;
+	} // end if
+
+	CLOCK::time_point t0 = CLOCK::now();
+	bus.Save_State(*state);
+	CLOCK::time_point t1 = CLOCK::now();
+
+	// only a breakpoint stops a frame, and none are armed; but should one be, what's shown is the real
+	// frame, never half of a speculative one
+	bool bahead = true;
+	bus.apu.Set_Output(false);
+	for (int i = 0; i < frames && bahead; i++)
+		bahead = bus.Run_Frame();
+	speculative_frames += frames;
+	bus.apu.Set_Output(true);
+
+	if (bahead && ppresenter)
+		ppresenter->Present(bus);
+
+	CLOCK::time_point t2 = CLOCK::now();
+	bus.Load_State(*state);
+	CLOCK::time_point t3 = CLOCK::now();
+
+	if (!bahead && ppresenter)
+		ppresenter->Present(bus);
+
+	save_seconds += std::chrono::duration<double>(t1 - t0).count();
+	load_seconds += std::chrono::duration<double>(t3 - t2).count();
+	return true;
+} // end Run_Frame
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
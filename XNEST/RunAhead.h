@@ -0,0 +1,108 @@
+//=========================================================================================================|
+// RunAhead.h
+//	Hides the input lag games build in themselves. Plenty of games only act on a button a frame or two after
+//	reading it. Run-ahead shows the player the screen from N frames in the future instead, as if the
+//	button had been pressed that much earlier. Each host frame:
+//
+//		1. the real frame runs with this frame's input, sound and all
+//		2. the machine is saved
+//		3. N more frames run with the same input, silently; the last one is what gets presented
+//		4. the machine is put back as it was after 1
+//
+//	So the game's own timeline is untouched and only what's shown is from ahead. If the input then changes,
+//	the guess in 3 was wrong for the frames after the change, but those are thrown away anyway.
+//
+//	It costs N+1 frames of emulation plus a save and a load per host frame. A save is a struct copy of the
+//	cpu and apu and a memcpy of the writable memory (Bus::Save_State); a couple of microseconds. Speculative
+//	frames don't touch the audio (APU2A03::Set_Output). There's no video yet; a FramePresenter is handed the
+//	bus at the moment the frame to present is there to be taken.
+//
+//	Speculative frames are thrown away, so nothing that keeps count of what the cpu does may see them: with
+//	breakpoints armed, or a tracer, profiler or coverage map on the cpu, nothing is run ahead and the real
+//	frame is shown. The latency tracer (LatencyTracer.h) is the exception. It counts shown frames, and a
+//	pad read in a speculative frame is exactly what makes the shown frame answer sooner.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef RUNAHEAD_H
+#define RUNAHEAD_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <memory>
+
+#include "Bus.h"
+#include "InputSource.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define RUNAHEAD_MAX		4			// frames ahead it'll go
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Gets the frame to be shown, once per host frame; with run-ahead off that's the real frame.
+ */
+class FramePresenter
+{
+public:
+
+	virtual ~FramePresenter() {}
+	virtual void Present(const Bus& bus) = 0;
+};
+
+
+class RunAhead
+{
+public:
+
+	RunAhead(Bus& bus, int frames = 1);
+	~RunAhead();
+
+	bool Set_Frames(int frames);
+	int Frames() const { return frames; }
+	void Set_Presenter(FramePresenter* pp) { ppresenter = pp; }
+
+	bool Run_Frame(const INPUT_FRAME& in);
+
+	// what it has cost so far
+	u64 Host_Frames() const { return host_frames; }
+	u64 Speculative_Frames() const { return speculative_frames; }
+	double Save_Seconds() const { return save_seconds; }
+	double Load_Seconds() const { return load_seconds; }
+
+private:
+
+	Bus& bus;
+	int frames;
+	FramePresenter* ppresenter;
+	std::unique_ptr<MACHINE_STATE> state;		// 64K or so; off the stack and allocated once
+
+	u64 host_frames;
+	u64 speculative_frames;
+	double save_seconds;
+	double load_seconds;
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
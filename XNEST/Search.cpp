@@ -0,0 +1,383 @@
+//=========================================================================================================|
+// Search.cpp
+//	The input search; see Search.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unordered_set>
+
+#include "Search.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define FNV_OFFSET			0xCBF29CE484222325ull
+#define FNV_PRIME			0x100000001B3ull
+
+#define NO_STATE			0xFFFFFFFFu
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Seconds between two points on the steady clock.
+ */
+static double Between(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+{
+	return std::chrono::duration<double>(to - from).count();
+} // end Between
+
+
+//=========================================================================================================|
+/**
+ * What makes two machines the same for bdedupe: the writable memory and the cpu's registers. Taken a
+ *	word at a time; it runs once per child over up to 64K.
+ */
+static u64 State_Hash(const Bus& bus)
+{
+	CPU_STATE cpu;
+	bus.cpu6502.Save_State(cpu);
+
+	u64 h = FNV_OFFSET;
+	u8 regs[8] = { cpu.a, cpu.x, cpu.y, cpu.sp, cpu.status, (u8)cpu.pc, (u8)(cpu.pc >> 8), 0 };
+	u64 w;
+	memcpy(&w, regs, sizeof(w));
+	h = (h ^ w) * FNV_PRIME;
+
+	u32 i = 0;
+	for (; i + sizeof(w) <= bus.rom_start; i += sizeof(w))
+	{
+		memcpy(&w, bus.ram + i, sizeof(w));
+		h = (h ^ w) * FNV_PRIME;
+		h ^= h >> 32;
+	} // end for
+	for (; i < bus.rom_start; i++)
+		h = (h ^ bus.ram[i]) * FNV_PRIME;
+	return h;
+} // end State_Hash
+
+
+//=========================================================================================================|
+/**
+ * The stats of one worker onto the total.
+ */
+static void Add_Stats(SEARCH_STATS& total, const SEARCH_STATS& s)
+{
+	total.nodes += s.nodes;
+	total.frames += s.frames;
+	total.clones += s.clones;
+	total.saves += s.saves;
+	total.clone_seconds += s.clone_seconds;
+	total.frame_seconds += s.frame_seconds;
+	total.score_seconds += s.score_seconds;
+	total.save_seconds += s.save_seconds;
+} // end Add_Stats
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; makes the workers, each with a machine that has the cartridge in and its sound off, which
+ *	then wait for a level.
+ */
+Search::Search(const Cartridge& cart, u32 count)
+	:batch{ 0 }, running{ 0 }, bquit{ false }, pparents{ nullptr }, pchildren{ nullptr }, pactions{ nullptr },
+	pconfig{ nullptr }, pscorer{ nullptr }, bsave{ false }, next{ 0 }, stats{}
+{
+	if (!count)
+		count = std::thread::hardware_concurrency();
+	if (!count)
+		count = 1;
+
+	for (u32 i = 0; i < count; i++)
+	{
+		workers.emplace_back(new WORKER);
+		WORKER& w = *workers.back();
+		w.bus.reset(new Bus);
+		memset(w.bus->ram, 0, RAM_SIZE);
+		cart.Insert(*w.bus);
+		w.bus->Reset();
+		w.bus->apu.Set_Output(false);
+		w.stats = {};
+	} // end for
+
+	for (u32 i = 0; i < count; i++)
+		workers[i]->thread = std::thread(&Search::Worker, this, i);
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor; tells the workers to quit and waits for them.
+ */
+Search::~Search()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		bquit = true;
+	}
+	wake.notify_all();
+
+	for (auto& w : workers)
+		w->thread.join();
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Searches from root, which has to come from a machine with the same cartridge in. False, with Error()
+ *	saying why, on a config it can't run.
+ */
+bool Search::Run(const MACHINE_STATE& root, const std::vector<u8>& actions, const SEARCH_CONFIG& config,
+	SearchScore& scorer, SEARCH_RESULT& result)
+{
+	if (actions.empty() || actions.size() > 256)
+	{
+		error = "between 1 and 256 actions";
+		return false;
+	} // end if
+	if (!config.depth || !config.frames_per_step)
+	{
+		error = "depth and frames per step have to be at least 1";
+		return false;
+	} // end if
+
+	auto start = std::chrono::steady_clock::now();
+	stats = {};
+	for (auto& w : workers)
+		w->stats = {};
+	error.clear();
+
+	pactions = &actions;
+	pconfig = &config;
+	pscorer = &scorer;
+
+	// level 0 is the root alone; each level's nodes point into the one above
+	std::vector<std::vector<NODE>> levels(config.depth + 1);
+	NODE top = { NO_STATE, 0, Get_State(), 0, 0 };
+	*pool[top.state] = root;
+	levels[0].push_back(top);
+
+	for (u32 d = 0; d < config.depth; d++)
+	{
+		std::vector<NODE>& parents = levels[d];
+		std::vector<NODE> children;
+		bool blast = d + 1 == config.depth;
+
+		children.reserve(parents.size() * actions.size());
+		for (u32 p = 0; p < (u32)parents.size(); p++)
+			for (u32 a = 0; a < (u32)actions.size(); a++)
+				children.push_back({ p, (u8)a, blast ? NO_STATE : Get_State(), 0, 0 });
+
+		Run_Level(parents, children, !blast);
+
+		for (NODE& n : parents)
+		{
+			Put_State(n.state);
+			n.state = NO_STATE;
+		} // end for
+
+		// order: duplicates out, then best first, ties to the first made
+		std::vector<u32> order;
+		order.reserve(children.size());
+		if (config.bdedupe)
+		{
+			std::unordered_set<u64> seen;
+			for (u32 i = 0; i < (u32)children.size(); i++)
+			{
+				if (seen.insert(children[i].hash).second)
+					order.push_back(i);
+				else
+				{
+					Put_State(children[i].state);
+					stats.duplicates++;
+				} // end else
+			} // end for
+		} // end if
+		else
+		{
+			for (u32 i = 0; i < (u32)children.size(); i++)
+				order.push_back(i);
+		} // end else
+
+		std::stable_sort(order.begin(), order.end(),
+			[&](u32 l, u32 r) { return children[l].score > children[r].score; });
+
+		if (config.beam && order.size() > config.beam)
+		{
+			for (size_t i = config.beam; i < order.size(); i++)
+				Put_State(children[order[i]].state);
+			order.resize(config.beam);
+		} // end if
+
+		levels[d + 1].reserve(order.size());
+		for (u32 i : order)
+			levels[d + 1].push_back(children[i]);
+	} // end for
+
+	// the best is first on the bottom level; walk up for its inputs
+	const NODE* pn = &levels[config.depth][0];
+	result.score = pn->score;
+	result.inputs.assign(config.depth, 0);
+	for (u32 d = config.depth; d > 0; d--)
+	{
+		result.inputs[d - 1] = actions[pn->action];
+		pn = &levels[d - 1][pn->parent];
+	} // end for
+
+	for (auto& w : workers)
+		Add_Stats(stats, w->stats);
+	stats.pool_states = pool.size();
+	stats.seconds = Between(start, std::chrono::steady_clock::now());
+	return true;
+} // end Run
+
+
+//=========================================================================================================|
+/**
+ * Runs every child of a level on the workers and returns when they're all scored (and saved, if bsave).
+ */
+void Search::Run_Level(std::vector<NODE>& parents, std::vector<NODE>& children, bool bsave)
+{
+	std::unique_lock<std::mutex> guard(lock);
+	pparents = &parents;
+	pchildren = &children;
+	this->bsave = bsave;
+	next = 0;
+	running = Workers();
+	batch++;
+	wake.notify_all();
+
+	idle.wait(guard, [this] { return running == 0; });
+} // end Run_Level
+
+
+//=========================================================================================================|
+/**
+ * A worker's life: wait for a level, take children off the counter until there are none, report in,
+ *	repeat.
+ */
+void Search::Worker(u32 id)
+{
+	u64 seen = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [&] { return bquit || batch != seen; });
+			if (bquit)
+				return;
+			seen = batch;
+		}
+
+		std::vector<NODE>& children = *pchildren;
+		u32 i;
+		while ((i = next++) < (u32)children.size())
+			Run_Child(*workers[id], children[i]);
+
+		std::lock_guard<std::mutex> guard(lock);
+		if (--running == 0)
+			idle.notify_one();
+	} // end for
+} // end Worker
+
+
+//=========================================================================================================|
+/**
+ * One child on worker w's machine: clone the parent, hold the action for the step, score, and save if
+ *	the level is to be cloned from.
+ */
+void Search::Run_Child(WORKER& w, NODE& child)
+{
+	Bus& bus = *w.bus;
+	const NODE& parent = (*pparents)[child.parent];
+	u8 buttons = (*pactions)[child.action];
+
+	auto t0 = std::chrono::steady_clock::now();
+	bus.Load_State(*pool[parent.state]);
+	auto t1 = std::chrono::steady_clock::now();
+
+	for (u32 f = 0; f < pconfig->frames_per_step; f++)
+	{
+		bus.controller[0] = buttons;
+		bus.controller[1] = 0;
+		bus.Run_Frame();
+	} // end for
+	auto t2 = std::chrono::steady_clock::now();
+
+	child.score = pscorer->Score(bus);
+	if (pconfig->bdedupe)
+		child.hash = State_Hash(bus);
+	auto t3 = std::chrono::steady_clock::now();
+
+	w.stats.nodes++;
+	w.stats.clones++;
+	w.stats.frames += pconfig->frames_per_step;
+	w.stats.clone_seconds += Between(t0, t1);
+	w.stats.frame_seconds += Between(t1, t2);
+	w.stats.score_seconds += Between(t2, t3);
+
+	if (bsave)
+	{
+		bus.Save_State(*pool[child.state]);
+		w.stats.saves++;
+		w.stats.save_seconds += Between(t3, std::chrono::steady_clock::now());
+	} // end if
+} // end Run_Child
+
+
+//=========================================================================================================|
+/**
+ * A snapshot buffer off the pool; a new one only when the pool has none free. Main thread only.
+ */
+u32 Search::Get_State()
+{
+	if (free_states.empty())
+	{
+		pool.emplace_back(new MACHINE_STATE);
+		return (u32)pool.size() - 1;
+	} // end if
+
+	u32 state = free_states.back();
+	free_states.pop_back();
+	return state;
+} // end Get_State
+
+
+//=========================================================================================================|
+/**
+ * A snapshot buffer back to the pool. NO_STATE is fine.
+ */
+void Search::Put_State(u32 state)
+{
+	if (state != NO_STATE)
+		free_states.push_back(state);
+} // end Put_State
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
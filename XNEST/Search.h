@@ -0,0 +1,189 @@
+//=========================================================================================================|
+// Search.h
+//	Searches for the controller input that does best by some measure of the machine's memory, say "the
+//	highest x position at $0086", starting from a saved machine.
+//
+//	A sequence is depth steps. Each step holds one of a list of button sets (the actions) on pad 1 for
+//	frames_per_step frames. The search goes level by level. Every node kept at one level gets a child per
+//	action, and each child is run and scored on a SearchScore. With a beam width, the best beam children
+//	go on to the next level. With none, every child does, so the search is breadth first, with
+//	actions^depth nodes at the bottom. Ties in score go to the child made first, and children are made in
+//	a fixed order (parent, then action), so the answer is the same however many workers there are.
+//
+//	A child starts as a clone of its parent: Bus::Load_State from the parent's snapshot. Only the
+//	writable memory is copied, not the rom. Snapshots (MACHINE_STATE, 64K and change) come from a pool
+//	owned by the search. A buffer goes back to the pool as soon as nothing needs it. The pool only grows
+//	when a level needs more than it has ever held, so a long run allocates nothing after its widest level.
+//	Children on the last level are never saved, since nothing clones them.
+//
+//	The children of a level are spread over a pool of worker threads. Each worker has its own machine,
+//	with the cartridge in and the sound off. There is no picture unit, so a frame here is cpu and apu
+//	only. Workers take children off a shared counter; a child is a clone and some frames, all of much the
+//	same cost.
+//
+//	With bdedupe, a child that ends up identical to an earlier child of the same level (same writable
+//	memory and cpu registers) is dropped. Many actions do nothing on many frames, and without this the
+//	beam fills up with copies.
+//
+//	The throughput is clones plus frames, so SEARCH_STATS keeps the time spent in each: clone (load),
+//	frames, score and save, summed over the workers.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef SEARCH_H
+#define SEARCH_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bus.h"
+#include "Cartridge.h"
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+// how to search
+struct SEARCH_CONFIG
+{
+	u32 depth;					// steps in a sequence
+	u32 frames_per_step;		// frames each step's buttons are held for
+	u32 beam;					// children kept per level; 0 keeps them all (breadth first)
+	bool bdedupe;				// drop children identical to an earlier one on the same level
+};
+
+
+// what the search found
+struct SEARCH_RESULT
+{
+	s64 score;
+	std::vector<u8> inputs;		// the best sequence: pad 1's buttons per step
+};
+
+
+// what it cost; times are summed over the workers
+struct SEARCH_STATS
+{
+	u64 nodes;					// children run and scored
+	u64 duplicates;				// dropped by bdedupe
+	u64 frames;
+	u64 clones;					// Load_State from a snapshot
+	u64 saves;					// Save_State to one
+	u64 pool_states;			// snapshot buffers the pool holds
+	double clone_seconds;
+	double frame_seconds;
+	double score_seconds;
+	double save_seconds;
+	double seconds;				// start to finish, by the clock on the wall
+};
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Scores a machine after a child's frames; higher is better. Called from every worker at once, so it
+ *	mustn't change anything it shares.
+ */
+class SearchScore
+{
+public:
+
+	virtual ~SearchScore() {}
+	virtual s64 Score(const Bus& bus) = 0;
+};
+
+
+/**
+ * The search and its workers. One Run at a time.
+ */
+class Search
+{
+public:
+
+	Search(const Cartridge& cart, u32 workers = 0);		// 0 for one per hardware thread
+	~Search();
+
+	u32 Workers() const { return (u32)workers.size(); }
+	bool Run(const MACHINE_STATE& root, const std::vector<u8>& actions, const SEARCH_CONFIG& config,
+		SearchScore& scorer, SEARCH_RESULT& result);
+
+	const SEARCH_STATS& Stats() const { return stats; }		// of the last Run
+	const std::string& Error() const { return error; }
+
+private:
+
+	// a child: which parent, which action, and where its snapshot is
+	struct NODE
+	{
+		u32 parent;					// index into the level above
+		u8 action;					// index into actions
+		u32 state;					// pool index; NO_STATE when it has none
+		s64 score;
+		u64 hash;					// for bdedupe
+	};
+
+	struct WORKER
+	{
+		std::thread thread;
+		std::unique_ptr<Bus> bus;
+		SEARCH_STATS stats;
+	};
+
+	std::vector<std::unique_ptr<WORKER>> workers;
+
+	std::mutex lock;				// guards the batch hand off
+	std::condition_variable wake;	// a level is up, or it's time to quit
+	std::condition_variable idle;	// the last worker has finished the level
+	u64 batch;
+	u32 running;
+	bool bquit;
+
+	// the level being run; set before the workers are woken, read only while they run
+	std::vector<NODE>* pparents;
+	std::vector<NODE>* pchildren;
+	const std::vector<u8>* pactions;
+	const SEARCH_CONFIG* pconfig;
+	SearchScore* pscorer;
+	bool bsave;
+	std::atomic<u32> next;			// next child to run
+
+	std::vector<std::unique_ptr<MACHINE_STATE>> pool;
+	std::vector<u32> free_states;
+
+	SEARCH_STATS stats;
+	std::string error;
+
+	void Worker(u32 id);
+	void Run_Child(WORKER& w, NODE& child);
+	void Run_Level(std::vector<NODE>& parents, std::vector<NODE>& children, bool bsave);
+
+	u32 Get_State();
+	void Put_State(u32 state);
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
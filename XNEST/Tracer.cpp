@@ -0,0 +1,237 @@
+//=========================================================================================================|
+// Tracer.cpp
+//	The trace ring and its writer thread; see Tracer.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <chrono>
+#include <cstring>
+
+#include "Tracer.h"
+#include "Bus.h"
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+/**
+ * Constructor; ring_records is rounded up to a power of 2.
+ */
+Tracer::Tracer(u32 ring_records)
+	:fp{ nullptr }, bstop{ false }, berror{ false }, pbus{ nullptr }, cycle_base{ 0 }, read_seen{ 0 },
+	records{ 0 }, stalls{ 0 }, write_pos{ 0 }, read_pos{ 0 }
+{
+	u32 n = 1024;
+	while (n < ring_records)
+		n <<= 1;
+
+	ring.resize(n);
+	mask = n - 1;
+	memset(&pending, 0, sizeof(pending));
+} // end Constructor
+
+
+//=========================================================================================================|
+/**
+ * Destructor; flushes and closes if that hasn't been done.
+ */
+Tracer::~Tracer()
+{
+	Close();
+} // end Destructor
+
+
+//=========================================================================================================|
+/**
+ * Creates the trace file, writes the header and starts the writer.
+ */
+bool Tracer::Open(const char* path)
+{
+	Close();
+
+	fp = fopen(path, "wb");
+	if (!fp)
+		return false;
+
+	TRACE_HEADER h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, TRACE_MAGIC, sizeof(h.magic));
+	h.record_size = sizeof(TRACE_RECORD);
+	berror = fwrite(&h, sizeof(h), 1, fp) != 1;
+
+	records = stalls = 0;
+	write_pos = read_pos = read_seen = 0;
+	bstop = false;
+	writer = std::thread(&Tracer::Writer_Thread, this);
+	return !berror;
+} // end Open
+
+
+//=========================================================================================================|
+/**
+ * Stops tracing, lets the writer empty the ring and closes the file. False if any write failed.
+ */
+bool Tracer::Close()
+{
+	Detach();
+
+	if (writer.joinable())
+	{
+		bstop = true;
+		writer.join();
+	} // end if
+
+	if (fp)
+	{
+		berror = fclose(fp) != 0 || berror;
+		fp = nullptr;
+	} // end if
+
+	return !berror;
+} // end Close
+
+
+//=========================================================================================================|
+/**
+ * Starts recording whatever bus.cpu6502 runs.
+ */
+void Tracer::Attach(Bus& bus)
+{
+	Detach();
+
+	pbus = &bus;
+	CPU6502& cpu = bus.cpu6502;
+	cpu.Attach(this, OBSERVE_INSTRUCTIONS | OBSERVE_FLOW);
+
+	// the next instruction starts once the one in flight (if any) is done
+	CPU_STATE s;
+	cpu.Save_State(s);
+	cycle_base = bus.system_clock + s.cycles - cpu.Observed_Cycles();
+	Latch(cpu);
+} // end Attach
+
+
+//=========================================================================================================|
+/**
+ * Stops recording; what's in the ring still goes to disk.
+ */
+void Tracer::Detach()
+{
+	if (pbus)
+		pbus->cpu6502.Detach(this);
+	pbus = nullptr;
+} // end Detach
+
+
+//=========================================================================================================|
+/**
+ * Remembers the registers the next instruction will start with.
+ */
+void Tracer::Latch(const CPU6502& cpu)
+{
+	pending.a = cpu.A();
+	pending.x = cpu.X();
+	pending.y = cpu.Y();
+	pending.sp = cpu.Sp();
+	pending.p = cpu.Status();
+} // end Latch
+
+
+//=========================================================================================================|
+/**
+ * One record per instruction. Only ever waits when the writer is a whole ring behind.
+ */
+void Tracer::Instruction(const CPU6502& cpu, u16 pc, u8 opcode, u8 cycles)
+{
+	u32 w = write_pos.load(std::memory_order_relaxed);
+	if (w - read_seen > mask)
+	{
+		read_seen = read_pos.load(std::memory_order_acquire);
+		while (w - read_seen > mask)
+		{
+			stalls++;
+			std::this_thread::yield();
+			read_seen = read_pos.load(std::memory_order_acquire);
+		} // end while
+	} // end if
+
+	u64 cycle = cycle_base + cpu.Observed_Cycles() - cycles;
+
+	TRACE_RECORD& r = ring[w & mask];
+	r = pending;
+	r.cycle_lo = (u32)cycle;
+	r.cycle_hi = (u16)(cycle >> 32);
+	r.pc = pc;
+	r.opcode = opcode;
+	r.operand[0] = pbus->Peek((u16)(pc + 1));		// no side effects; a compare and an index
+	r.operand[1] = pbus->Peek((u16)(pc + 2));
+	write_pos.store(w + 1, std::memory_order_release);
+
+	records++;
+	Latch(cpu);
+} // end Instruction
+
+
+//=========================================================================================================|
+/**
+ * Interrupts change the registers between two instructions; the next record has to start from there.
+ */
+void Tracer::Flow(const CPU6502& cpu, CPU_FLOW kind, u16 pc)
+{
+	if (kind == FLOW_NMI || kind == FLOW_IRQ)
+		Latch(cpu);
+} // end Flow
+
+
+//=========================================================================================================|
+/**
+ * Drains the ring to disk in chunks of up to TRACE_WRITE_RECORDS, sleeping while there's little to do.
+ */
+void Tracer::Writer_Thread()
+{
+	for (;;)
+	{
+		u32 r = read_pos.load(std::memory_order_relaxed);
+		u32 w = write_pos.load(std::memory_order_acquire);
+		u32 avail = w - r;
+
+		if (avail == 0)
+		{
+			if (bstop)
+				break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		} // end if
+
+		// no further than the end of the ring in one go
+		u32 start = r & mask;
+		u32 n = avail;
+		if (n > mask + 1 - start) n = mask + 1 - start;
+		if (n > TRACE_WRITE_RECORDS) n = TRACE_WRITE_RECORDS;
+
+		if (!berror && fwrite(&ring[start], sizeof(TRACE_RECORD), n, fp) != n)
+			berror = true;		// keep draining so the emulation doesn't hang on us
+
+		read_pos.store(r + n, std::memory_order_release);
+	} // end for
+} // end Writer_Thread
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
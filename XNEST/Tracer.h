@@ -0,0 +1,131 @@
+//=========================================================================================================|
+// Tracer.h
+//	Instruction tracing for runs long enough that a text log would be the bottleneck.
+//
+//	Every instruction becomes one packed 16 byte TRACE_RECORD (pc, opcode, operand bytes, A/X/Y/SP/P as
+//	they were before it ran, and the cycle it started on) dropped into an in-memory ring. Nothing gets
+//	formatted on the emulation thread; a writer thread drains the ring to disk in big sequential writes.
+//	When the disk can't keep up the emulation waits rather than losing records, and the waits are counted.
+//
+//	Tools/TraceConv turns the file into nestest style text afterwards.
+//
+//	File layout: a TRACE_HEADER, then records till the end of the file.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef TRACER_H
+#define TRACER_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "CPU6502.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define TRACE_MAGIC				"XNTRACE1"
+#define TRACE_DEFAULT_RECORDS	(1 << 18)		// 4 MB of ring
+#define TRACE_WRITE_RECORDS		(1 << 15)		// most the writer takes per fwrite; 512 KB
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+/**
+ * One executed instruction. The registers are the ones it started with, as in a nestest log. The cycle is
+ *	48 bits split in two so the whole thing packs into 16 bytes with no padding.
+ */
+struct TRACE_RECORD
+{
+	u32 cycle_lo;
+	u16 cycle_hi;
+	u16 pc;
+	u8 opcode;
+	u8 operand[2];		// the two bytes after the opcode, whether the instruction uses them or not
+	u8 a, x, y, sp, p;
+};
+
+static_assert(sizeof(TRACE_RECORD) == 16, "TRACE_RECORD is a file format; keep it packed");
+
+
+struct TRACE_HEADER
+{
+	char magic[8];			// TRACE_MAGIC
+	u32 record_size;		// sizeof(TRACE_RECORD)
+	u32 reserved;
+};
+
+
+class Bus;
+
+
+
+//=========================================================================================================|
+// CLASS DEFINTION
+//=========================================================================================================|
+class Tracer : public CpuObserver
+{
+public:
+
+	Tracer(u32 ring_records = TRACE_DEFAULT_RECORDS);
+	~Tracer();
+
+	bool Open(const char* path);
+	bool Close();
+
+	void Attach(Bus& bus);
+	void Detach();
+
+	void Instruction(const CPU6502& cpu, u16 pc, u8 opcode, u8 cycles) override;
+	void Flow(const CPU6502& cpu, CPU_FLOW kind, u16 pc) override;
+
+	u64 Records() const { return records; }
+	u64 Stalls() const { return stalls; }
+
+private:
+
+	std::vector<TRACE_RECORD> ring;
+	u32 mask;
+	FILE* fp;
+	std::thread writer;
+	std::atomic<bool> bstop;
+	bool berror;
+
+	Bus* pbus;
+	u64 cycle_base;					// bus clock when attached, less the cpu's observed cycles then
+	TRACE_RECORD pending;			// registers the next instruction starts with
+	u32 read_seen;					// read_pos as of the last time the ring looked full
+	u64 records;
+	u64 stalls;						// times the ring was full and we had to wait on the writer
+
+	alignas(64) std::atomic<u32> write_pos;
+	alignas(64) std::atomic<u32> read_pos;
+
+	void Latch(const CPU6502& cpu);
+	void Writer_Thread();
+};
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
@@ -0,0 +1,378 @@
+//=========================================================================================================|
+// XnestApi.cpp
+//	The C interface over Bus and Cartridge; see XnestApi.h.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "Bus.h"
+#include "Cartridge.h"
+#include "XnestApi.h"
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define STATE_MAGIC			0x54534E58u		// "XNST"
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+struct XNEST_ENV
+{
+	Cartridge cart;
+	std::unique_ptr<Bus> bus;		// big; on the heap with the rest
+};
+
+
+// what goes in front of a MACHINE_STATE in a saved state, so a stray buffer is caught on load
+struct STATE_HEADER
+{
+	u32 magic;
+	u32 version;					// XNEST_API_VERSION
+	u32 bytes;						// sizeof(MACHINE_STATE) of the build that saved it
+	u32 reserved;
+};
+
+
+
+//=========================================================================================================|
+// GLOBALS
+//=========================================================================================================|
+static thread_local std::string error;		// why the last call on this thread failed
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+/**
+ * Notes why a call failed and returns XNEST_ERROR, for the callers to pass on.
+ */
+static int Fail(const std::string& why)
+{
+	error = why;
+	return XNEST_ERROR;
+} // end Fail
+
+
+//=========================================================================================================|
+/**
+ * True when a MACHINE_STATE can sit at p as it is; any malloc'd buffer will do, the header keeps the
+ *	alignment. Otherwise Save and Load go through a copy.
+ */
+static bool Aligned(const void* p)
+{
+	return (uintptr_t)p % alignof(MACHINE_STATE) == 0;
+} // end Aligned
+
+
+//=========================================================================================================|
+/**
+ * One environment for frames frames, taking XNEST_PADS bytes of input per frame when there is any.
+ */
+static void Run(XNEST_ENV* env, u32 frames, const u8* input)
+{
+	Bus& bus = *env->bus;
+	for (u32 f = 0; f < frames; f++)
+	{
+		bus.controller[0] = input ? input[f * XNEST_PADS] : 0;
+		bus.controller[1] = input ? input[f * XNEST_PADS + 1] : 0;
+		bus.Run_Frame();
+	} // end for
+} // end Run
+
+
+//=========================================================================================================|
+/**
+ * The version of this interface, for a harness to check against the XNEST_API_VERSION it was built for.
+ */
+int Xnest_Version(void)
+{
+	return XNEST_API_VERSION;
+} // end Xnest_Version
+
+
+//=========================================================================================================|
+/**
+ * Why the last call on this thread that failed did; "" if none has.
+ */
+const char* Xnest_Error(void)
+{
+	return error.c_str();
+} // end Xnest_Error
+
+
+//=========================================================================================================|
+/**
+ * Loads the rom into a new machine and resets it. Null when the rom won't load.
+ */
+XNEST_ENV* Xnest_Create(const char* rom_path)
+{
+	if (!rom_path)
+	{
+		Fail("no rom given");
+		return nullptr;
+	} // end if
+
+	std::unique_ptr<XNEST_ENV> env(new (std::nothrow) XNEST_ENV);
+	if (env)
+		env->bus.reset(new (std::nothrow) Bus);
+	if (!env || !env->bus)
+	{
+		Fail("out of memory");
+		return nullptr;
+	} // end if
+
+	bool bloaded;
+	try
+	{
+		bloaded = env->cart.Load(rom_path);
+	} // end try
+	catch (const std::exception& e)
+	{
+		Fail(e.what());		// a rom too big to hold; nothing may leave through a C interface
+		return nullptr;
+	} // end catch
+
+	if (!bloaded)
+	{
+		Fail(env->cart.Error());
+		return nullptr;
+	} // end if
+
+	env->bus->apu.Set_Output(false);
+	Xnest_Reset(env.get());
+	return env.release();
+} // end Xnest_Create
+
+
+//=========================================================================================================|
+/**
+ * Frees the machine; its views go with it. Null is fine.
+ */
+void Xnest_Destroy(XNEST_ENV* env)
+{
+	delete env;
+} // end Xnest_Destroy
+
+
+//=========================================================================================================|
+/**
+ * Back to the state Xnest_Create left it in: memory wiped, pads released, cartridge in, reset. The
+ *	audio setting stays as it was.
+ */
+void Xnest_Reset(XNEST_ENV* env)
+{
+	if (!env)
+		return;
+
+	Bus& bus = *env->bus;
+	memset(bus.ram, 0, RAM_SIZE);
+	memset(bus.controller, 0, sizeof(bus.controller));
+	env->cart.Insert(bus);
+	bus.Reset();
+} // end Xnest_Reset
+
+
+//=========================================================================================================|
+/**
+ * Runs frames frames. input has XNEST_PADS bytes per frame (pad 1, pad 2, frame after frame) or is null
+ *	for no buttons held. Returns the frames run.
+ */
+int Xnest_Step(XNEST_ENV* env, uint32_t frames, const uint8_t* input, uint32_t flags)
+{
+	if (!env)
+		return Fail("no environment");
+
+	(void)flags;		// XNEST_STEP_RENDER: nothing to draw with yet
+	Run(env, frames, input);
+	return (int)frames;
+} // end Xnest_Step
+
+
+//=========================================================================================================|
+/**
+ * Xnest_Step on count environments, one after the other. input holds frames * XNEST_PADS bytes for each
+ *	environment in turn, or is null. Returns the frames each ran; XNEST_ERROR, with nothing run, when any
+ *	of them is null.
+ */
+int Xnest_Step_Batch(XNEST_ENV* const* envs, uint32_t count, uint32_t frames, const uint8_t* input,
+	uint32_t flags)
+{
+	if (!envs && count)
+		return Fail("no environments");
+	for (u32 i = 0; i < count; i++)
+		if (!envs[i])
+			return Fail("environment " + std::to_string(i) + " is null");
+
+	(void)flags;
+	for (u32 i = 0; i < count; i++)
+		Run(envs[i], frames, input ? input + (size_t)i * frames * XNEST_PADS : nullptr);
+	return (int)frames;
+} // end Xnest_Step_Batch
+
+
+//=========================================================================================================|
+/**
+ * The picture, once there's a picture unit to draw it. Null, with everything zero, till then.
+ */
+const uint8_t* Xnest_Get_Frame(const XNEST_ENV* env, uint32_t* width, uint32_t* height, uint32_t* pitch)
+{
+	(void)env;
+	if (width)
+		*width = 0;
+	if (height)
+		*height = 0;
+	if (pitch)
+		*pitch = 0;
+	return nullptr;
+} // end Xnest_Get_Frame
+
+
+//=========================================================================================================|
+/**
+ * The machine's 64K address space as the cpu sees it, in place; the work ram is the first 2K. Read
+ *	only: write through it and the machine won't notice any sooner than the cpu next reads.
+ */
+const uint8_t* Xnest_Get_Ram(const XNEST_ENV* env, uint32_t* size)
+{
+	if (size)
+		*size = env ? RAM_SIZE : 0;
+	return env ? env->bus->ram : nullptr;
+} // end Xnest_Get_Ram
+
+
+//=========================================================================================================|
+/**
+ * Frames run since the last reset.
+ */
+uint64_t Xnest_Frame_Count(const XNEST_ENV* env)
+{
+	return env ? env->bus->frame_count : 0;
+} // end Xnest_Frame_Count
+
+
+//=========================================================================================================|
+/**
+ * The bytes Xnest_Save needs.
+ */
+uint32_t Xnest_State_Size(void)
+{
+	return (u32)(sizeof(STATE_HEADER) + sizeof(MACHINE_STATE));
+} // end Xnest_State_Size
+
+
+//=========================================================================================================|
+/**
+ * The whole machine into buffer, which has to hold Xnest_State_Size() bytes.
+ */
+int Xnest_Save(const XNEST_ENV* env, void* buffer, uint32_t size)
+{
+	if (!env || !buffer)
+		return Fail("no environment or no buffer");
+	if (size < Xnest_State_Size())
+		return Fail("the buffer needs " + std::to_string(Xnest_State_Size()) + " bytes");
+
+	STATE_HEADER header = { STATE_MAGIC, XNEST_API_VERSION, (u32)sizeof(MACHINE_STATE), 0 };
+	memcpy(buffer, &header, sizeof(header));
+
+	u8* body = (u8*)buffer + sizeof(header);
+	if (Aligned(body))
+	{
+		env->bus->Save_State(*(MACHINE_STATE*)body);
+		return XNEST_OK;
+	} // end if
+
+	std::unique_ptr<MACHINE_STATE> state(new (std::nothrow) MACHINE_STATE);
+	if (!state)
+		return Fail("out of memory");
+	env->bus->Save_State(*state);
+	memcpy(body, state.get(), sizeof(MACHINE_STATE));
+	return XNEST_OK;
+} // end Xnest_Save
+
+
+//=========================================================================================================|
+/**
+ * The reverse of Xnest_Save. The state has to come from this build, off the same rom.
+ */
+int Xnest_Load(XNEST_ENV* env, const void* buffer, uint32_t size)
+{
+	if (!env || !buffer)
+		return Fail("no environment or no buffer");
+	if (size < Xnest_State_Size())
+		return Fail("a state is " + std::to_string(Xnest_State_Size()) + " bytes");
+
+	STATE_HEADER header;
+	memcpy(&header, buffer, sizeof(header));
+	if (header.magic != STATE_MAGIC || header.version != XNEST_API_VERSION ||
+		header.bytes != sizeof(MACHINE_STATE))
+		return Fail("not a state saved by this build");
+
+	const u8* body = (const u8*)buffer + sizeof(header);
+	if (Aligned(body))
+	{
+		if (!env->bus->Load_State(*(const MACHINE_STATE*)body))
+			return Fail("the state is off another rom");
+		return XNEST_OK;
+	} // end if
+
+	std::unique_ptr<MACHINE_STATE> state(new (std::nothrow) MACHINE_STATE);
+	if (!state)
+		return Fail("out of memory");
+	memcpy(state.get(), body, sizeof(MACHINE_STATE));
+	if (!env->bus->Load_State(*state))
+		return Fail("the state is off another rom");
+	return XNEST_OK;
+} // end Xnest_Load
+
+
+//=========================================================================================================|
+/**
+ * Sound on or off from the next frame on; off by default.
+ */
+void Xnest_Set_Audio(XNEST_ENV* env, int benable)
+{
+	if (env)
+		env->bus->apu.Set_Output(benable != 0);
+} // end Xnest_Set_Audio
+
+
+//=========================================================================================================|
+/**
+ * Up to max_samples of 16-bit mono sound made since the last call; returns how many.
+ */
+int Xnest_Read_Audio(XNEST_ENV* env, int16_t* out, int max_samples)
+{
+	if (!env || !out)
+		return Fail("no environment or no buffer");
+	return env->bus->apu.Read_Samples(out, max_samples);
+} // end Xnest_Read_Audio
+
+
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|
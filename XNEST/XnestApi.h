@@ -0,0 +1,119 @@
+//=========================================================================================================|
+// XnestApi.h
+//	A plain C interface to the emulator, for bot and reinforcement-learning harnesses in other languages
+//	(Python's ctypes, Rust, Lua, C). Of the core, it is all bin/libxnest.so exports (the standard
+//	library's template instances aside). Only C types cross it, it throws nothing, and nothing in it
+//	changes shape without XNEST_API_VERSION going up.
+//
+//	An environment (XNEST_ENV) is one machine with its cartridge. Xnest_Step runs it for some frames,
+//	taking both pads' buttons for each frame from an array. Xnest_Step_Batch steps K environments in one
+//	call, so a harness that steps a whole population every frame pays for one call, not K. Environments
+//	share nothing, so different ones can be stepped on different threads.
+//
+//	Observations are views, not copies. Xnest_Get_Ram is a pointer to the machine's own memory. It stays
+//	valid, at the same address, for the environment's life, and every step updates what it points at, so
+//	a harness can wrap it once (a numpy array, say) and read it after every step. Xnest_Get_Frame is
+//	meant the same way, but this tree has no picture unit yet; it returns null, and XNEST_STEP_RENDER is
+//	accepted and does nothing. Audio is off unless asked for (Xnest_Set_Audio), so a bot that never
+//	listens doesn't pay to make it.
+//
+//	Xnest_Save/Xnest_Load copy the whole machine (Bus::Save_State) to and from a caller's buffer of
+//	Xnest_State_Size() bytes. A state loads into any environment running the same rom; one that isn't
+//	from this build, or whose memory doesn't match the rom's (another cartridge's, or a corrupt one), is
+//	refused before anything is touched.
+//
+//	Failures return XNEST_ERROR (or null), and Xnest_Error says why. The message is per thread.
+//
+// Program Author:
+//	Aethiopis II ben Zahab
+//
+// Date Created:
+//	19th of October 2026, Monday
+//
+// Last Update:
+//	19th of October 2026, Monday
+//
+// Compiled On:
+//	Debian GNU/Linux 12 on x86-64, GNU g++ 12.2 through the Makefile.
+//=========================================================================================================|
+#ifndef XNESTAPI_H
+#define XNESTAPI_H
+
+
+//=========================================================================================================|
+// INCLUDES
+//=========================================================================================================|
+#include <stdint.h>
+
+
+//=========================================================================================================|
+// DEFINES
+//=========================================================================================================|
+#define XNEST_API_VERSION	1
+
+#define XNEST_OK			0
+#define XNEST_ERROR			(-1)		// see Xnest_Error
+
+#define XNEST_STEP_RENDER	0x01		// draw the step's last frame for Xnest_Get_Frame
+
+#define XNEST_PADS			2			// input bytes per frame: pad 1's buttons, then pad 2's
+
+#if defined(_WIN32) && defined(XNEST_API_EXPORTS)
+#define XNEST_API			__declspec(dllexport)
+#elif defined(__GNUC__) || defined(__clang__)
+#define XNEST_API			__attribute__((visibility("default")))
+#else
+#define XNEST_API
+#endif
+
+
+
+//=========================================================================================================|
+// TYPES
+//=========================================================================================================|
+typedef struct XNEST_ENV XNEST_ENV;		// one machine and its cartridge; only ever a pointer
+
+
+
+//=========================================================================================================|
+// FUNCTIONS
+//=========================================================================================================|
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+XNEST_API int Xnest_Version(void);
+XNEST_API const char* Xnest_Error(void);
+
+// rom_path is an iNES file; the machine comes up reset, audio off
+XNEST_API XNEST_ENV* Xnest_Create(const char* rom_path);
+XNEST_API void Xnest_Destroy(XNEST_ENV* env);
+XNEST_API void Xnest_Reset(XNEST_ENV* env);
+
+// input holds XNEST_PADS bytes per frame, or is null for no buttons; both return frames run
+XNEST_API int Xnest_Step(XNEST_ENV* env, uint32_t frames, const uint8_t* input, uint32_t flags);
+XNEST_API int Xnest_Step_Batch(XNEST_ENV* const* envs, uint32_t count, uint32_t frames, const uint8_t* input,
+	uint32_t flags);
+
+// views into the machine; valid till it's destroyed
+XNEST_API const uint8_t* Xnest_Get_Frame(const XNEST_ENV* env, uint32_t* width, uint32_t* height,
+	uint32_t* pitch);
+XNEST_API const uint8_t* Xnest_Get_Ram(const XNEST_ENV* env, uint32_t* size);
+XNEST_API uint64_t Xnest_Frame_Count(const XNEST_ENV* env);
+
+XNEST_API uint32_t Xnest_State_Size(void);
+XNEST_API int Xnest_Save(const XNEST_ENV* env, void* buffer, uint32_t size);
+XNEST_API int Xnest_Load(XNEST_ENV* env, const void* buffer, uint32_t size);
+
+XNEST_API void Xnest_Set_Audio(XNEST_ENV* env, int benable);
+XNEST_API int Xnest_Read_Audio(XNEST_ENV* env, int16_t* out, int max_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
+//=========================================================================================================|
+//			THE END
+//=========================================================================================================|